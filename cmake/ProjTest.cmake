@@ -50,6 +50,23 @@ function(proj_add_gie_test TESTNAME TESTCASE)
 
 endfunction()
 
+# Run several test files in parallel, with timing reports
+function(proj_add_gie_parallel_test TESTNAME)
+
+    set(GIE_BIN $<TARGET_FILE_NAME:gie>)
+    set(TESTFILES)
+    foreach(TESTCASE ${ARGN})
+      list(APPEND TESTFILES ${PROJ_SOURCE_DIR}/test/${TESTCASE})
+    endforeach()
+    add_test(NAME ${TESTNAME}
+      WORKING_DIRECTORY ${PROJ_SOURCE_DIR}/test
+      COMMAND ${CMAKE_RUNTIME_OUTPUT_DIRECTORY}/${GIE_BIN}
+      -j 4 --timing ${TESTFILES}
+    )
+    proj_test_set_properties(${TESTNAME})
+
+endfunction()
+
 # Create user writable directory for tests
 add_custom_target(create_tmp_user_writable_dir ALL
                   COMMAND ${CMAKE_COMMAND} -E remove_directory ${PROJ_BINARY_DIR}/tmp_user_writable_dir
@@ -30,9 +30,95 @@ if(IS_DIRECTORY ${PROJ_DB_CACHE_DIR})
   endif()
 endif()
 
-execute_process(COMMAND "${EXE_SQLITE3}" "${PROJ_DB}"
-                INPUT_FILE "${ALL_SQL_IN}"
-                RESULT_VARIABLE STATUS)
+if(USE_PROJ_DB_CACHE_DIR)
+  # Incremental build: the content of the database after the import of each
+  # SQL file is cached, under a name that depends on the content of this file
+  # and of all the previous ones. The build restarts from the snapshot of the
+  # longest unmodified sequence of SQL files, so that modifications of the
+  # last files (like customizations.sql) do not require to re-import all
+  # the others.
+  set(PROJ_DB_STEPS_DIR "${PROJ_DB_CACHE_DIR}/proj_db_steps")
+  file(MAKE_DIRECTORY "${PROJ_DB_STEPS_DIR}")
+
+  # begin.sql (pragmas such as page_size) and the way steps are wrapped in
+  # this script affect all snapshots, so they seed the chain of checksums.
+  # commit.sql is applied after the last snapshot and does not need to.
+  list(REMOVE_ITEM SQL_FILES "${SQL_DIR}/begin.sql" "${SQL_DIR}/commit.sql")
+  file(MD5 "${SQL_DIR}/begin.sql" BEGIN_SQL_MD5)
+  file(MD5 "${CMAKE_CURRENT_LIST_FILE}" SCRIPT_MD5)
+  set(STEP_MD5 "${PROJ_VERSION}${BEGIN_SQL_MD5}${SCRIPT_MD5}")
+  set(STEP_SNAPSHOTS "")
+  set(FIRST_STEP_TO_RUN 0)
+  set(STEP_IDX 0)
+  foreach(SQL_FILE ${SQL_FILES})
+    file(MD5 "${SQL_FILE}" SQL_FILE_MD5)
+    string(MD5 STEP_MD5 "${STEP_MD5}${SQL_FILE_MD5}")
+    set(STEP_SNAPSHOT "${PROJ_DB_STEPS_DIR}/${STEP_MD5}.db")
+    list(APPEND STEP_SNAPSHOTS "${STEP_SNAPSHOT}")
+    math(EXPR STEP_IDX "${STEP_IDX} + 1")
+    if(EXISTS "${STEP_SNAPSHOT}")
+      set(FIRST_STEP_TO_RUN ${STEP_IDX})
+    endif()
+  endforeach()
+
+  if(FIRST_STEP_TO_RUN GREATER 0)
+    math(EXPR LAST_VALID_STEP "${FIRST_STEP_TO_RUN} - 1")
+    list(GET STEP_SNAPSHOTS ${LAST_VALID_STEP} STEP_SNAPSHOT)
+    list(GET SQL_FILES ${LAST_VALID_STEP} SQL_FILE)
+    get_filename_component(SQL_FILE_NAME "${SQL_FILE}" NAME)
+    message(STATUS "Reusing cached proj.db state after ${SQL_FILE_NAME}")
+    configure_file("${STEP_SNAPSHOT}" "${PROJ_DB}" COPYONLY)
+  endif()
+
+  # Each step is run in its own transaction, so that its result can be
+  # saved.
+  file(READ "${SQL_DIR}/begin.sql" STEP_HEADER)
+  set(STEP_SQL "${PROJ_DB}.step.sql")
+  list(LENGTH SQL_FILES STEP_COUNT)
+  set(STEP_IDX 0)
+  foreach(SQL_FILE ${SQL_FILES} "${SQL_DIR}/commit.sql")
+    if(STEP_IDX GREATER_EQUAL FIRST_STEP_TO_RUN)
+      if(STEP_IDX GREATER 0)
+        set(STEP_HEADER "PRAGMA foreign_keys = 1;\nBEGIN;\n")
+      endif()
+      file(READ "${SQL_FILE}" CONTENTS)
+      string(REPLACE "\${PROJ_VERSION}" "${PROJ_VERSION}" CONTENTS "${CONTENTS}")
+      if(STEP_IDX LESS STEP_COUNT)
+        file(WRITE "${STEP_SQL}" "${STEP_HEADER}${CONTENTS}\nCOMMIT;\n")
+      else()
+        # commit.sql starts with COMMIT
+        file(WRITE "${STEP_SQL}" "${STEP_HEADER}${CONTENTS}")
+      endif()
+      execute_process(COMMAND "${EXE_SQLITE3}" "${PROJ_DB}"
+                      INPUT_FILE "${STEP_SQL}"
+                      RESULT_VARIABLE STATUS)
+      if(STATUS AND NOT STATUS EQUAL 0)
+        file(REMOVE "${STEP_SQL}")
+        message(FATAL_ERROR "Build of proj.db failed in ${SQL_FILE}")
+      endif()
+      if(STEP_IDX LESS STEP_COUNT)
+        list(GET STEP_SNAPSHOTS ${STEP_IDX} STEP_SNAPSHOT)
+        configure_file("${PROJ_DB}" "${STEP_SNAPSHOT}" COPYONLY)
+      endif()
+    endif()
+    math(EXPR STEP_IDX "${STEP_IDX} + 1")
+  endforeach()
+  file(REMOVE "${STEP_SQL}")
+
+  # Remove snapshots that do not belong to the current sequence of SQL files
+  file(GLOB CACHED_SNAPSHOTS "${PROJ_DB_STEPS_DIR}/*.db")
+  foreach(CACHED_SNAPSHOT ${CACHED_SNAPSHOTS})
+    list(FIND STEP_SNAPSHOTS "${CACHED_SNAPSHOT}" SNAPSHOT_IDX)
+    if(SNAPSHOT_IDX EQUAL -1)
+      file(REMOVE "${CACHED_SNAPSHOT}")
+    endif()
+  endforeach()
+  set(STATUS 0)
+else()
+  execute_process(COMMAND "${EXE_SQLITE3}" "${PROJ_DB}"
+                  INPUT_FILE "${ALL_SQL_IN}"
+                  RESULT_VARIABLE STATUS)
+endif()
 
 if(STATUS AND NOT STATUS EQUAL 0)
   message(FATAL_ERROR "Build of proj.db failed")
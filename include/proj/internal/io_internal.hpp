@@ -33,6 +33,8 @@
 #ifndef IO_INTERNAL_HH_INCLUDED
 #define IO_INTERNAL_HH_INCLUDED
 
+#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -181,6 +183,16 @@ struct projCppContext {
     PJ_CONTEXT *ctx_ = nullptr;
     std::string dbPath_{};
     std::vector<std::string> auxDbPaths_{};
+    bool sharedDbCaches_ = false;
+
+    // Cache of the PROJ strings exported by pj_obj_create() for coordinate
+    // operations, keyed by the address of the object.
+    struct CachedPROJString {
+        std::weak_ptr<NS_PROJ::util::BaseObject> obj{};
+        std::string projString{};
+    };
+    std::map<const NS_PROJ::util::BaseObject *, CachedPROJString>
+        cachePROJString_{};
 
     projCppContext(const projCppContext &) = delete;
     projCppContext &operator=(const projCppContext &) = delete;
@@ -196,7 +208,8 @@ struct projCppContext {
     static std::vector<std::string> toVector(const char *const *auxDbPaths);
 
     explicit projCppContext(PJ_CONTEXT *ctx, const char *dbPath = nullptr,
-                            const std::vector<std::string> &auxDbPaths = {});
+                            const std::vector<std::string> &auxDbPaths = {},
+                            bool sharedDbCaches = false);
 
     projCppContext *clone(PJ_CONTEXT *ctx) const;
 
@@ -208,8 +221,20 @@ struct projCppContext {
         return auxDbPaths_;
     }
 
+    // cppcheck-suppress functionStatic
+    inline bool getSharedDbCaches() const { return sharedDbCaches_; }
+
+    // Must be called before the first call to getDatabaseContext()
+    inline void setSharedDbCaches(bool b) { sharedDbCaches_ = b; }
+
     NS_PROJ::io::DatabaseContextNNPtr getDatabaseContext();
 
+    bool getPROJStringFromCache(const NS_PROJ::util::BaseObjectNNPtr &obj,
+                                std::string &projString);
+
+    void cache(const NS_PROJ::util::BaseObjectNNPtr &obj,
+               const std::string &projString);
+
     void closeDb() { databaseContext_ = nullptr; }
 };
 
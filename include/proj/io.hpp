@@ -796,6 +796,8 @@ class PROJ_GCC_DLL WKTParser {
 
     PROJ_DLL WKTParser &setUnsetIdentifiersIfIncompatibleDef(bool unset);
 
+    PROJ_DLL WKTParser &setGrammarValidation(bool validate);
+
     PROJ_DLL util::BaseObjectNNPtr
     createFromWKT(const std::string &wkt); // throw(ParsingException)
 
@@ -899,6 +901,8 @@ class PROJ_GCC_DLL DatabaseContext {
 
     PROJ_DLL static DatabaseContextNNPtr create(void *sqlite_handle);
 
+    PROJ_INTERNAL void useSharedCaches();
+
     PROJ_INTERNAL bool lookForGridAlternative(const std::string &officialName,
                                               std::string &projFilename,
                                               std::string &projFormat,
@@ -40,7 +40,11 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <limits>
+#include <map>
+#include <new>
+#include <thread>
 
 #include "filemanager.hpp"
 #include "geodesic.h"
@@ -217,7 +221,8 @@ double proj_roundtrip(PJ *P, PJ_DIRECTION direction, int n, PJ_COORD *coord) {
 int pj_get_suggested_operation(PJ_CONTEXT *,
                                const std::vector<PJCoordOperation> &opList,
                                const int iExcluded[2], bool skipNonInstantiable,
-                               PJ_DIRECTION direction, PJ_COORD coord)
+                               bool skipOutsideGrids, PJ_DIRECTION direction,
+                               PJ_COORD coord)
 /**************************************************************************************/
 {
     const auto normalizeLongitude = [](double x) {
@@ -336,6 +341,12 @@ int pj_get_suggested_operation(PJ_CONTEXT *,
                 if (skipNonInstantiable && !alt.isInstantiable()) {
                     continue;
                 }
+                // Skip operations whose grids do not cover the point, rather
+                // than failing on them and retrying with another one.
+                if (skipOutsideGrids &&
+                    !alt.mayBeCoveredByGrids(direction, coord)) {
+                    continue;
+                }
                 iBest = i;
                 bestAccuracy = alt.accuracy;
             }
@@ -361,6 +372,134 @@ bool PJCoordOperation::isInstantiable() const {
         isInstantiableCached = proj_coordoperation_is_instantiable(pj->ctx, pj);
     return (isInstantiableCached == 1);
 }
+
+/**************************************************************************************/
+static std::shared_ptr<const NS_PROJ::GridCoverageMask>
+createGridCoverageMask(PJ *pj) {
+    /**************************************************************************************/
+
+    // Only consider pipelines made of steps that keep the coordinates
+    // close to the ones of the source and target geographic CRS.
+    static const char *const knownSteps[] = {
+        "pipeline", "unitconvert", "axisswap",   "cart",        "helmert",
+        "push",     "pop",         "noop",       "molodensky",  "hgridshift",
+        "vgridshift"};
+
+    PJ_CONTEXT *ctx = pj->ctx;
+    const int old_errno = proj_context_errno(ctx);
+    const int old_debug_level = ctx->debug_level;
+    ctx->debug_level = PJ_LOG_NONE;
+    const char *projString = proj_as_proj_string(ctx, pj, PJ_PROJ_5, nullptr);
+
+    auto mask = std::make_shared<NS_PROJ::GridCoverageMask>();
+    bool ok = projString != nullptr && strchr(projString, '"') == nullptr;
+    if (ok) {
+        // Gather the steps, as lists of +key[=value] parameters
+        std::vector<std::vector<std::string>> steps(1);
+        for (const auto &token : split(projString, ' ')) {
+            if (token == "+step")
+                steps.emplace_back();
+            else if (!token.empty())
+                steps.back().push_back(token);
+        }
+
+        for (const auto &step : steps) {
+            std::string stepName;
+            std::string grids;
+            bool unconditional = true;
+            for (const auto &param : step) {
+                if (starts_with(param, "+proj=")) {
+                    stepName = param.substr(strlen("+proj="));
+                } else if (starts_with(param, "+grids=")) {
+                    grids = param.substr(strlen("+grids="));
+                } else if (starts_with(param, "+pm=")) {
+                    ok = false;
+                } else if (param != "+inv" &&
+                           !starts_with(param, "+multiplier=")) {
+                    // e.g. +omit_fwd, +t_epoch, ...: the grid might not be
+                    // applied.
+                    unconditional = false;
+                }
+            }
+            bool knownStep = false;
+            for (const char *knownStepName : knownSteps) {
+                if (stepName == knownStepName)
+                    knownStep = true;
+            }
+            if (!ok || !knownStep) {
+                ok = false;
+                break;
+            }
+            if (!grids.empty() && unconditional &&
+                !mask->addGrids(ctx, grids, stepName == "vgridshift")) {
+                ok = false;
+                break;
+            }
+        }
+    }
+
+    ctx->debug_level = old_debug_level;
+    proj_context_errno_set(ctx, old_errno);
+    if (!ok || mask->empty())
+        return nullptr;
+    return mask;
+}
+
+/**************************************************************************************/
+bool PJCoordOperation::mayBeCoveredByGrids(PJ_DIRECTION direction,
+                                           const PJ_COORD &coord) const {
+    /**************************************************************************************/
+    if (!(srcIsLonLatDegree || srcIsLatLonDegree) ||
+        !(dstIsLonLatDegree || dstIsLatLonDegree)) {
+        return true;
+    }
+    if (!gridCoverageMaskComputed) {
+        gridCoverageMaskComputed = true;
+        gridCoverageMask = createGridCoverageMask(pj);
+    }
+    if (!gridCoverageMask)
+        return true;
+
+    const bool isLonLat =
+        direction == PJ_FWD ? srcIsLonLatDegree : dstIsLonLatDegree;
+    const double lon = isLonLat ? coord.xyzt.x : coord.xyzt.y;
+    const double lat = isLonLat ? coord.xyzt.y : coord.xyzt.x;
+    return gridCoverageMask->mayContain(PJ_TORAD(lon), PJ_TORAD(lat));
+}
+
+/**************************************************************************************/
+PJ *PJCoordOperation::instantiatedPJ() {
+    /**************************************************************************************/
+    if (isPJInstantiated)
+        return pj;
+    isPJInstantiated = true;
+
+    // Reproduce the conditions in which proj_create_crs_to_crs_from_pj()
+    // would have instantiated it
+    PJ_CONTEXT *ctx = pj->ctx;
+    const int old_errno = proj_context_errno(ctx);
+    const int old_debug_level = ctx->debug_level;
+    const bool old_force_over = ctx->forceOver;
+    if (pj->errorIfBestTransformationNotAvailable ||
+        pj->warnIfBestTransformationNotAvailable)
+        ctx->debug_level = PJ_LOG_NONE;
+    ctx->forceOver = pj->over != 0;
+    PJ *newPJ = pj_obj_create(ctx, NN_NO_CHECK(pj->iso_obj));
+    ctx->forceOver = old_force_over;
+    ctx->debug_level = old_debug_level;
+    proj_context_errno_set(ctx, old_errno);
+
+    if (newPJ) {
+        newPJ->over = pj->over;
+        newPJ->errorIfBestTransformationNotAvailable =
+            pj->errorIfBestTransformationNotAvailable;
+        newPJ->warnIfBestTransformationNotAvailable =
+            pj->warnIfBestTransformationNotAvailable;
+        proj_destroy(pj);
+        pj = newPJ;
+    }
+    return pj;
+}
 //! @endcond
 
 /**************************************************************************************/
@@ -412,6 +551,20 @@ PJ_COORD proj_trans(PJ *P, PJ_DIRECTION direction, PJ_COORD coord) {
     if (P->inverted)
         direction = opposite_direction(direction);
 
+    /* Fast path for a plain operation, i.e. without alternative operations */
+    /* or coordinate epoch to deal with */
+    if (P->trans_fwd4d) {
+        P->iCurCoordOp = 0;
+        if (coord_has_nans(coord))
+            coord.v[0] = coord.v[1] = coord.v[2] = coord.v[3] =
+                std::numeric_limits<double>::quiet_NaN();
+        else if (direction == PJ_FWD)
+            P->trans_fwd4d(coord, P);
+        else
+            P->trans_inv4d(coord, P);
+        return coord;
+    }
+
     if (P->iso_obj != nullptr && !P->iso_obj_is_coordinate_operation) {
         pj_log(P->ctx, PJ_LOG_ERROR, "Object is not a coordinate operation");
         proj_errno_set(P, PROJ_ERR_INVALID_OP_ILLEGAL_ARG_VALUE);
@@ -436,9 +589,13 @@ PJ_COORD proj_trans(PJ *P, PJ_DIRECTION direction, PJ_COORD coord) {
         for (int iRetry = 0; iRetry <= N_MAX_RETRY; iRetry++) {
             // Do a first pass and select the operations that match the area of
             // use and has the best accuracy.
+            // With ONLY_BEST=YES, do not silently skip the best operation
+            // when the point is outside of its grids.
             int iBest = pj_get_suggested_operation(
                 P->ctx, P->alternativeCoordinateOperations, iExcluded,
-                skipNonInstantiable, direction, coord);
+                skipNonInstantiable,
+                /* skipOutsideGrids = */
+                !P->errorIfBestTransformationNotAvailable, direction, coord);
             if (iBest < 0) {
                 break;
             }
@@ -453,7 +610,7 @@ PJ_COORD proj_trans(PJ *P, PJ_DIRECTION direction, PJ_COORD coord) {
                        "Attempting a retry with another operation.");
             }
 
-            const auto &alt = P->alternativeCoordinateOperations[iBest];
+            auto &alt = P->alternativeCoordinateOperations[iBest];
             if (P->iCurCoordOp != iBest) {
                 if (proj_log_level(P->ctx, PJ_LOG_TELL) >= PJ_LOG_DEBUG) {
                     std::string msg("Using coordinate operation ");
@@ -462,21 +619,22 @@ PJ_COORD proj_trans(PJ *P, PJ_DIRECTION direction, PJ_COORD coord) {
                 }
                 P->iCurCoordOp = iBest;
             }
+            PJ *altPJ = alt.instantiatedPJ();
             PJ_COORD res = coord;
-            if (alt.pj->hasCoordinateEpoch)
-                coord.xyzt.t = alt.pj->coordinateEpoch;
+            if (altPJ->hasCoordinateEpoch)
+                coord.xyzt.t = altPJ->coordinateEpoch;
             if (direction == PJ_FWD)
-                pj_fwd4d(res, alt.pj);
+                pj_fwd4d(res, altPJ);
             else
-                pj_inv4d(res, alt.pj);
-            if (proj_errno(alt.pj) == PROJ_ERR_OTHER_NETWORK_ERROR) {
+                pj_inv4d(res, altPJ);
+            if (proj_errno(altPJ) == PROJ_ERR_OTHER_NETWORK_ERROR) {
                 return proj_coord_error();
             }
             if (res.xyzt.x != HUGE_VAL) {
                 return res;
             } else if (P->errorIfBestTransformationNotAvailable ||
                        P->warnIfBestTransformationNotAvailable) {
-                warnAboutMissingGrid(alt.pj);
+                warnAboutMissingGrid(altPJ);
                 if (P->errorIfBestTransformationNotAvailable) {
                     proj_errno_set(P, PROJ_ERR_COORD_TRANSFM_NO_OPERATION);
                     return res;
@@ -502,7 +660,7 @@ PJ_COORD proj_trans(PJ *P, PJ_DIRECTION direction, PJ_COORD coord) {
         } catch (const std::exception &) {
         }
         for (int i = 0; i < nOperations; i++) {
-            const auto &alt = P->alternativeCoordinateOperations[i];
+            auto &alt = P->alternativeCoordinateOperations[i];
             auto coordOperation =
                 dynamic_cast<NS_PROJ::operation::CoordinateOperation *>(
                     alt.pj->iso_obj.get());
@@ -520,9 +678,9 @@ PJ_COORD proj_trans(PJ *P, PJ_DIRECTION direction, PJ_COORD coord) {
                         P->iCurCoordOp = i;
                     }
                     if (direction == PJ_FWD) {
-                        pj_fwd4d(coord, alt.pj);
+                        pj_fwd4d(coord, alt.instantiatedPJ());
                     } else {
-                        pj_inv4d(coord, alt.pj);
+                        pj_inv4d(coord, alt.instantiatedPJ());
                     }
                     return coord;
                 }
@@ -560,8 +718,65 @@ object must be freed with proj_destroy().
         return nullptr;
     if (P->alternativeCoordinateOperations.empty())
         return proj_clone(P->ctx, P);
-    return proj_clone(P->ctx,
-                      P->alternativeCoordinateOperations[P->iCurCoordOp].pj);
+    return proj_clone(
+        P->ctx,
+        P->alternativeCoordinateOperations[P->iCurCoordOp].instantiatedPJ());
+}
+
+/* Number of coordinates passed at once to the batch method of an operation */
+static constexpr size_t TRANS_ARRAY_BLOCK_SIZE = 256;
+
+/*****************************************************************************/
+static int trans_array_batch(PJ *P, PJ_ARRAY_OPERATOR op, size_t n,
+                             PJ_COORD *coord) {
+    /******************************************************************************
+        proj_trans_array() for an operation with a batch method, with the same
+        results as the fast path of proj_trans() applied to each coordinate.
+    ******************************************************************************/
+    int retErrno = 0;
+    bool hasSetRetErrno = false;
+    bool sameRetErrno = true;
+
+    P->iCurCoordOp = 0;
+    int errnos[TRANS_ARRAY_BLOCK_SIZE];
+    bool hasNans[TRANS_ARRAY_BLOCK_SIZE];
+    for (size_t start = 0; start < n; start += TRANS_ARRAY_BLOCK_SIZE) {
+        const size_t count = std::min(TRANS_ARRAY_BLOCK_SIZE, n - start);
+        PJ_COORD *block = coord + start;
+
+        // Coordinates with NaN are not transformed, but set to NaN
+        for (size_t i = 0; i < count; i++) {
+            errnos[i] = 0;
+            hasNans[i] = coord_has_nans(block[i]);
+            if (hasNans[i])
+                block[i] = proj_coord_error();
+        }
+
+        proj_context_errno_set(P->ctx, 0);
+        op(block, count, P, errnos);
+
+        for (size_t i = 0; i < count; i++) {
+            if (hasNans[i]) {
+                block[i].v[0] = block[i].v[1] = block[i].v[2] =
+                    block[i].v[3] = std::numeric_limits<double>::quiet_NaN();
+                continue;
+            }
+            const int thisErrno = errnos[i];
+            if (thisErrno != 0) {
+                if (!hasSetRetErrno) {
+                    retErrno = thisErrno;
+                    hasSetRetErrno = true;
+                } else if (sameRetErrno && retErrno != thisErrno) {
+                    sameRetErrno = false;
+                    retErrno = PROJ_ERR_COORD_TRANSFM;
+                }
+            }
+        }
+    }
+
+    proj_context_errno_set(P->ctx, retErrno);
+
+    return retErrno;
 }
 
 /*****************************************************************************/
@@ -585,6 +800,17 @@ int proj_trans_array(PJ *P, PJ_DIRECTION direction, size_t n, PJ_COORD *coord) {
     bool hasSetRetErrno = false;
     bool sameRetErrno = true;
 
+    /* Operations with a batch method process all coordinates at once, when */
+    /* proj_trans() would take its fast path */
+    if (P->trans_fwd4d && direction != PJ_IDENT) {
+        const PJ_DIRECTION dir =
+            P->inverted ? opposite_direction(direction) : direction;
+        const PJ_ARRAY_OPERATOR op =
+            dir == PJ_FWD ? P->trans_fwd4d_array : P->trans_inv4d_array;
+        if (op)
+            return trans_array_batch(P, op, n, coord);
+    }
+
     for (i = 0; i < n; i++) {
         proj_context_errno_set(P->ctx, 0);
         coord[i] = proj_trans(P, direction, coord[i]);
@@ -829,6 +1055,8 @@ static PJ *skip_prep_fin(PJ *P) {
     P->skip_fwd_finalize = 1;
     P->skip_inv_prepare = 1;
     P->skip_inv_finalize = 1;
+    P->trans_fwd4d = pj_fwd4d_function(P);
+    P->trans_inv4d = pj_inv4d_function(P);
     return P;
 }
 
@@ -1356,47 +1584,43 @@ static double antimeridian_max(const double *data, const int arr_len) {
 }
 
 // ---------------------------------------------------------------------------
-// Check if the original projected bounds contains
-// the north pole.
+// Compute the position of the north and south poles in the source CRS
+// (target CRS if direction is inverse).
+// The result is cached in the PJ object, as proj_trans_bounds() is typically
+// called many times with the same transformation.
 // This assumes that the destination CRS is geographic.
-static bool contains_north_pole(PJ *projobj, PJ_DIRECTION pj_direction,
-                                const double xmin, const double ymin,
-                                const double xmax, const double ymax,
-                                bool lon_lat_order) {
-    double pole_y = 90;
-    double pole_x = 0;
-    if (!lon_lat_order) {
-        pole_y = 0;
-        pole_x = 90;
-    }
-    proj_trans_generic(projobj, opposite_direction(pj_direction), &pole_x,
-                       sizeof(double), 1, &pole_y, sizeof(double), 1, nullptr,
-                       sizeof(double), 0, nullptr, sizeof(double), 0);
-    if (xmin < pole_x && pole_x < xmax && ymax > pole_y && pole_y > ymin)
-        return true;
-    return false;
+static void bounds_poles(PJ *projobj, PJ_DIRECTION pj_direction,
+                         bool lon_lat_order, PJ_XY &north_pole,
+                         PJ_XY &south_pole) {
+    const int idx = pj_direction == PJ_FWD ? 0 : 1;
+    if (!projobj->boundsPolesComputed[idx]) {
+        double pole_x[2] = {0, 0};
+        double pole_y[2] = {90, -90};
+        if (!lon_lat_order) {
+            std::swap(pole_x[0], pole_y[0]);
+            std::swap(pole_x[1], pole_y[1]);
+        }
+        proj_trans_generic(projobj, opposite_direction(pj_direction), pole_x,
+                           sizeof(double), 2, pole_y, sizeof(double), 2,
+                           nullptr, sizeof(double), 0, nullptr,
+                           sizeof(double), 0);
+        projobj->boundsNorthPole[idx].x = pole_x[0];
+        projobj->boundsNorthPole[idx].y = pole_y[0];
+        projobj->boundsSouthPole[idx].x = pole_x[1];
+        projobj->boundsSouthPole[idx].y = pole_y[1];
+        projobj->boundsPolesComputed[idx] = true;
+    }
+    north_pole = projobj->boundsNorthPole[idx];
+    south_pole = projobj->boundsSouthPole[idx];
 }
 
 // ---------------------------------------------------------------------------
 // Check if the original projected bounds contains
-// the south pole.
-// This assumes that the destination CRS is geographic.
-static bool contains_south_pole(PJ *projobj, PJ_DIRECTION pj_direction,
-                                const double xmin, const double ymin,
-                                const double xmax, const double ymax,
-                                bool lon_lat_order) {
-    double pole_y = -90;
-    double pole_x = 0;
-    if (!lon_lat_order) {
-        pole_y = 0;
-        pole_x = -90;
-    }
-    proj_trans_generic(projobj, opposite_direction(pj_direction), &pole_x,
-                       sizeof(double), 1, &pole_y, sizeof(double), 1, nullptr,
-                       sizeof(double), 0, nullptr, sizeof(double), 0);
-    if (xmin < pole_x && pole_x < xmax && ymax > pole_y && pole_y > ymin)
-        return true;
-    return false;
+// the pole, as returned by bounds_poles().
+static bool contains_pole(const PJ_XY &pole, const double xmin,
+                          const double ymin, const double xmax,
+                          const double ymax) {
+    return xmin < pole.x && pole.x < xmax && ymax > pole.y && pole.y > ymin;
 }
 
 // ---------------------------------------------------------------------------
@@ -1406,6 +1630,12 @@ static bool contains_south_pole(PJ *projobj, PJ_DIRECTION pj_direction,
 static int target_crs_lon_lat_order(PJ_CONTEXT *transformer_ctx,
                                     PJ *transformer_pj,
                                     PJ_DIRECTION pj_direction) {
+    // Cached, as instantiating the CRS and its coordinate system is much
+    // more costly than transforming the boundary
+    const int idx = pj_direction == PJ_FWD ? 0 : 1;
+    if (transformer_pj->boundsLonLatOrder[idx] >= 0)
+        return transformer_pj->boundsLonLatOrder[idx];
+
     PJ *target_crs = nullptr;
     if (pj_direction == PJ_FWD)
         target_crs = proj_get_target_crs(transformer_ctx, transformer_pj);
@@ -1431,11 +1661,215 @@ static int target_crs_lon_lat_order(PJ_CONTEXT *transformer_ctx,
     proj_destroy(coord_system_pj);
     if (success != 1)
         return -1;
-    return strcmp(abbrev, "lon") == 0 || strcmp(abbrev, "Lon") == 0;
+    transformer_pj->boundsLonLatOrder[idx] =
+        strcmp(abbrev, "lon") == 0 || strcmp(abbrev, "Lon") == 0;
+    return transformer_pj->boundsLonLatOrder[idx];
+}
+
+// ---------------------------------------------------------------------------
+// Transform the points of a boundary through proj_trans_array(), so that
+// operations with a batch method process them all at once. Like with
+// proj_trans_generic(), the z component is 0 and the time is unknown.
+static void trans_bounds_points(PJ *P, PJ_DIRECTION direction, double *x,
+                                double *y, size_t n) {
+    std::vector<PJ_COORD> coords(n);
+    for (size_t i = 0; i < n; i++)
+        coords[i] = proj_coord(x[i], y[i], 0, HUGE_VAL);
+    proj_trans_array(P, direction, n, coords.data());
+    for (size_t i = 0; i < n; i++) {
+        x[i] = coords[i].xy.x;
+        y[i] = coords[i].xy.y;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Number of segments each edge is initially split into, and maximum number
+// of times a segment can be halved, by proj_trans_bounds_adaptive()
+#define BOUNDS_ADAPTIVE_INITIAL_SEGMENTS 4
+#define BOUNDS_ADAPTIVE_MAX_DEPTH 10
+
+namespace {
+struct BoundsNode {
+    int edge;        // index of the edge the node belongs to
+    double t;        // position along that edge, in [0, 1[
+    double x, y;     // transformed coordinates
+    bool converged;  // whether the segment to the next node is fine enough
+};
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Difference between two longitudes, in the [-180, 180] range
+static double bounds_lon_diff(double a, double b) {
+    double d = a - b;
+    if (d > 180)
+        d -= 360;
+    else if (d < -180)
+        d += 360;
+    return d;
+}
+
+// ---------------------------------------------------------------------------
+// Build the transformed boundary as a linear ring, like the fixed
+// densification does, but by halving edge segments only where the
+// transformed middle point is further than tolerance from the middle of the
+// transformed segment, or where the transformation fails on only some of
+// their points.
+// edge_x0/edge_y0 are the start of each edge, and edge_dx/edge_dy its
+// extent. lon_axis is the index of the output longitude axis, or -1 if the
+// output is not geographic.
+static void adaptive_bounds_ring(PJ *P, PJ_DIRECTION direction,
+                                 const double edge_x0[4],
+                                 const double edge_y0[4],
+                                 const double edge_dx[4],
+                                 const double edge_dy[4], int lon_axis,
+                                 double tolerance, std::vector<double> &x,
+                                 std::vector<double> &y) {
+    std::vector<BoundsNode> ring;
+    std::vector<BoundsNode> new_ring;
+    std::vector<double> mid_x;
+    std::vector<double> mid_y;
+
+    for (int edge = 0; edge < 4; edge++) {
+        for (int i = 0; i < BOUNDS_ADAPTIVE_INITIAL_SEGMENTS; i++) {
+            const double t = double(i) / BOUNDS_ADAPTIVE_INITIAL_SEGMENTS;
+            mid_x.push_back(edge_x0[edge] + t * edge_dx[edge]);
+            mid_y.push_back(edge_y0[edge] + t * edge_dy[edge]);
+            ring.push_back(BoundsNode{edge, t, 0, 0, false});
+        }
+    }
+    trans_bounds_points(P, direction, mid_x.data(), mid_y.data(),
+                        mid_x.size());
+    for (size_t i = 0; i < ring.size(); i++) {
+        ring[i].x = mid_x[i];
+        ring[i].y = mid_y[i];
+    }
+
+    for (int depth = 1; depth <= BOUNDS_ADAPTIVE_MAX_DEPTH; depth++) {
+        // Transform the middle of all the segments not converged yet
+        mid_x.clear();
+        mid_y.clear();
+        for (size_t i = 0; i < ring.size(); i++) {
+            const BoundsNode &a = ring[i];
+            if (a.converged)
+                continue;
+            const BoundsNode &b = ring[(i + 1) % ring.size()];
+            const double t = (a.t + (b.edge == a.edge ? b.t : 1.0)) / 2;
+            mid_x.push_back(edge_x0[a.edge] + t * edge_dx[a.edge]);
+            mid_y.push_back(edge_y0[a.edge] + t * edge_dy[a.edge]);
+        }
+        if (mid_x.empty())
+            break;
+        trans_bounds_points(P, direction, mid_x.data(), mid_y.data(),
+                            mid_x.size());
+
+        // Insert them, and check whether the halves need further splitting
+        new_ring.clear();
+        size_t j = 0;
+        for (size_t i = 0; i < ring.size(); i++) {
+            const BoundsNode &a = ring[i];
+            new_ring.push_back(a);
+            if (a.converged)
+                continue;
+            const BoundsNode &b = ring[(i + 1) % ring.size()];
+            BoundsNode m{a.edge, (a.t + (b.edge == a.edge ? b.t : 1.0)) / 2,
+                         mid_x[j], mid_y[j], false};
+            j++;
+
+            const bool a_ok = a.x != HUGE_VAL;
+            const bool b_ok = b.x != HUGE_VAL;
+            const bool m_ok = m.x != HUGE_VAL;
+            bool converged;
+            if (depth == BOUNDS_ADAPTIVE_MAX_DEPTH) {
+                converged = true;
+            } else if (a_ok != m_ok || b_ok != m_ok) {
+                converged = false;
+            } else if (!m_ok) {
+                converged = true;
+            } else {
+                double dx = m.x - (a.x + b.x) / 2;
+                double dy = m.y - (a.y + b.y) / 2;
+                if (lon_axis == 0)
+                    dx = bounds_lon_diff(
+                        m.x, a.x + bounds_lon_diff(b.x, a.x) / 2);
+                else if (lon_axis == 1)
+                    dy = bounds_lon_diff(
+                        m.y, a.y + bounds_lon_diff(b.y, a.y) / 2);
+                converged =
+                    std::fabs(dx) <= tolerance && std::fabs(dy) <= tolerance;
+            }
+            new_ring.back().converged = converged;
+            m.converged = converged;
+            new_ring.push_back(m);
+        }
+        ring.swap(new_ring);
+    }
+
+    x.resize(ring.size());
+    y.resize(ring.size());
+    for (size_t i = 0; i < ring.size(); i++) {
+        x[i] = ring[i].x;
+        y[i] = ring[i].y;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Compute the bounds of a transformed boundary, which must be a linear ring,
+// taking into account the poles and the antimeridian if the output is
+// geographic.
+static void bounds_of_ring(const double *x, const double *y, const int len,
+                           bool degree_output, bool output_lon_lat_order,
+                           bool north_pole_in_bounds,
+                           bool south_pole_in_bounds, double *out_xmin,
+                           double *out_ymin, double *out_xmax,
+                           double *out_ymax) {
+    if (!degree_output) {
+        *out_xmin = simple_min(x, len);
+        *out_xmax = simple_max(x, len);
+        *out_ymin = simple_min(y, len);
+        *out_ymax = simple_max(y, len);
+    } else if (north_pole_in_bounds && output_lon_lat_order) {
+        *out_xmin = -180;
+        *out_ymin = simple_min(y, len);
+        *out_xmax = 180;
+        *out_ymax = 90;
+    } else if (north_pole_in_bounds) {
+        *out_xmin = simple_min(x, len);
+        *out_ymin = -180;
+        *out_xmax = 90;
+        *out_ymax = 180;
+    } else if (south_pole_in_bounds && output_lon_lat_order) {
+        *out_xmin = -180;
+        *out_ymin = -90;
+        *out_xmax = 180;
+        *out_ymax = simple_max(y, len);
+    } else if (south_pole_in_bounds) {
+        *out_xmin = -90;
+        *out_ymin = -180;
+        *out_xmax = simple_max(x, len);
+        *out_ymax = 180;
+    } else if (output_lon_lat_order) {
+        *out_xmin = antimeridian_min(x, len);
+        *out_xmax = antimeridian_max(x, len);
+        *out_ymin = simple_min(y, len);
+        *out_ymax = simple_max(y, len);
+    } else {
+        *out_xmin = simple_min(x, len);
+        *out_xmax = simple_max(x, len);
+        *out_ymin = antimeridian_min(y, len);
+        *out_ymax = antimeridian_max(y, len);
+    }
 }
 
 // ---------------------------------------------------------------------------
 
+static int trans_bounds(PJ_CONTEXT *context, PJ *P, PJ_DIRECTION direction,
+                        const double xmin, const double ymin, const double xmax,
+                        const double ymax, double *out_xmin, double *out_ymin,
+                        double *out_xmax, double *out_ymax,
+                        const int densify_pts, const double tolerance);
+
+// ---------------------------------------------------------------------------
+
 /** \brief Transform boundary,
  *
  * Transform boundary densifying the edges to account for nonlinear
@@ -1482,6 +1916,76 @@ int proj_trans_bounds(PJ_CONTEXT *context, PJ *P, PJ_DIRECTION direction,
                       const double ymax, double *out_xmin, double *out_ymin,
                       double *out_xmax, double *out_ymax,
                       const int densify_pts) {
+    return trans_bounds(context, P, direction, xmin, ymin, xmax, ymax,
+                        out_xmin, out_ymin, out_xmax, out_ymax, densify_pts,
+                        0);
+}
+
+// ---------------------------------------------------------------------------
+
+/** \brief Transform boundary, densifying the edges only where needed.
+ *
+ * Same as proj_trans_bounds(), except that instead of being densified with a
+ * fixed number of points, the edges are split into a few segments that are
+ * recursively halved as long as the transformed middle of a segment is
+ * further than tolerance from the middle of the transformed segment, or the
+ * transformation fails on only some of its points. This is typically much
+ * cheaper for transformations that are nearly linear over the boundary,
+ * while being more accurate where they are strongly curved.
+ *
+ * @param context The PJ_CONTEXT object.
+ * @param P The PJ object representing the transformation.
+ * @param direction The direction of the transformation.
+ * @param xmin Minimum bounding coordinate of the first axis in source CRS
+ *             (target CRS if direction is inverse).
+ * @param ymin Minimum bounding coordinate of the second axis in source CRS.
+ *             (target CRS if direction is inverse).
+ * @param xmax Maximum bounding coordinate of the first axis in source CRS.
+ *             (target CRS if direction is inverse).
+ * @param ymax Maximum bounding coordinate of the second axis in source CRS.
+ *             (target CRS if direction is inverse).
+ * @param out_xmin Minimum bounding coordinate of the first axis in target CRS
+ *             (source CRS if direction is inverse).
+ * @param out_ymin Minimum bounding coordinate of the second axis in target CRS.
+ *             (source CRS if direction is inverse).
+ * @param out_xmax Maximum bounding coordinate of the first axis in target CRS.
+ *             (source CRS if direction is inverse).
+ * @param out_ymax Maximum bounding coordinate of the second axis in target CRS.
+ *             (source CRS if direction is inverse).
+ * @param tolerance Maximum deviation, in the units of the target CRS (source
+ *     CRS if direction is inverse), allowed between the transformed edges and
+ *     their approximation. Must be strictly positive.
+ * @return an integer. 1 if successful. 0 if failures encountered.
+ * @since 9.5
+ */
+int proj_trans_bounds_adaptive(PJ_CONTEXT *context, PJ *P,
+                               PJ_DIRECTION direction, const double xmin,
+                               const double ymin, const double xmax,
+                               const double ymax, double *out_xmin,
+                               double *out_ymin, double *out_xmax,
+                               double *out_ymax, const double tolerance) {
+    if (!(tolerance > 0)) {
+        *out_xmin = HUGE_VAL;
+        *out_ymin = HUGE_VAL;
+        *out_xmax = HUGE_VAL;
+        *out_ymax = HUGE_VAL;
+        proj_log_error(P, _("tolerance must be strictly positive."));
+        proj_errno_set(P, PROJ_ERR_INVALID_OP_ILLEGAL_ARG_VALUE);
+        return false;
+    }
+    return trans_bounds(context, P, direction, xmin, ymin, xmax, ymax,
+                        out_xmin, out_ymin, out_xmax, out_ymax,
+                        BOUNDS_ADAPTIVE_INITIAL_SEGMENTS - 1, tolerance);
+}
+
+// ---------------------------------------------------------------------------
+// Implementation of proj_trans_bounds(), and of proj_trans_bounds_adaptive()
+// if tolerance is not 0.
+static int trans_bounds(PJ_CONTEXT *context, PJ *P, PJ_DIRECTION direction,
+                        const double xmin, const double ymin, const double xmax,
+                        const double ymax, double *out_xmin, double *out_ymin,
+                        double *out_xmax, double *out_ymax,
+                        const int densify_pts, const double tolerance) {
     *out_xmin = HUGE_VAL;
     *out_ymin = HUGE_VAL;
     *out_xmax = HUGE_VAL;
@@ -1523,7 +2027,7 @@ int proj_trans_bounds(PJ_CONTEXT *context, PJ *P, PJ_DIRECTION direction,
     }
 
     int side_pts = densify_pts + 1; // add one because we are densifying
-    const int boundary_len = side_pts * 4;
+    int boundary_len = side_pts * 4;
     std::vector<double> x_boundary_array;
     std::vector<double> y_boundary_array;
     try {
@@ -1535,8 +2039,8 @@ int proj_trans_bounds(PJ_CONTEXT *context, PJ *P, PJ_DIRECTION direction,
         proj_errno_set(P, PROJ_ERR_INVALID_OP_ILLEGAL_ARG_VALUE);
         return false;
     }
-    double delta_x = 0;
-    double delta_y = 0;
+    double span_x = xmax - xmin;
+    double span_y = ymax - ymin;
     bool north_pole_in_bounds = false;
     bool south_pole_in_bounds = false;
     bool input_lon_lat_order = false;
@@ -1553,10 +2057,14 @@ int proj_trans_bounds(PJ_CONTEXT *context, PJ *P, PJ_DIRECTION direction,
         if (out_order_lon_lat == -1)
             return false;
         output_lon_lat_order = out_order_lon_lat != 0;
-        north_pole_in_bounds = contains_north_pole(
-            P, direction, xmin, ymin, xmax, ymax, output_lon_lat_order);
-        south_pole_in_bounds = contains_south_pole(
-            P, direction, xmin, ymin, xmax, ymax, output_lon_lat_order);
+        PJ_XY north_pole;
+        PJ_XY south_pole;
+        bounds_poles(P, direction, output_lon_lat_order, north_pole,
+                     south_pole);
+        north_pole_in_bounds =
+            contains_pole(north_pole, xmin, ymin, xmax, ymax);
+        south_pole_in_bounds =
+            contains_pole(south_pole, xmin, ymin, xmax, ymax);
     }
 
     if (degree_input && xmax < xmin) {
@@ -1566,9 +2074,7 @@ int proj_trans_bounds(PJ_CONTEXT *context, PJ *P, PJ_DIRECTION direction,
             return false;
         }
         // handle antimeridian
-        delta_x = (xmax - xmin + 360.0) / side_pts;
-    } else {
-        delta_x = (xmax - xmin) / side_pts;
+        span_x += 360.0;
     }
     if (degree_input && ymax < ymin) {
         if (input_lon_lat_order) {
@@ -1577,14 +2083,28 @@ int proj_trans_bounds(PJ_CONTEXT *context, PJ *P, PJ_DIRECTION direction,
             return false;
         }
         // handle antimeridian
-        delta_y = (ymax - ymin + 360.0) / side_pts;
-    } else {
-        delta_y = (ymax - ymin) / side_pts;
+        span_y += 360.0;
+    }
+
+    if (tolerance > 0) {
+        // Edges in the same order as the fixed densification below
+        const double edge_x0[4] = {xmin, xmin, xmax, xmax};
+        const double edge_y0[4] = {ymax, ymin, ymin, ymax};
+        const double edge_dx[4] = {0, span_x, 0, -span_x};
+        const double edge_dy[4] = {-span_y, 0, span_y, 0};
+        const int lon_axis =
+            degree_output ? (output_lon_lat_order ? 0 : 1) : -1;
+        adaptive_bounds_ring(P, direction, edge_x0, edge_y0, edge_dx, edge_dy,
+                             lon_axis, tolerance, x_boundary_array,
+                             y_boundary_array);
+        boundary_len = static_cast<int>(x_boundary_array.size());
     }
 
     // build densified bounding box
     // Note: must be a linear ring for antimeridian logic
-    for (int iii = 0; iii < side_pts; iii++) {
+    const double delta_x = span_x / side_pts;
+    const double delta_y = span_y / side_pts;
+    for (int iii = 0; tolerance == 0 && iii < side_pts; iii++) {
         // xmin boundary
         y_boundary_array[iii] = ymax - iii * delta_y;
         x_boundary_array[iii] = xmin;
@@ -1598,46 +2118,14 @@ int proj_trans_bounds(PJ_CONTEXT *context, PJ *P, PJ_DIRECTION direction,
         y_boundary_array[iii + side_pts * 3] = ymax;
         x_boundary_array[iii + side_pts * 3] = xmax - iii * delta_x;
     }
-    proj_trans_generic(P, direction, &x_boundary_array[0], sizeof(double),
-                       boundary_len, &y_boundary_array[0], sizeof(double),
-                       boundary_len, nullptr, 0, 0, nullptr, 0, 0);
-
-    if (!degree_output) {
-        *out_xmin = simple_min(&x_boundary_array[0], boundary_len);
-        *out_xmax = simple_max(&x_boundary_array[0], boundary_len);
-        *out_ymin = simple_min(&y_boundary_array[0], boundary_len);
-        *out_ymax = simple_max(&y_boundary_array[0], boundary_len);
-    } else if (north_pole_in_bounds && output_lon_lat_order) {
-        *out_xmin = -180;
-        *out_ymin = simple_min(&y_boundary_array[0], boundary_len);
-        *out_xmax = 180;
-        *out_ymax = 90;
-    } else if (north_pole_in_bounds) {
-        *out_xmin = simple_min(&x_boundary_array[0], boundary_len);
-        *out_ymin = -180;
-        *out_xmax = 90;
-        *out_ymax = 180;
-    } else if (south_pole_in_bounds && output_lon_lat_order) {
-        *out_xmin = -180;
-        *out_ymin = -90;
-        *out_xmax = 180;
-        *out_ymax = simple_max(&y_boundary_array[0], boundary_len);
-    } else if (south_pole_in_bounds) {
-        *out_xmin = -90;
-        *out_ymin = -180;
-        *out_xmax = simple_max(&x_boundary_array[0], boundary_len);
-        *out_ymax = 180;
-    } else if (output_lon_lat_order) {
-        *out_xmin = antimeridian_min(&x_boundary_array[0], boundary_len);
-        *out_xmax = antimeridian_max(&x_boundary_array[0], boundary_len);
-        *out_ymin = simple_min(&y_boundary_array[0], boundary_len);
-        *out_ymax = simple_max(&y_boundary_array[0], boundary_len);
-    } else {
-        *out_xmin = simple_min(&x_boundary_array[0], boundary_len);
-        *out_xmax = simple_max(&x_boundary_array[0], boundary_len);
-        *out_ymin = antimeridian_min(&y_boundary_array[0], boundary_len);
-        *out_ymax = antimeridian_max(&y_boundary_array[0], boundary_len);
-    }
+    if (tolerance == 0)
+        trans_bounds_points(P, direction, &x_boundary_array[0],
+                            &y_boundary_array[0], boundary_len);
+
+    bounds_of_ring(&x_boundary_array[0], &y_boundary_array[0], boundary_len,
+                   degree_output, output_lon_lat_order, north_pole_in_bounds,
+                   south_pole_in_bounds, out_xmin, out_ymin, out_xmax,
+                   out_ymax);
     return true;
 }
 
@@ -1746,6 +2234,8 @@ static PJ *add_coord_op_to_list(
             idxInOriginalList, minxSrc, minySrc, maxxSrc, maxySrc, minxDst,
             minyDst, maxxDst, maxyDst, op, name, accuracy, pseudoArea, areaName,
             pjSrcGeocentricToLonLat, pjDstGeocentricToLonLat);
+        // op comes from pj_list_get_not_instantiated()
+        altCoordOps.back().isPJInstantiated = false;
         op = nullptr;
     }
     return op;
@@ -2002,9 +2492,12 @@ pj_create_prepared_operations(PJ_CONTEXT *ctx, const PJ *source_crs,
 
         // Iterate over source->target candidate transformations and reproject
         // their long-lat bounding box into the source CRS.
+        // Candidates are only instantiated as PROJ pipelines when first
+        // selected by proj_trans(), since most of them are generally never
+        // used.
         const auto op_count = proj_list_get_count(op_list);
         for (int i = 0; i < op_count; i++) {
-            auto op = proj_list_get(ctx, op_list, i);
+            auto op = pj_list_get_not_instantiated(ctx, op_list, i);
             assert(op);
             double west_lon = 0.0;
             double south_lat = 0.0;
@@ -2026,7 +2519,7 @@ pj_create_prepared_operations(PJ_CONTEXT *ctx, const PJ *source_crs,
                     pjGeogToSrc, pjGeogToDst, pjSrcGeocentricToLonLat,
                     pjDstGeocentricToLonLat, areaName, preparedOpList);
             } else {
-                auto op_clone = proj_clone(ctx, op);
+                auto op_clone = pj_list_get_not_instantiated(ctx, op_list, i);
 
                 op = add_coord_op_to_list(
                     i, op, west_lon, south_lat, 180, north_lat, pjGeogToSrc,
@@ -2365,7 +2858,7 @@ PJ *proj_create_crs_to_crs_from_pj(PJ_CONTEXT *ctx, const PJ *source_crs,
 
     // If there's finally juste a single result, return it directly
     if (preparedOpList.size() == 1) {
-        auto retP = preparedOpList[0].pj;
+        auto retP = preparedOpList[0].instantiatedPJ();
         preparedOpList[0].pj = nullptr;
         proj_destroy(P);
         return retP;
@@ -2382,10 +2875,846 @@ PJ *proj_create_crs_to_crs_from_pj(PJ_CONTEXT *ctx, const PJ *source_crs,
     P->inv3d = nullptr;
     P->fwd4d = nullptr;
     P->inv4d = nullptr;
+    P->trans_fwd4d = nullptr;
+    P->trans_inv4d = nullptr;
 
     return P;
 }
 
+/*****************************************************************************/
+static PJ *clone_crs_to_crs_transformation(PJ_CONTEXT *ctx, const PJ *P) {
+    /*****************************************************************************/
+
+    // proj_clone() does not preserve the settings applied by
+    // proj_create_crs_to_crs_from_pj() on the returned object, and its
+    // alternative operations.
+    PJ *newP = proj_clone(ctx, P);
+    if (!newP) {
+        return nullptr;
+    }
+    const auto copySettings = [](PJ *dst, const PJ *src) {
+        dst->over = src->over;
+        dst->errorIfBestTransformationNotAvailable =
+            src->errorIfBestTransformationNotAvailable;
+        dst->warnIfBestTransformationNotAvailable =
+            src->warnIfBestTransformationNotAvailable;
+        dst->skipNonInstantiable = src->skipNonInstantiable;
+    };
+    copySettings(newP, P);
+    if (newP->alternativeCoordinateOperations.size() ==
+        P->alternativeCoordinateOperations.size()) {
+        for (size_t i = 0; i < P->alternativeCoordinateOperations.size(); ++i) {
+            copySettings(newP->alternativeCoordinateOperations[i].pj,
+                         P->alternativeCoordinateOperations[i].pj);
+        }
+    }
+    return newP;
+}
+/*****************************************************************************/
+static int get_thread_count(const char *value) {
+    /******************************************************************************
+        Parse the value of a THREADS=number/ALL_CPUS option.
+    ******************************************************************************/
+    int nThreads;
+    if (ci_equal(value, "ALL_CPUS")) {
+        nThreads = static_cast<int>(std::thread::hardware_concurrency());
+    } else {
+        nThreads = atoi(value);
+    }
+    return nThreads > 0 ? nThreads : 1;
+}
+
+/*****************************************************************************/
+int proj_create_crs_to_crs_from_pj_array(PJ_CONTEXT *ctx, int count,
+                                         const PJ *const *source_crs,
+                                         const PJ *const *target_crs,
+                                         PJ_AREA *area,
+                                         const char *const *options,
+                                         PJ **out_transformations) {
+    /******************************************************************************
+        Create transformation pipelines for a list of (source, target)
+        pairs of coordinate reference systems.
+
+        See docs/source/development/reference/functions.rst
+
+    ******************************************************************************/
+    if (!ctx) {
+        ctx = pj_get_default_ctx();
+    }
+    if (count < 0 || (count > 0 && (!source_crs || !target_crs ||
+                                    !out_transformations))) {
+        proj_context_errno_set(ctx, PROJ_ERR_OTHER_API_MISUSE);
+        pj_log(ctx, PJ_LOG_ERROR, "%s: missing required input", __FUNCTION__);
+        return 0;
+    }
+    for (int i = 0; i < count; i++) {
+        out_transformations[i] = nullptr;
+    }
+
+    // Options are forwarded to proj_create_crs_to_crs_from_pj(), except
+    // the ones specific to this function.
+    int nThreads = 1;
+    bool sharedDbCaches = ctx->get_cpp_context()->getSharedDbCaches();
+    std::vector<const char *> forwardedOptions;
+    for (auto iter = options; iter && iter[0]; ++iter) {
+        const char *value;
+        if ((value = getOptionValue(*iter, "THREADS="))) {
+            nThreads = get_thread_count(value);
+        } else if ((value = getOptionValue(*iter, "SHARED_CACHE="))) {
+            sharedDbCaches = ci_equal(value, "YES");
+        } else {
+            forwardedOptions.push_back(*iter);
+        }
+    }
+    forwardedOptions.push_back(nullptr);
+
+    // Identify pairs that are identical to a previous one, so that the
+    // operation search is done only once for them.
+    const auto getKey = [](const PJ *obj) {
+        std::string key;
+        const char *auth = proj_get_id_auth_name(obj, 0);
+        const char *code = proj_get_id_code(obj, 0);
+        if (auth && code) {
+            key = auth;
+            key += ':';
+            key += code;
+        }
+        key += '|';
+        key += toString(static_cast<int>(proj_get_type(obj)));
+        return key;
+    };
+    std::vector<int> idxOfFirstIdentical(count);
+    std::map<std::string, std::vector<int>> mapKeyToIdx;
+    std::vector<int> distinctIdx;
+    for (int i = 0; i < count; i++) {
+        idxOfFirstIdentical[i] = i;
+        if (!source_crs[i] || !target_crs[i]) {
+            continue;
+        }
+        const std::string key =
+            getKey(source_crs[i]) + '/' + getKey(target_crs[i]);
+        auto &candidates = mapKeyToIdx[key];
+        for (int j : candidates) {
+            if ((source_crs[j] == source_crs[i] ||
+                 proj_is_equivalent_to_with_ctx(ctx, source_crs[j],
+                                                source_crs[i],
+                                                PJ_COMP_STRICT)) &&
+                (target_crs[j] == target_crs[i] ||
+                 proj_is_equivalent_to_with_ctx(ctx, target_crs[j],
+                                                target_crs[i],
+                                                PJ_COMP_STRICT))) {
+                idxOfFirstIdentical[i] = j;
+                break;
+            }
+        }
+        if (idxOfFirstIdentical[i] == i) {
+            candidates.push_back(i);
+            distinctIdx.push_back(i);
+        }
+    }
+
+    const int nDistinct = static_cast<int>(distinctIdx.size());
+    nThreads = std::min(nThreads, nDistinct);
+    if (nThreads <= 1) {
+        for (int i : distinctIdx) {
+            out_transformations[i] = proj_create_crs_to_crs_from_pj(
+                ctx, source_crs[i], target_crs[i], area,
+                forwardedOptions.data());
+        }
+    } else {
+        // Each worker thread uses its own context, and its own copies of the
+        // source and target CRS, created in this thread, so that no PJ
+        // object is used by several threads. Pair distinctIdx[k] is
+        // processed by worker k % nThreads.
+        std::vector<PJ_CONTEXT *> workerContexts;
+        for (int iThread = 0; iThread < nThreads; iThread++) {
+            auto workerCtx = proj_context_clone(ctx);
+            if (sharedDbCaches) {
+                workerCtx->get_cpp_context()->setSharedDbCaches(true);
+            }
+            workerContexts.push_back(workerCtx);
+        }
+        std::vector<PJ *> workerSourceCRS(nDistinct);
+        std::vector<PJ *> workerTargetCRS(nDistinct);
+        for (int k = 0; k < nDistinct; k++) {
+            const int i = distinctIdx[k];
+            auto workerCtx = workerContexts[k % nThreads];
+            workerSourceCRS[k] = proj_clone(workerCtx, source_crs[i]);
+            workerTargetCRS[k] = proj_clone(workerCtx, target_crs[i]);
+        }
+
+        // Error of each failed pair, so that the one of the last failed
+        // pair can be reported in ctx, like when processing them serially.
+        std::vector<int> pairErrno(nDistinct);
+        std::vector<std::string> pairErrorMessage(nDistinct);
+
+        std::vector<std::thread> threads;
+        for (int iThread = 0; iThread < nThreads; iThread++) {
+            auto workerCtx = workerContexts[iThread];
+            threads.emplace_back([workerCtx, iThread, nThreads, &distinctIdx,
+                                  nDistinct, &workerSourceCRS,
+                                  &workerTargetCRS, area, &forwardedOptions,
+                                  &pairErrno, &pairErrorMessage,
+                                  out_transformations]() {
+                for (int k = iThread; k < nDistinct; k += nThreads) {
+                    const int i = distinctIdx[k];
+                    proj_context_errno_set(workerCtx, 0);
+                    out_transformations[i] = proj_create_crs_to_crs_from_pj(
+                        workerCtx, workerSourceCRS[k], workerTargetCRS[k],
+                        area, forwardedOptions.data());
+                    if (!out_transformations[i]) {
+                        pairErrno[k] = proj_context_errno(workerCtx);
+                        pairErrorMessage[k] = workerCtx->lastFullErrorMessage;
+                    }
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        for (int k = 0; k < nDistinct; k++) {
+            proj_assign_context(out_transformations[distinctIdx[k]], ctx);
+            proj_destroy(workerSourceCRS[k]);
+            proj_destroy(workerTargetCRS[k]);
+            if (pairErrno[k]) {
+                proj_context_errno_set(ctx, pairErrno[k]);
+                ctx->lastFullErrorMessage = pairErrorMessage[k];
+            }
+        }
+        for (auto workerCtx : workerContexts) {
+            proj_context_destroy(workerCtx);
+        }
+    }
+
+    int nSuccess = 0;
+    for (int i = 0; i < count; i++) {
+        const int j = idxOfFirstIdentical[i];
+        if (j != i && out_transformations[j]) {
+            out_transformations[i] =
+                clone_crs_to_crs_transformation(ctx, out_transformations[j]);
+        }
+        if (out_transformations[i]) {
+            nSuccess++;
+        }
+    }
+    return nSuccess;
+}
+
+// ---------------------------------------------------------------------------
+// Call processBand(P, band) for each band in [0, nBands[, distributing the
+// bands between nThreads threads. Each worker thread uses its own copy of
+// the transformation, in its own clone of context, which keeps its database
+// cache settings. Everything is processed in the current thread if nThreads
+// is 1 or the transformation cannot be copied.
+template <class ProcessBand>
+static void process_bands(PJ_CONTEXT *context, PJ *P, int nThreads,
+                          int nBands, ProcessBand processBand) {
+    nThreads = std::min(nThreads, nBands);
+    std::vector<PJ_CONTEXT *> workerContexts;
+    std::vector<PJ *> workerPJs;
+    if (nThreads > 1) {
+        for (int iThread = 0; iThread < nThreads; iThread++) {
+            auto workerCtx = proj_context_clone(context);
+            if (!workerCtx)
+                break;
+            workerContexts.push_back(workerCtx);
+            auto workerP = clone_crs_to_crs_transformation(workerCtx, P);
+            if (!workerP)
+                break;
+            workerPJs.push_back(workerP);
+        }
+        if (static_cast<int>(workerPJs.size()) != nThreads) {
+            // Fallback to processing everything in this thread
+            nThreads = 1;
+        }
+    }
+
+    if (nThreads <= 1) {
+        for (int band = 0; band < nBands; band++) {
+            processBand(P, band);
+        }
+    } else {
+        std::atomic<int> nextBand(0);
+        std::vector<std::thread> threads;
+        for (int iThread = 0; iThread < nThreads; iThread++) {
+            auto workerP = workerPJs[iThread];
+            threads.emplace_back([workerP, &nextBand, nBands, &processBand]() {
+                while (true) {
+                    const int band = nextBand++;
+                    if (band >= nBands) {
+                        break;
+                    }
+                    processBand(workerP, band);
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    }
+    for (auto workerP : workerPJs) {
+        proj_destroy(workerP);
+    }
+    for (auto workerCtx : workerContexts) {
+        proj_context_destroy(workerCtx);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Maximum number of points transformed at once by proj_trans_bounds_grid().
+// Rows of cells are processed by bands of approximately that size, to bound
+// memory use, and to distribute the work between threads.
+#define BOUNDS_GRID_BAND_POINTS 65536
+
+namespace {
+// Grid of boxes, and transformation information common to all the boxes,
+// processed by proj_trans_bounds_grid()
+struct BoundsGrid {
+    PJ_DIRECTION direction;
+    double xmin;
+    double ymin;
+    double cell_width;
+    double cell_height;
+    int count_x;
+    int count_y;
+    int side_pts;
+    bool degree_output;
+    bool output_lon_lat_order;
+    PJ_XY north_pole;
+    PJ_XY south_pole;
+    double *out_xmin;
+    double *out_ymin;
+    double *out_xmax;
+    double *out_ymax;
+};
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Compute the bounds of the boxes of rows [row_start, row_end[ of the grid.
+// The edges shared between boxes of the band are only transformed once.
+static void trans_bounds_grid_band(PJ *P, const BoundsGrid &grid,
+                                   int row_start, int row_end) {
+    const int side_pts = grid.side_pts;
+    const int count_x = grid.count_x;
+    const int n_rows = row_end - row_start;
+    const double step_x = grid.cell_width / side_pts;
+    const double step_y = grid.cell_height / side_pts;
+
+    // Points along the n_rows + 1 horizontal lines, including the corners of
+    // the boxes, followed by the points along the count_x + 1 vertical lines
+    // of each row, excluding the corners.
+    const size_t h_line_len = static_cast<size_t>(count_x) * side_pts + 1;
+    const size_t v_seg_len = side_pts - 1;
+    const size_t v_start = (n_rows + 1) * h_line_len;
+    std::vector<PJ_COORD> coords(v_start +
+                                 n_rows * (count_x + 1) * v_seg_len);
+    for (int l = 0; l <= n_rows; l++) {
+        const double y = grid.ymin + (row_start + l) * grid.cell_height;
+        PJ_COORD *line = &coords[l * h_line_len];
+        for (size_t k = 0; k < h_line_len; k++)
+            line[k] = proj_coord(grid.xmin + k * step_x, y, 0, HUGE_VAL);
+    }
+    for (int r = 0; r < n_rows; r++) {
+        const double y0 = grid.ymin + (row_start + r) * grid.cell_height;
+        for (int i = 0; i <= count_x; i++) {
+            const double x = grid.xmin + i * grid.cell_width;
+            PJ_COORD *seg =
+                &coords[v_start + (r * (count_x + 1) + i) * v_seg_len];
+            for (size_t m = 0; m < v_seg_len; m++)
+                seg[m] = proj_coord(x, y0 + (m + 1) * step_y, 0, HUGE_VAL);
+        }
+    }
+    proj_trans_array(P, grid.direction, coords.size(), coords.data());
+
+    // Build the linear ring of each box, in the same order as
+    // proj_trans_bounds(), from the transformed points
+    const int ring_len = side_pts * 4;
+    std::vector<double> ring_x(ring_len);
+    std::vector<double> ring_y(ring_len);
+    for (int r = 0; r < n_rows; r++) {
+        const PJ_COORD *bottom = &coords[r * h_line_len];
+        const PJ_COORD *top = &coords[(r + 1) * h_line_len];
+        const PJ_COORD *vert = &coords[v_start + r * (count_x + 1) * v_seg_len];
+        const int row = row_start + r;
+        const double cell_ymin = grid.ymin + row * grid.cell_height;
+        const double cell_ymax = cell_ymin + grid.cell_height;
+        for (int i = 0; i < count_x; i++) {
+            const PJ_COORD *left = &vert[i * v_seg_len];
+            const PJ_COORD *right = &vert[(i + 1) * v_seg_len];
+            const int c0 = i * side_pts;
+            const int c1 = c0 + side_pts;
+            for (int k = 0; k < side_pts; k++) {
+                // xmin boundary
+                const PJ_COORD &l = k == 0 ? top[c0] : left[side_pts - 1 - k];
+                ring_x[k] = l.xy.x;
+                ring_y[k] = l.xy.y;
+                // ymin boundary
+                ring_x[k + side_pts] = bottom[c0 + k].xy.x;
+                ring_y[k + side_pts] = bottom[c0 + k].xy.y;
+                // xmax boundary
+                const PJ_COORD &rt = k == 0 ? bottom[c1] : right[k - 1];
+                ring_x[k + side_pts * 2] = rt.xy.x;
+                ring_y[k + side_pts * 2] = rt.xy.y;
+                // ymax boundary
+                ring_x[k + side_pts * 3] = top[c1 - k].xy.x;
+                ring_y[k + side_pts * 3] = top[c1 - k].xy.y;
+            }
+
+            bool north_pole_in_bounds = false;
+            bool south_pole_in_bounds = false;
+            if (grid.degree_output) {
+                const double cell_xmin = grid.xmin + i * grid.cell_width;
+                const double cell_xmax = cell_xmin + grid.cell_width;
+                north_pole_in_bounds =
+                    contains_pole(grid.north_pole, cell_xmin, cell_ymin,
+                                  cell_xmax, cell_ymax);
+                south_pole_in_bounds =
+                    contains_pole(grid.south_pole, cell_xmin, cell_ymin,
+                                  cell_xmax, cell_ymax);
+            }
+            const size_t idx = static_cast<size_t>(row) * count_x + i;
+            bounds_of_ring(ring_x.data(), ring_y.data(), ring_len,
+                           grid.degree_output, grid.output_lon_lat_order,
+                           north_pole_in_bounds, south_pole_in_bounds,
+                           &grid.out_xmin[idx], &grid.out_ymin[idx],
+                           &grid.out_xmax[idx], &grid.out_ymax[idx]);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+/** \brief Transform the boundaries of a regular grid of boxes.
+ *
+ * This computes the same bounds as calling proj_trans_bounds() on each box
+ * of the grid, but the points along the edges shared by adjacent boxes are
+ * only transformed once, and the boxes can be processed by several threads.
+ * This is typically used to compute the bounds of all the tiles of a zoom
+ * level of a tile pyramid.
+ *
+ * The box at column i (0 <= i < count_x) and row j (0 <= j < count_y) spans
+ * [xmin + i * cell_width, xmin + (i + 1) * cell_width] along the first axis
+ * and [ymin + j * cell_height, ymin + (j + 1) * cell_height] along the second
+ * axis. Its bounds are stored at index j * count_x + i of the output arrays.
+ *
+ * Unlike with proj_trans_bounds(), boxes crossing the antimeridian in the
+ * source CRS are not supported: cell_width and cell_height must be strictly
+ * positive, and the boxes are not wrapped.
+ *
+ * @param context The PJ_CONTEXT object.
+ * @param P The PJ object representing the transformation.
+ * @param direction The direction of the transformation.
+ * @param xmin Minimum coordinate of the first axis of the grid in source CRS
+ *             (target CRS if direction is inverse).
+ * @param ymin Minimum coordinate of the second axis of the grid in source CRS
+ *             (target CRS if direction is inverse).
+ * @param cell_width Size of a box along the first axis.
+ * @param cell_height Size of a box along the second axis.
+ * @param count_x Number of boxes along the first axis.
+ * @param count_y Number of boxes along the second axis.
+ * @param out_xmin Array of count_x * count_y values receiving the minimum
+ *             bounding coordinate of the first axis of each box in target CRS
+ *             (source CRS if direction is inverse).
+ * @param out_ymin Array of count_x * count_y values receiving the minimum
+ *             bounding coordinate of the second axis of each box.
+ * @param out_xmax Array of count_x * count_y values receiving the maximum
+ *             bounding coordinate of the first axis of each box.
+ * @param out_ymax Array of count_x * count_y values receiving the maximum
+ *             bounding coordinate of the second axis of each box.
+ * @param densify_pts Recommended to use 21. This is the number of points
+ *     to use to densify each edge of the boxes in the transformation.
+ * @param options a list of NUL terminated options, or NULL.
+ * The list itself is NULL terminated.
+ * Supported options are:
+ * <ul>
+ * <li>THREADS=number/ALL_CPUS: number of threads used to process the boxes.
+ * Defaults to 1.</li>
+ * </ul>
+ * @return an integer. 1 if successful. 0 if failures encountered.
+ * @since 9.5
+ */
+int proj_trans_bounds_grid(PJ_CONTEXT *context, PJ *P, PJ_DIRECTION direction,
+                           const double xmin, const double ymin,
+                           const double cell_width, const double cell_height,
+                           const int count_x, const int count_y,
+                           double *out_xmin, double *out_ymin,
+                           double *out_xmax, double *out_ymax,
+                           const int densify_pts, const char *const *options) {
+    if (P == nullptr) {
+        proj_log_error(P, _("NULL P object not allowed."));
+        proj_errno_set(P, PROJ_ERR_INVALID_OP_ILLEGAL_ARG_VALUE);
+        return false;
+    }
+    if (!context) {
+        context = P->ctx;
+    }
+    if (count_x <= 0 || count_y <= 0 || !out_xmin || !out_ymin ||
+        !out_xmax || !out_ymax) {
+        proj_log_error(P, _("missing required input"));
+        proj_errno_set(P, PROJ_ERR_OTHER_API_MISUSE);
+        return false;
+    }
+    const size_t count = static_cast<size_t>(count_x) * count_y;
+    for (size_t i = 0; i < count; i++) {
+        out_xmin[i] = HUGE_VAL;
+        out_ymin[i] = HUGE_VAL;
+        out_xmax[i] = HUGE_VAL;
+        out_ymax[i] = HUGE_VAL;
+    }
+    if (!(cell_width > 0) || !(cell_height > 0)) {
+        proj_log_error(P, _("cell_width and cell_height must be strictly "
+                            "positive."));
+        proj_errno_set(P, PROJ_ERR_INVALID_OP_ILLEGAL_ARG_VALUE);
+        return false;
+    }
+    if (densify_pts < 0 || densify_pts > 10000) {
+        proj_log_error(P, _("densify_pts must be between 0-10000."));
+        proj_errno_set(P, PROJ_ERR_INVALID_OP_ILLEGAL_ARG_VALUE);
+        return false;
+    }
+
+    int nThreads = 1;
+    for (auto iter = options; iter && iter[0]; ++iter) {
+        const char *value;
+        if ((value = getOptionValue(*iter, "THREADS="))) {
+            nThreads = get_thread_count(value);
+        } else {
+            std::string msg("Unknown option :");
+            msg += *iter;
+            proj_log_error(P, msg.c_str());
+            proj_errno_set(P, PROJ_ERR_INVALID_OP_ILLEGAL_ARG_VALUE);
+            return false;
+        }
+    }
+
+    PJ_PROJ_INFO pj_info = proj_pj_info(P);
+    if (pj_info.id == nullptr) {
+        proj_log_error(P, _("NULL transformation not allowed,"));
+        proj_errno_set(P, PROJ_ERR_INVALID_OP_ILLEGAL_ARG_VALUE);
+        return false;
+    }
+    if (strcmp(pj_info.id, "noop") == 0 || direction == PJ_IDENT) {
+        for (int j = 0; j < count_y; j++) {
+            for (int i = 0; i < count_x; i++) {
+                const size_t idx = static_cast<size_t>(j) * count_x + i;
+                out_xmin[idx] = xmin + i * cell_width;
+                out_ymin[idx] = ymin + j * cell_height;
+                out_xmax[idx] = out_xmin[idx] + cell_width;
+                out_ymax[idx] = out_ymin[idx] + cell_height;
+            }
+        }
+        return true;
+    }
+
+    BoundsGrid grid;
+    grid.direction = direction;
+    grid.xmin = xmin;
+    grid.ymin = ymin;
+    grid.cell_width = cell_width;
+    grid.cell_height = cell_height;
+    grid.count_x = count_x;
+    grid.count_y = count_y;
+    grid.side_pts = densify_pts + 1;
+    grid.degree_output = proj_degree_output(P, direction) != 0;
+    grid.output_lon_lat_order = false;
+    grid.north_pole = PJ_XY{HUGE_VAL, HUGE_VAL};
+    grid.south_pole = PJ_XY{HUGE_VAL, HUGE_VAL};
+    grid.out_xmin = out_xmin;
+    grid.out_ymin = out_ymin;
+    grid.out_xmax = out_xmax;
+    grid.out_ymax = out_ymax;
+    if (grid.degree_output) {
+        if (densify_pts < 2) {
+            proj_log_error(P, _("densify_pts must be at least 2 if the "
+                                "output is geographic."));
+            proj_errno_set(P, PROJ_ERR_INVALID_OP_ILLEGAL_ARG_VALUE);
+            return false;
+        }
+        int out_order_lon_lat = target_crs_lon_lat_order(context, P, direction);
+        if (out_order_lon_lat == -1)
+            return false;
+        grid.output_lon_lat_order = out_order_lon_lat != 0;
+        bounds_poles(P, direction, grid.output_lon_lat_order, grid.north_pole,
+                     grid.south_pole);
+    }
+
+    const size_t points_per_row =
+        static_cast<size_t>(count_x) * grid.side_pts * 2;
+    const int rows_per_band = static_cast<int>(std::max<size_t>(
+        1, std::min<size_t>(count_y,
+                            BOUNDS_GRID_BAND_POINTS / points_per_row)));
+    const int nBands = (count_y + rows_per_band - 1) / rows_per_band;
+    process_bands(context, P, nThreads, nBands,
+                  [&grid, rows_per_band, count_y](PJ *bandP, int band) {
+                      const int row = band * rows_per_band;
+                      trans_bounds_grid_band(
+                          bandP, grid, row,
+                          std::min(row + rows_per_band, count_y));
+                  });
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Maximum number of pixels processed at once by proj_trans_warp_grid().
+// Rows are processed by bands of approximately that size.
+#define WARP_GRID_BAND_PIXELS 65536
+
+// Maximum length, in pixels, of the segments rows are initially split into
+// by proj_trans_warp_grid(), before being recursively halved.
+#define WARP_GRID_MAX_SEGMENT 64
+
+namespace {
+// Raster whose source coordinates are computed by proj_trans_warp_grid()
+struct WarpGrid {
+    PJ_DIRECTION direction;
+    const double *geotransform;
+    int width;
+    double error_threshold;
+    double *out_x;
+    double *out_y;
+};
+
+// Pixels ]c0, c1[ of a row not computed yet
+struct WarpSegment {
+    int row;
+    int c0;
+    int c1;
+};
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Coordinates of the center of a pixel of the raster
+static PJ_COORD warp_grid_pixel(const WarpGrid &grid, int row, int col) {
+    const double *gt = grid.geotransform;
+    const double c = col + 0.5;
+    const double r = row + 0.5;
+    return proj_coord(gt[0] + c * gt[1] + r * gt[2],
+                      gt[3] + c * gt[4] + r * gt[5], 0, HUGE_VAL);
+}
+
+// ---------------------------------------------------------------------------
+// Transform coords, and store the result at the indices coords_idx of the
+// output arrays.
+static void trans_warp_grid_points(PJ *P, const WarpGrid &grid,
+                                   std::vector<PJ_COORD> &coords,
+                                   const std::vector<size_t> &coords_idx) {
+    proj_trans_array(P, grid.direction, coords.size(), coords.data());
+    for (size_t i = 0; i < coords.size(); i++) {
+        grid.out_x[coords_idx[i]] = coords[i].xy.x;
+        grid.out_y[coords_idx[i]] = coords[i].xy.y;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Compute the source coordinates of rows [row_start, row_end[ of the raster.
+// Rows are split into segments, whose middle is transformed. If it is close
+// enough to the linear interpolation of the ends of the segment, the other
+// pixels of the segment are interpolated. Otherwise, the segment is halved.
+// Each level of subdivision of all the rows of the band is transformed in a
+// single proj_trans_array() call.
+static void trans_warp_grid_band(PJ *P, const WarpGrid &grid, int row_start,
+                                 int row_end) {
+    const int width = grid.width;
+    double *out_x = grid.out_x;
+    double *out_y = grid.out_y;
+    std::vector<PJ_COORD> coords;
+    std::vector<size_t> coords_idx;
+    std::vector<WarpSegment> segments;
+    std::vector<WarpSegment> new_segments;
+
+    if (grid.error_threshold == 0) {
+        // No interpolation: transform every pixel, row by row
+        for (int row = row_start; row < row_end; row++) {
+            coords.clear();
+            coords_idx.clear();
+            for (int col = 0; col < width; col++) {
+                coords.push_back(warp_grid_pixel(grid, row, col));
+                coords_idx.push_back(static_cast<size_t>(row) * width + col);
+            }
+            trans_warp_grid_points(P, grid, coords, coords_idx);
+        }
+        return;
+    }
+
+    // Transform the ends of the initial segments of each row
+    for (int row = row_start; row < row_end; row++) {
+        for (int c0 = 0;; c0 += WARP_GRID_MAX_SEGMENT) {
+            const int c1 = std::min(c0 + WARP_GRID_MAX_SEGMENT, width - 1);
+            coords.push_back(warp_grid_pixel(grid, row, c0));
+            coords_idx.push_back(static_cast<size_t>(row) * width + c0);
+            if (c1 - c0 >= 2)
+                segments.push_back(WarpSegment{row, c0, c1});
+            if (c1 == width - 1) {
+                if (c1 != c0) {
+                    coords.push_back(warp_grid_pixel(grid, row, c1));
+                    coords_idx.push_back(static_cast<size_t>(row) * width +
+                                         c1);
+                }
+                break;
+            }
+        }
+    }
+    trans_warp_grid_points(P, grid, coords, coords_idx);
+
+    while (!segments.empty()) {
+        // Transform the middle of the segments
+        coords.clear();
+        coords_idx.clear();
+        for (const auto &seg : segments) {
+            const int cm = (seg.c0 + seg.c1) / 2;
+            coords.push_back(warp_grid_pixel(grid, seg.row, cm));
+            coords_idx.push_back(static_cast<size_t>(seg.row) * width + cm);
+        }
+        trans_warp_grid_points(P, grid, coords, coords_idx);
+
+        new_segments.clear();
+        for (const auto &seg : segments) {
+            const size_t row_idx = static_cast<size_t>(seg.row) * width;
+            const size_t i0 = row_idx + seg.c0;
+            const size_t i1 = row_idx + seg.c1;
+            const int cm = (seg.c0 + seg.c1) / 2;
+            const size_t im = row_idx + cm;
+            const double len = seg.c1 - seg.c0;
+
+            bool interpolate = false;
+            if (out_x[i0] != HUGE_VAL && out_x[i1] != HUGE_VAL &&
+                out_x[im] != HUGE_VAL) {
+                const double f = (cm - seg.c0) / len;
+                const double dx =
+                    out_x[i0] + f * (out_x[i1] - out_x[i0]) - out_x[im];
+                const double dy =
+                    out_y[i0] + f * (out_y[i1] - out_y[i0]) - out_y[im];
+                interpolate = std::fabs(dx) <= grid.error_threshold &&
+                              std::fabs(dy) <= grid.error_threshold;
+            }
+
+            if (interpolate) {
+                for (int c = seg.c0 + 1; c < seg.c1; c++) {
+                    if (c == cm)
+                        continue;
+                    const double f = (c - seg.c0) / len;
+                    out_x[row_idx + c] =
+                        out_x[i0] + f * (out_x[i1] - out_x[i0]);
+                    out_y[row_idx + c] =
+                        out_y[i0] + f * (out_y[i1] - out_y[i0]);
+                }
+            } else {
+                if (cm - seg.c0 >= 2)
+                    new_segments.push_back(WarpSegment{seg.row, seg.c0, cm});
+                if (seg.c1 - cm >= 2)
+                    new_segments.push_back(WarpSegment{seg.row, cm, seg.c1});
+            }
+        }
+        segments.swap(new_segments);
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+/** \brief Compute the source coordinates of the pixels of a raster.
+ *
+ * This is typically used to reproject a raster: for each pixel of the output
+ * raster, it computes the coordinates of the corresponding location in the
+ * source raster. P must therefore transform from the CRS of the output raster
+ * to the CRS of the source raster in the given direction.
+ *
+ * The coordinates of the center of the pixel at column col and row row of
+ * the output raster are:
+ * - x = geotransform[0] + (col + 0.5) * geotransform[1] +
+ *       (row + 0.5) * geotransform[2]
+ * - y = geotransform[3] + (col + 0.5) * geotransform[4] +
+ *       (row + 0.5) * geotransform[5]
+ *
+ * Instead of transforming each pixel, each row is split into segments whose
+ * middle is transformed. If it is within error_threshold of the linear
+ * interpolation of the ends of the segment, the other pixels of the segment
+ * are interpolated. Otherwise, the segment is halved, and the process is
+ * repeated. All the segments of a level of subdivision are transformed at
+ * once with proj_trans_array(). As the error is only checked at the middle of
+ * the segments, it may be larger at other interpolated pixels, for example
+ * near inflexion points of the transformation.
+ *
+ * Pixels that cannot be transformed are set to HUGE_VAL. Segments with such
+ * pixels at their ends or middle are never interpolated.
+ *
+ * @param context The PJ_CONTEXT object.
+ * @param P Transformation object
+ * @param direction Transformation direction
+ * @param geotransform Array of 6 values, in the same convention as GDAL,
+ * giving the coordinates of the output raster pixels.
+ * @param width Number of columns of the output raster.
+ * @param height Number of rows of the output raster.
+ * @param error_threshold Maximum error, in the units of the source CRS,
+ * allowed at the middle of interpolated segments. 0 to transform every pixel
+ * without any interpolation.
+ * @param out_x Array of width * height values receiving the first
+ * coordinate of each pixel in the source CRS, stored row by row.
+ * @param out_y Array of width * height values receiving the second
+ * coordinate of each pixel in the source CRS, stored row by row.
+ * @param options a list of NUL terminated options, or NULL.
+ * The list itself is NULL terminated.
+ * Supported options are:
+ * <ul>
+ * <li>THREADS=number/ALL_CPUS: number of threads used to process the rows.
+ * Defaults to 1.</li>
+ * </ul>
+ * @return 1 if successful, 0 if the arguments are invalid.
+ * @since 9.5
+ */
+int proj_trans_warp_grid(PJ_CONTEXT *context, PJ *P, PJ_DIRECTION direction,
+                         const double geotransform[6], int width, int height,
+                         double error_threshold, double *out_x, double *out_y,
+                         const char *const *options) {
+    if (P == nullptr || geotransform == nullptr || width <= 0 ||
+        height <= 0 || out_x == nullptr || out_y == nullptr) {
+        proj_log_error(P, _("missing required input"));
+        proj_errno_set(P, PROJ_ERR_OTHER_API_MISUSE);
+        return false;
+    }
+    if (!context) {
+        context = P->ctx;
+    }
+    if (!(error_threshold >= 0)) {
+        proj_log_error(P, _("error_threshold must be positive."));
+        proj_errno_set(P, PROJ_ERR_INVALID_OP_ILLEGAL_ARG_VALUE);
+        return false;
+    }
+
+    int nThreads = 1;
+    for (auto iter = options; iter && iter[0]; ++iter) {
+        const char *value;
+        if ((value = getOptionValue(*iter, "THREADS="))) {
+            nThreads = get_thread_count(value);
+        } else {
+            std::string msg("Unknown option :");
+            msg += *iter;
+            proj_log_error(P, msg.c_str());
+            proj_errno_set(P, PROJ_ERR_INVALID_OP_ILLEGAL_ARG_VALUE);
+            return false;
+        }
+    }
+
+    WarpGrid grid;
+    grid.direction = direction;
+    grid.geotransform = geotransform;
+    grid.width = width;
+    grid.error_threshold = error_threshold;
+    grid.out_x = out_x;
+    grid.out_y = out_y;
+
+    const int rows_per_band =
+        std::max(1, std::min(height, WARP_GRID_BAND_PIXELS / width));
+    const int nBands = (height + rows_per_band - 1) / rows_per_band;
+    process_bands(context, P, nThreads, nBands,
+                  [&grid, rows_per_band, height](PJ *bandP, int band) {
+                      const int row = band * rows_per_band;
+                      trans_warp_grid_band(
+                          bandP, grid, row,
+                          std::min(row + rows_per_band, height));
+                  });
+    return true;
+}
+
 /*****************************************************************************/
 int proj_errno(const PJ *P) {
     /******************************************************************************
@@ -2613,15 +3942,16 @@ PJ_PROJ_INFO proj_pj_info(PJ *P) {
     /* coordinate operation description */
     if (!P->alternativeCoordinateOperations.empty()) {
         if (P->iCurCoordOp >= 0) {
-            P = P->alternativeCoordinateOperations[P->iCurCoordOp].pj;
+            P = P->alternativeCoordinateOperations[P->iCurCoordOp]
+                    .instantiatedPJ();
         } else {
-            PJ *candidateOp = nullptr;
+            PJCoordOperation *candidateOp = nullptr;
             // If there's just a single coordinate operation which is
             // instanciable, use it.
-            for (const auto &op : P->alternativeCoordinateOperations) {
+            for (auto &op : P->alternativeCoordinateOperations) {
                 if (op.isInstantiable()) {
                     if (candidateOp == nullptr) {
-                        candidateOp = op.pj;
+                        candidateOp = &op;
                     } else {
                         candidateOp = nullptr;
                         break;
@@ -2629,7 +3959,7 @@ PJ_PROJ_INFO proj_pj_info(PJ *P) {
                 }
             }
             if (candidateOp) {
-                P = candidateOp;
+                P = candidateOp->instantiatedPJ();
             } else {
                 pjinfo.id = "unknown";
                 pjinfo.description = "unavailable until proj_trans is called";
@@ -2764,6 +4094,81 @@ PJ_GRID_INFO proj_grid_info(const char *gridname) {
     return grinfo;
 }
 
+/*****************************************************************************/
+
+/** Extract the part of a GeoTIFF grid covering an area of interest.
+ *
+ * Only the tiles (or strips) of the grid, and of its subgrids, that are
+ * needed to interpolate values within the area of interest are copied,
+ * without being decompressed. Overviews are not copied. The resulting file
+ * keeps the metadata of the original grid, so that it can be used in place
+ * of it when installed under the same name. Using it outside of the area of
+ * interest will fail as for any point outside of a grid.
+ *
+ * The grid may be a local file, or a remote one if networking is enabled, in
+ * which case only the needed parts of it are downloaded.
+ *
+ * This function requires PROJ to be built with TIFF support.
+ *
+ * @param ctx PROJ context, or NULL
+ * @param grid_name Grid name, filename or URL (must not be NULL)
+ * @param west Western bound of the area of interest. In degrees for grids
+ *             referenced to a geographic CRS, otherwise in the units of the
+ *             CRS of the grid.
+ * @param south Southern bound of the area of interest.
+ * @param east Eastern bound of the area of interest. May be lower than west
+ *             if the area crosses the antimeridian.
+ * @param north Northern bound of the area of interest.
+ * @param output_filename Output filename, or NULL to write a file with the
+ *                        same name as the grid in the PROJ user-writable
+ *                        directory.
+ * @return TRUE in case of success.
+ * @since 9.5
+ */
+int proj_grid_extract_subset(PJ_CONTEXT *ctx, const char *grid_name,
+                             double west, double south, double east,
+                             double north, const char *output_filename) {
+    if (ctx == nullptr) {
+        ctx = pj_get_default_ctx();
+    }
+    if (!grid_name) {
+        pj_log(ctx, PJ_LOG_ERROR, "%s: missing required input", __FUNCTION__);
+        return false;
+    }
+    std::string outputFilename;
+    if (output_filename) {
+        outputFilename = output_filename;
+    } else {
+        const char *basename = grid_name;
+        for (const char *iter = grid_name; *iter; ++iter) {
+            if (*iter == '/' || *iter == '\\')
+                basename = iter + 1;
+        }
+        outputFilename =
+            std::string(proj_context_get_user_writable_directory(ctx, true))
+                .append("/")
+                .append(basename);
+    }
+
+    // The grid itself might be the file to be replaced
+    const std::string tmpFilename(outputFilename + ".tmp");
+    if (!NS_PROJ::pj_grid_extract_subset(ctx, grid_name, west, south, east,
+                                         north, tmpFilename)) {
+        NS_PROJ::FileManager::unlink(ctx, tmpFilename.c_str());
+        return false;
+    }
+    NS_PROJ::FileManager::unlink(ctx, outputFilename.c_str());
+    if (!NS_PROJ::FileManager::rename(ctx, tmpFilename.c_str(),
+                                      outputFilename.c_str())) {
+        pj_log(ctx, PJ_LOG_ERROR, "%s: Cannot rename %s to %s", __FUNCTION__,
+               tmpFilename.c_str(), outputFilename.c_str());
+        return false;
+    }
+    // The content of a grid may have changed
+    pj_clear_grid_availability_cache();
+    return true;
+}
+
 /*****************************************************************************/
 PJ_INIT_INFO proj_init_info(const char *initname) {
     /******************************************************************************
@@ -9,6 +9,9 @@ source_group("Source Files\\Bin" FILES ${GIE_SRC})
 
 add_executable(gie ${GIE_SRC} ${GIE_INCLUDE})
 target_link_libraries(gie PRIVATE ${PROJ_LIBRARIES})
+if(Threads_FOUND AND CMAKE_USE_PTHREADS_INIT)
+  target_link_libraries(gie PRIVATE ${CMAKE_THREAD_LIBS_INIT})
+endif()
 
 if(BUILD_GIE)
   install(TARGETS gie
@@ -4,6 +4,9 @@ source_group("Source Files\\Bin" FILES ${PROJSYNC_SRC})
 
 add_executable(projsync ${PROJSYNC_SRC})
 target_link_libraries(projsync PRIVATE ${PROJ_LIBRARIES})
+if(Threads_FOUND AND CMAKE_USE_PTHREADS_INIT)
+  target_link_libraries(projsync PRIVATE ${CMAKE_THREAD_LIBS_INIT})
+endif()
 
 install(TARGETS projsync
   DESTINATION ${CMAKE_INSTALL_BINDIR})
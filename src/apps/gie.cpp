@@ -116,8 +116,14 @@ Thomas Knudsen, thokn@sdfe.dk, 2017-10-01/2017-10-08
 #include "proj.h"
 #include "proj_internal.h"
 #include "proj_strtod.h"
+#include <atomic>
+#include <chrono>
 #include <cmath> /* for isnan */
 #include <math.h>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "optargpm.h"
 
@@ -176,9 +182,14 @@ int main(int argc, char **argv);
 
 static int dispatch(const char *cmnd, const char *args);
 static int errmsg(int errlev, const char *msg, ...);
+static void gie_printf(const char *fmt, ...);
 static int errno_from_err_const(const char *err_const);
 static int list_err_codes(void);
 static int process_file(const char *fname);
+static void process_files_in_parallel(int nfiles, char **fnames, int jobs);
+static void report_timing(const char *what, int nops, double setup_time,
+                          int ncoords, double trans_time);
+static void finish_operation_timing(void);
 
 static const char *column(const char *buf, int n);
 static const char *err_const_from_errno(int err);
@@ -206,15 +217,29 @@ typedef struct {
     int use_proj4_init_rules;
     int ignore;
     int skip_test;
+    int tests, succs, succ_fails, fail_fails, succ_rtps, fail_rtps;
+    int timing, op_timed;
+    int op_ncoords, total_ncoords, grand_ncoords;
+    int total_nops, grand_nops;
+    double op_setup_time, total_setup_time, grand_setup_time;
+    double op_trans_time, total_trans_time, grand_trans_time;
     const char *curr_file;
+    PJ_CONTEXT *ctx; /* nullptr, i.e. the default context, unless -j is used */
     FILE *fout;
+    std::string *report; /* buffered output of the file, when -j is used */
 } gie_ctx;
 
-ffio *F = nullptr;
+/* Each thread running tests has its own input and state */
+static thread_local ffio *F = nullptr;
 
-static gie_ctx T;
-int tests = 0, succs = 0, succ_fails = 0, fail_fails = 0, succ_rtps = 0,
-    fail_rtps = 0;
+static thread_local gie_ctx T;
+
+typedef std::chrono::steady_clock gie_clock;
+
+static double ms_since(gie_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(gie_clock::now() - start)
+        .count();
+}
 
 static const char delim[] = {"-------------------------------------------------"
                              "------------------------------\n"};
@@ -240,6 +265,9 @@ static const char usage[] = {
     "                      (0 on success, non-zero indicates number of FAILED "
     "tests)\n"
     "    -l                List the PROJ internal system error codes\n"
+    "    -j n              Jobs: process up to n input files in parallel, "
+    "each\n"
+    "                      file starting from the default settings\n"
     "--------------------------------------------------------------------------"
     "------\n"
     "Long Options:\n"
@@ -249,6 +277,10 @@ static const char usage[] = {
     "    --verbose         Alias for -v\n"
     "    --help            Alias for -h\n"
     "    --list            Alias for -l\n"
+    "    --jobs            Alias for -j\n"
+    "    --timing          Report the time spent setting up each operation "
+    "and\n"
+    "                      transforming its coordinates, and the throughput\n"
     "    --version         Print version number\n"
     "--------------------------------------------------------------------------"
     "------\n"
@@ -261,14 +293,18 @@ static const char usage[] = {
     "2. Run all tests in files \"foo\" and \"bar\", providing info on failures "
     "only\n"
     "       gie foo bar\n"
+    "3. Run all tests in files \"foo\" and \"bar\" in parallel, and time "
+    "them\n"
+    "       gie -j 2 --timing foo bar\n"
     "--------------------------------------------------------------------------"
     "------\n"};
 
 int main(int argc, char **argv) {
     int i;
-    const char *longflags[] = {"v=verbose", "q=quiet", "h=help",
-                               "l=list",    "version", nullptr};
-    const char *longkeys[] = {"o=output", nullptr};
+    int jobs = 1;
+    const char *longflags[] = {"v=verbose", "q=quiet", "h=help", "l=list",
+                               "version",   "timing",  nullptr};
+    const char *longkeys[] = {"o=output", "j=jobs", nullptr};
     OPTARGS *o;
 
     memset(&T, 0, sizeof(T));
@@ -279,7 +315,7 @@ int main(int argc, char **argv) {
     T.use_proj4_init_rules = FALSE;
 
     /* coverity[tainted_data] */
-    o = opt_parse(argc, argv, "hlvq", "o", longflags, longkeys);
+    o = opt_parse(argc, argv, "hlvq", "oj", longflags, longkeys);
     if (nullptr == o)
         return 0;
 
@@ -301,6 +337,15 @@ int main(int argc, char **argv) {
     if (T.verbosity != -1)
         T.verbosity = opt_given(o, "v") + 1;
 
+    T.timing = opt_given(o, "timing");
+    if (opt_given(o, "j"))
+        jobs = atoi(opt_arg(o, "jobs"));
+    if (jobs < 1) {
+        fprintf(stderr, "%s: Invalid number of jobs\n", o->progname);
+        free(o);
+        return 1;
+    }
+
     T.fout = stdout;
     if (opt_given(o, "o"))
         T.fout = fopen(opt_arg(o, "output"), "rt");
@@ -320,68 +365,92 @@ int main(int argc, char **argv) {
     if (0 == o->fargc) {
         if (T.verbosity == -1)
             return -1;
-        fprintf(T.fout, "Nothing to do\n");
+        gie_printf("Nothing to do\n");
         free(o);
         return 0;
     }
 
-    F = ffio_create(gie_tags, n_gie_tags, 1000);
-    if (nullptr == F) {
-        fprintf(stderr, "%s: No memory\n", o->progname);
-        free(o);
-        return 1;
-    }
-
     for (i = 0; i < o->fargc; i++) {
         FILE *f = fopen(o->fargv[i], "rt");
         if (f == nullptr) {
-            fprintf(T.fout, "%sCannot open specified input file '%s' - bye!\n",
-                    delim, o->fargv[i]);
+            gie_printf("%sCannot open specified input file '%s' - bye!\n",
+                       delim, o->fargv[i]);
             return 1;
         }
         fclose(f);
     }
 
-    for (i = 0; i < o->fargc; i++)
-        process_file(o->fargv[i]);
+    const auto start = gie_clock::now();
+    if (jobs > 1 && o->fargc > 1) {
+        process_files_in_parallel(o->fargc, o->fargv, jobs);
+    } else {
+        F = ffio_create(gie_tags, n_gie_tags, 1000);
+        if (nullptr == F) {
+            fprintf(stderr, "%s: No memory\n", o->progname);
+            free(o);
+            return 1;
+        }
+        for (i = 0; i < o->fargc; i++)
+            process_file(o->fargv[i]);
+        ffio_destroy(F);
+    }
+    const double elapsed = ms_since(start);
 
     if (T.verbosity > 0) {
         if (o->fargc > 1) {
-            fprintf(
-                T.fout,
+            gie_printf(
                 "%sGrand total: %d. Success: %d, Skipped: %d, Failure: %d\n",
                 delim, T.grand_ok + T.grand_ko + T.grand_skip, T.grand_ok,
                 T.grand_skip, T.grand_ko);
         }
-        fprintf(T.fout, "%s", delim);
+        gie_printf("%s", delim);
         if (T.verbosity > 1) {
-            fprintf(T.fout,
-                    "Failing roundtrips: %4d,    Succeeding roundtrips: %4d\n",
-                    fail_rtps, succ_rtps);
-            fprintf(T.fout,
-                    "Failing failures:   %4d,    Succeeding failures:   %4d\n",
-                    fail_fails, succ_fails);
-            fprintf(
-                T.fout,
+            gie_printf(
+                "Failing roundtrips: %4d,    Succeeding roundtrips: %4d\n",
+                T.fail_rtps, T.succ_rtps);
+            gie_printf(
+                "Failing failures:   %4d,    Succeeding failures:   %4d\n",
+                T.fail_fails, T.succ_fails);
+            gie_printf(
                 "Internal counters:                            %4.4d(%4.4d)\n",
-                tests, succs);
-            fprintf(T.fout, "%s", delim);
+                T.tests, T.succs);
+            gie_printf("%s", delim);
         }
     } else if (T.grand_ko)
-        fprintf(T.fout, "Failures: %d", T.grand_ko);
+        gie_printf("Failures: %d", T.grand_ko);
+
+    if (T.timing && T.verbosity > -1) {
+        report_timing("Grand total timing", T.grand_nops, T.grand_setup_time,
+                      T.grand_ncoords, T.grand_trans_time);
+        gie_printf("Elapsed time: %.1f ms with %d job(s)\n%s", elapsed, jobs,
+                   delim);
+    }
 
     if (stdout != T.fout)
         fclose(T.fout);
 
     free(o);
-    ffio_destroy(F);
     return T.grand_ko;
 }
 
+static int gie_errno(void) {
+    /* Without a PJ, errors are reported through the context */
+    if (nullptr == T.P)
+        return proj_context_errno(T.ctx);
+    return proj_errno(T.P);
+}
+
+static void gie_errno_reset(void) {
+    if (T.P || nullptr == T.ctx)
+        proj_errno_reset(T.P);
+    else
+        T.ctx->last_errno = 0;
+}
+
 static int another_failure(void) {
     T.op_ko++;
     T.total_ko++;
-    proj_errno_reset(T.P);
+    gie_errno_reset();
     return 0;
 }
 
@@ -394,27 +463,27 @@ static int another_skip(void) {
 static int another_success(void) {
     T.op_ok++;
     T.total_ok++;
-    proj_errno_reset(T.P);
+    gie_errno_reset();
     return 0;
 }
 
 static int another_succeeding_failure(void) {
-    succ_fails++;
+    T.succ_fails++;
     return another_success();
 }
 
 static int another_failing_failure(void) {
-    fail_fails++;
+    T.fail_fails++;
     return another_failure();
 }
 
 static int another_succeeding_roundtrip(void) {
-    succ_rtps++;
+    T.succ_rtps++;
     return another_success();
 }
 
 static int another_failing_roundtrip(void) {
-    fail_rtps++;
+    T.fail_rtps++;
     return another_failure();
 }
 
@@ -423,6 +492,9 @@ static int process_file(const char *fname) {
     T.op_ok = T.total_ok = 0;
     T.op_ko = T.total_ko = 0;
     T.op_skip = T.total_skip = 0;
+    T.op_timed = 0;
+    T.total_nops = T.total_ncoords = 0;
+    T.total_setup_time = T.total_trans_time = 0;
 
     if (T.skip) {
         proj_destroy(T.P);
@@ -434,7 +506,7 @@ static int process_file(const char *fname) {
     F->f = fopen(fname, "rt");
 
     if (T.verbosity > 0)
-        fprintf(T.fout, "%sReading file '%s'\n", delim, fname);
+        gie_printf("%sReading file '%s'\n", delim, fname);
     T.curr_file = fname;
 
     while (get_inp(F)) {
@@ -447,17 +519,24 @@ static int process_file(const char *fname) {
 
     fclose(F->f);
     F->lineno = F->next_lineno = 0;
+    finish_operation_timing();
 
     T.grand_ok += T.total_ok;
     T.grand_ko += T.total_ko;
-    T.grand_skip += T.grand_skip;
+    T.grand_skip += T.total_skip;
+    T.grand_nops += T.total_nops;
+    T.grand_ncoords += T.total_ncoords;
+    T.grand_setup_time += T.total_setup_time;
+    T.grand_trans_time += T.total_trans_time;
     if (T.verbosity > 0) {
-        fprintf(
-            T.fout,
+        gie_printf(
             "%stotal: %2d tests succeeded, %2d tests skipped, %2d tests %s\n",
             delim, T.total_ok, T.total_skip, T.total_ko,
             T.total_ko ? "FAILED!" : "failed.");
     }
+    if (T.timing && T.verbosity > -1)
+        report_timing("timing", T.total_nops, T.total_setup_time,
+                      T.total_ncoords, T.total_trans_time);
     if (F->level == 0)
         return errmsg(-3, "File '%s':Missing '<gie>' cmnd - bye!\n", fname);
     if (F->level && F->level % 2) {
@@ -471,6 +550,84 @@ static int process_file(const char *fname) {
     return 0;
 }
 
+/*****************************************************************************/
+static void process_files_in_parallel(int nfiles, char **fnames, int jobs) {
+    /*****************************************************************************
+    Distribute the files over a number of worker threads, each having its own
+    context and state. Every file starts from the settings given on the
+    command line, and its report is buffered until all files are processed,
+    so that the output comes in the same order as in the sequential case.
+    ******************************************************************************/
+    static gie_ctx initial;
+    gie_ctx *grand = &T;
+    std::vector<std::string> reports(nfiles);
+    std::vector<bool> processed(nfiles, false);
+    std::atomic<int> next_file(0);
+    std::mutex mutex;
+
+    initial = T;
+
+    const auto worker = [&]() {
+        F = ffio_create(gie_tags, n_gie_tags, 1000);
+        if (nullptr == F)
+            return;
+        for (int i = next_file++; i < nfiles; i = next_file++) {
+            T = initial;
+            T.report = &reports[i];
+            T.ctx = proj_context_create();
+            process_file(fnames[i]);
+            proj_destroy(T.P);
+            proj_context_destroy(T.ctx);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            grand->grand_ok += T.grand_ok;
+            grand->grand_ko += T.grand_ko;
+            grand->grand_skip += T.grand_skip;
+            grand->tests += T.tests;
+            grand->succs += T.succs;
+            grand->succ_fails += T.succ_fails;
+            grand->fail_fails += T.fail_fails;
+            grand->succ_rtps += T.succ_rtps;
+            grand->fail_rtps += T.fail_rtps;
+            grand->grand_nops += T.grand_nops;
+            grand->grand_ncoords += T.grand_ncoords;
+            grand->grand_setup_time += T.grand_setup_time;
+            grand->grand_trans_time += T.grand_trans_time;
+            processed[i] = true;
+        }
+        ffio_destroy(F);
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < jobs && i < nfiles; i++)
+        threads.emplace_back(worker);
+    for (auto &thread : threads)
+        thread.join();
+
+    for (int i = 0; i < nfiles; i++) {
+        if (!processed[i]) {
+            gie_printf("%sCould not process file '%s'\n", delim, fnames[i]);
+            T.grand_ko++;
+            continue;
+        }
+        fwrite(reports[i].data(), 1, reports[i].size(), T.fout);
+    }
+}
+
+/*****************************************************************************/
+static void report_timing(const char *what, int nops, double setup_time,
+                          int ncoords, double trans_time) {
+    /*****************************************************************************
+    Report the time spent setting up operations and transforming coordinates
+    ******************************************************************************/
+    gie_printf("%s: %d operations set up in %.1f ms, %d coordinates "
+               "transformed in %.1f ms",
+               what, nops, setup_time, ncoords, trans_time);
+    if (trans_time > 0)
+        gie_printf(" (%.0f coordinates/s)", 1000 * ncoords / trans_time);
+    gie_printf("\n");
+}
+
 /*****************************************************************************/
 const char *column(const char *buf, int n) {
     /*****************************************************************************
@@ -532,7 +689,7 @@ static int banner(const char *args) {
     char dots[] = {"..."}, nodots[] = {""}, *thedots = nodots;
     if (strlen(args) > 70)
         thedots = dots;
-    fprintf(T.fout, "%s%-70.70s%s\n", delim, args, thedots);
+    gie_printf("%s%-70.70s%s\n", delim, args, thedots);
     return 0;
 }
 
@@ -556,13 +713,19 @@ static int ignore(const char *args) {
 }
 
 static int require_grid(const char *args) {
+    static std::mutex grid_info_mutex;
     PJ_GRID_INFO grid_info;
     const char *grid_filename = column(args, 1);
-    grid_info = proj_grid_info(grid_filename);
+    {
+        /* proj_grid_info() works on the default context, which must not be */
+        /* used by several threads at once */
+        std::lock_guard<std::mutex> lock(grid_info_mutex);
+        grid_info = proj_grid_info(grid_filename);
+    }
     if (strlen(grid_info.filename) == 0) {
         if (T.verbosity > 1) {
-            fprintf(T.fout, "Test skipped because of missing grid %s\n",
-                    grid_filename);
+            gie_printf("Test skipped because of missing grid %s\n",
+                       grid_filename);
         }
         T.skip_test = 1;
     }
@@ -593,13 +756,34 @@ static int direction(const char *args) {
 
 static void finish_previous_operation(const char *args) {
     if (T.verbosity > 1 && T.op_id > 1 && T.op_ok + T.op_ko)
-        fprintf(T.fout,
-                "%s     %d tests succeeded,  %d tests skipped, %d tests %s\n",
-                delim, T.op_ok, T.op_skip, T.op_ko,
-                T.op_ko ? "FAILED!" : "failed.");
+        gie_printf(
+            "%s     %d tests succeeded,  %d tests skipped, %d tests %s\n",
+            delim, T.op_ok, T.op_skip, T.op_ko,
+            T.op_ko ? "FAILED!" : "failed.");
     (void)args;
 }
 
+static void finish_operation_timing(void) {
+    if (!T.op_timed)
+        return;
+    T.op_timed = 0;
+    T.total_nops++;
+    T.total_ncoords += T.op_ncoords;
+    T.total_setup_time += T.op_setup_time;
+    T.total_trans_time += T.op_trans_time;
+    if (T.timing && T.verbosity > -1)
+        gie_printf("timing %s(%d): setup %.3f ms, %d coordinates in %.3f ms\n",
+                   opt_strip_path(T.curr_file), (int)T.operation_lineno,
+                   T.op_setup_time, T.op_ncoords, T.op_trans_time);
+}
+
+static void start_operation_timing(void) {
+    finish_operation_timing();
+    T.op_timed = 1;
+    T.op_ncoords = 0;
+    T.op_setup_time = T.op_trans_time = 0;
+}
+
 /*****************************************************************************/
 static int operation(const char *args) {
     /*****************************************************************************
@@ -628,14 +812,18 @@ static int operation(const char *args) {
     tolerance("0.5 mm");
     ignore("pjd_err_dont_skip");
 
-    proj_errno_reset(T.P);
+    gie_errno_reset();
 
     if (T.P)
         proj_destroy(T.P);
-    proj_errno_reset(nullptr);
-    proj_context_use_proj4_init_rules(nullptr, T.use_proj4_init_rules);
+    T.P = nullptr;
+    gie_errno_reset();
+    proj_context_use_proj4_init_rules(T.ctx, T.use_proj4_init_rules);
 
-    T.P = proj_create(nullptr, F->args);
+    start_operation_timing();
+    const auto start = gie_clock::now();
+    T.P = proj_create(T.ctx, F->args);
+    T.op_setup_time += ms_since(start);
 
     /* Checking that proj_create succeeds is first done at "expect" time, */
     /* since we want to support "expect"ing specific error codes */
@@ -663,14 +851,18 @@ static int crs_to_crs_operation() {
     tolerance("0.5 mm");
     ignore("pjd_err_dont_skip");
 
-    proj_errno_reset(T.P);
+    gie_errno_reset();
 
     if (T.P)
         proj_destroy(T.P);
-    proj_errno_reset(nullptr);
-    proj_context_use_proj4_init_rules(nullptr, T.use_proj4_init_rules);
+    T.P = nullptr;
+    gie_errno_reset();
+    proj_context_use_proj4_init_rules(T.ctx, T.use_proj4_init_rules);
 
-    T.P = proj_create_crs_to_crs(nullptr, T.crs_src, T.crs_dst, nullptr);
+    start_operation_timing();
+    const auto start = gie_clock::now();
+    T.P = proj_create_crs_to_crs(T.ctx, T.crs_src, T.crs_dst, nullptr);
+    T.op_setup_time += ms_since(start);
 
     strcpy(T.crs_src, "");
     strcpy(T.crs_dst, "");
@@ -788,7 +980,7 @@ static int accept(const char *args) {
     ******************************************************************************/
     T.a = parse_coord(args);
     if (T.verbosity > 3)
-        fprintf(T.fout, "#  %s\n", args);
+        gie_printf("#  %s\n", args);
     T.dimensions_given_at_last_accept = T.dimensions_given;
     return 0;
 }
@@ -819,7 +1011,7 @@ static int roundtrip(const char *args) {
     PJ_COORD coo;
 
     if (nullptr == T.P) {
-        if (T.ignore == proj_errno(T.P))
+        if (T.ignore == gie_errno())
             return another_skip();
 
         return another_failure();
@@ -843,19 +1035,21 @@ static int roundtrip(const char *args) {
     /* input ("accepted") values - probably in degrees */
     coo = proj_angular_input(T.P, T.dir) ? torad_coord(T.P, T.dir, T.a) : T.a;
 
+    const auto start = gie_clock::now();
     r = proj_roundtrip(T.P, T.dir, ntrips, &coo);
+    T.op_trans_time += ms_since(start);
+    T.op_ncoords += 2 * ntrips;
     if ((std::isnan(r) && std::isnan(d)) || r <= d)
         return another_succeeding_roundtrip();
 
     if (T.verbosity > -1) {
         if (0 == T.op_ko && T.verbosity < 2)
             banner(T.operation);
-        fprintf(T.fout, "%s", T.op_ko ? "     -----\n" : delim);
-        fprintf(T.fout, "     FAILURE in %s(%d):\n",
-                opt_strip_path(T.curr_file), (int)F->lineno);
-        fprintf(T.fout,
-                "     roundtrip deviation: %.6f mm, expected: %.6f mm\n",
-                1000 * r, 1000 * d);
+        gie_printf("%s", T.op_ko ? "     -----\n" : delim);
+        gie_printf("     FAILURE in %s(%d):\n", opt_strip_path(T.curr_file),
+                   (int)F->lineno);
+        gie_printf("     roundtrip deviation: %.6f mm, expected: %.6f mm\n",
+                   1000 * r, 1000 * d);
     }
     return another_failing_roundtrip();
 }
@@ -869,19 +1063,19 @@ static int expect_message(double d, const char *args) {
         d = 999999.999999;
     if (0 == T.op_ko && T.verbosity < 2)
         banner(T.operation);
-    fprintf(T.fout, "%s", T.op_ko ? "     -----\n" : delim);
+    gie_printf("%s", T.op_ko ? "     -----\n" : delim);
 
-    fprintf(T.fout, "     FAILURE in %s(%d):\n", opt_strip_path(T.curr_file),
-            (int)F->lineno);
-    fprintf(T.fout, "     expected: %s\n", args);
-    fprintf(T.fout, "     got:      %.12f   %.12f", T.b.xy.x, T.b.xy.y);
+    gie_printf("     FAILURE in %s(%d):\n", opt_strip_path(T.curr_file),
+               (int)F->lineno);
+    gie_printf("     expected: %s\n", args);
+    gie_printf("     got:      %.12f   %.12f", T.b.xy.x, T.b.xy.y);
     if (T.b.xyzt.t != 0 || T.b.xyzt.z != 0)
-        fprintf(T.fout, "   %.9f", T.b.xyz.z);
+        gie_printf("   %.9f", T.b.xyz.z);
     if (T.b.xyzt.t != 0)
-        fprintf(T.fout, "   %.9f", T.b.xyzt.t);
-    fprintf(T.fout, "\n");
-    fprintf(T.fout, "     deviation:  %.6f mm,  expected:  %.6f mm\n", 1000 * d,
-            1000 * T.tolerance);
+        gie_printf("   %.9f", T.b.xyzt.t);
+    gie_printf("\n");
+    gie_printf("     deviation:  %.6f mm,  expected:  %.6f mm\n", 1000 * d,
+               1000 * T.tolerance);
     return 1;
 }
 
@@ -890,9 +1084,9 @@ static int expect_message_cannot_parse(const char *args) {
     if (T.verbosity > -1) {
         if (0 == T.op_ko && T.verbosity < 2)
             banner(T.operation);
-        fprintf(T.fout, "%s", T.op_ko ? "     -----\n" : delim);
-        fprintf(T.fout, "     FAILURE in %s(%d):\n     Too few args: %s\n",
-                opt_strip_path(T.curr_file), (int)F->lineno, args);
+        gie_printf("%s", T.op_ko ? "     -----\n" : delim);
+        gie_printf("     FAILURE in %s(%d):\n     Too few args: %s\n",
+                   opt_strip_path(T.curr_file), (int)F->lineno, args);
     }
     return 1;
 }
@@ -904,15 +1098,14 @@ static int expect_failure_with_errno_message(int expected, int got) {
         return 1;
     if (0 == T.op_ko && T.verbosity < 2)
         banner(T.operation);
-    fprintf(T.fout, "%s", T.op_ko ? "     -----\n" : delim);
-    fprintf(T.fout, "     FAILURE in %s(%d):\n", opt_strip_path(T.curr_file),
-            (int)F->lineno);
-    fprintf(T.fout, "     got errno %s (%d): %s\n", err_const_from_errno(got),
-            got, proj_errno_string(got));
-    fprintf(T.fout, "     expected %s (%d):  %s",
-            err_const_from_errno(expected), expected,
-            proj_errno_string(expected));
-    fprintf(T.fout, "\n");
+    gie_printf("%s", T.op_ko ? "     -----\n" : delim);
+    gie_printf("     FAILURE in %s(%d):\n", opt_strip_path(T.curr_file),
+               (int)F->lineno);
+    gie_printf("     got errno %s (%d): %s\n", err_const_from_errno(got), got,
+               proj_errno_string(got));
+    gie_printf("     expected %s (%d):  %s", err_const_from_errno(expected),
+               expected, proj_errno_string(expected));
+    gie_printf("\n");
     return 1;
 }
 
@@ -928,6 +1121,14 @@ static PJ_COORD expect_trans_n_dim(const PJ_COORD &ci) {
     return pj_approx_2D_trans(T.P, T.dir, ci);
 }
 
+static PJ_COORD timed_expect_trans_n_dim(const PJ_COORD &ci) {
+    const auto start = gie_clock::now();
+    const PJ_COORD co = expect_trans_n_dim(ci);
+    T.op_trans_time += ms_since(start);
+    T.op_ncoords++;
+    return co;
+}
+
 /*****************************************************************************/
 static int expect(const char *args) {
     /*****************************************************************************
@@ -947,7 +1148,7 @@ static int expect(const char *args) {
             expect_failure_with_errno = errno_from_err_const(column(args, 3));
     }
 
-    if (T.ignore == proj_errno(T.P))
+    if (T.ignore == gie_errno())
         return another_skip();
 
     if (nullptr == T.P) {
@@ -955,9 +1156,9 @@ static int expect(const char *args) {
         if (expect_failure) {
             /* Failed to fail correctly? */
             if (expect_failure_with_errno &&
-                proj_errno(T.P) != expect_failure_with_errno)
+                gie_errno() != expect_failure_with_errno)
                 return expect_failure_with_errno_message(
-                    expect_failure_with_errno, proj_errno(T.P));
+                    expect_failure_with_errno, gie_errno());
 
             return another_succeeding_failure();
         }
@@ -968,28 +1169,28 @@ static int expect(const char *args) {
                "%sInvalid operation definition in line no. %d:\n       %s "
                "(errno=%s/%d)\n",
                delim, (int)T.operation_lineno,
-               proj_errno_string(proj_errno(T.P)),
-               err_const_from_errno(proj_errno(T.P)), proj_errno(T.P));
+               proj_errno_string(gie_errno()),
+               err_const_from_errno(gie_errno()), gie_errno());
         return another_failing_failure();
     }
 
     /* We may still successfully fail even if the proj_create succeeded */
     if (expect_failure) {
-        proj_errno_reset(T.P);
+        gie_errno_reset();
 
         /* Try to carry out the operation - and expect failure */
         ci =
             proj_angular_input(T.P, T.dir) ? torad_coord(T.P, T.dir, T.a) : T.a;
-        co = expect_trans_n_dim(ci);
+        co = timed_expect_trans_n_dim(ci);
 
         if (expect_failure_with_errno) {
-            if (proj_errno(T.P) == expect_failure_with_errno)
+            if (gie_errno() == expect_failure_with_errno)
                 return another_succeeding_failure();
             // fprintf (T.fout, "errno=%d, expected=%d\n", proj_errno (T.P),
             // expect_failure_with_errno);
             banner(T.operation);
             errmsg(3, "%serrno=%s (%d), expected=%d at line %d\n", delim,
-                   err_const_from_errno(proj_errno(T.P)), proj_errno(T.P),
+                   err_const_from_errno(gie_errno()), gie_errno(),
                    expect_failure_with_errno, static_cast<int>(F->lineno));
             return another_failing_failure();
         }
@@ -1006,16 +1207,17 @@ static int expect(const char *args) {
     }
 
     if (T.verbosity > 3) {
-        fprintf(T.fout, "%s\n", T.P->inverted ? "INVERTED" : "NOT INVERTED");
-        fprintf(T.fout, "%s\n", T.dir == 1 ? "forward" : "reverse");
-        fprintf(T.fout, "%s\n",
-                proj_angular_input(T.P, T.dir) ? "angular in" : "linear in");
-        fprintf(T.fout, "%s\n",
-                proj_angular_output(T.P, T.dir) ? "angular out" : "linear out");
-        fprintf(T.fout, "left: %d   right:  %d\n", T.P->left, T.P->right);
+        gie_printf("%s\n", T.P->inverted ? "INVERTED" : "NOT INVERTED");
+        gie_printf("%s\n", T.dir == 1 ? "forward" : "reverse");
+        gie_printf("%s\n",
+                   proj_angular_input(T.P, T.dir) ? "angular in" : "linear in");
+        gie_printf(
+            "%s\n",
+            proj_angular_output(T.P, T.dir) ? "angular out" : "linear out");
+        gie_printf("left: %d   right:  %d\n", T.P->left, T.P->right);
     }
 
-    tests++;
+    T.tests++;
     T.e = parse_coord(args);
     if (HUGE_VAL == T.e.v[0])
         return expect_message_cannot_parse(args);
@@ -1023,18 +1225,18 @@ static int expect(const char *args) {
     /* expected angular values, probably in degrees */
     ce = proj_angular_output(T.P, T.dir) ? torad_coord(T.P, T.dir, T.e) : T.e;
     if (T.verbosity > 3)
-        fprintf(T.fout, "EXPECTS  %.12f  %.12f  %.12f  %.12f\n", ce.v[0],
-                ce.v[1], ce.v[2], ce.v[3]);
+        gie_printf("EXPECTS  %.12f  %.12f  %.12f  %.12f\n", ce.v[0], ce.v[1],
+                   ce.v[2], ce.v[3]);
 
     /* input ("accepted") values, also probably in degrees */
     ci = proj_angular_input(T.P, T.dir) ? torad_coord(T.P, T.dir, T.a) : T.a;
     if (T.verbosity > 3)
-        fprintf(T.fout, "ACCEPTS  %.12f  %.12f  %.12f  %.12f\n", ci.v[0],
-                ci.v[1], ci.v[2], ci.v[3]);
+        gie_printf("ACCEPTS  %.12f  %.12f  %.12f  %.12f\n", ci.v[0], ci.v[1],
+                   ci.v[2], ci.v[3]);
 
     /* do the transformation, but mask off dimensions not given in expect-ation
      */
-    co = expect_trans_n_dim(ci);
+    co = timed_expect_trans_n_dim(ci);
     if (T.dimensions_given < 4)
         co.v[3] = 0;
     if (T.dimensions_given < 3)
@@ -1043,8 +1245,8 @@ static int expect(const char *args) {
     /* angular output from proj_trans comes in radians */
     T.b = proj_angular_output(T.P, T.dir) ? todeg_coord(T.P, T.dir, co) : co;
     if (T.verbosity > 3)
-        fprintf(T.fout, "GOT      %.12f  %.12f  %.12f  %.12f\n", co.v[0],
-                co.v[1], co.v[2], co.v[3]);
+        gie_printf("GOT      %.12f  %.12f  %.12f  %.12f\n", co.v[0], co.v[1],
+                   co.v[2], co.v[3]);
 
 #if 0
     /* We need to handle unusual axis orders - that'll be an item for version 5.1 */
@@ -1064,7 +1266,7 @@ static int expect(const char *args) {
     // Test written like that to handle NaN
     if (!(d <= T.tolerance))
         return expect_message(d, args);
-    succs++;
+    T.succs++;
 
     another_success();
     return 0;
@@ -1093,7 +1295,7 @@ static int echo(const char *args) {
     /*****************************************************************************
     Add user defined noise to the output stream
     ******************************************************************************/
-    fprintf(T.fout, "%s\n", args);
+    gie_printf("%s\n", args);
     return 0;
 }
 
@@ -1186,8 +1388,8 @@ static int list_err_codes(void) {
     const int n = sizeof lookup / sizeof lookup[0];
 
     for (i = 0; i < n; i++) {
-        fprintf(T.fout, "%25s  (%2.2d):  %s\n", lookup[i].the_err_const,
-                lookup[i].the_errno, proj_errno_string(lookup[i].the_errno));
+        gie_printf("%25s  (%2.2d):  %s\n", lookup[i].the_err_const,
+                   lookup[i].the_errno, proj_errno_string(lookup[i].the_errno));
     }
     return 0;
 }
@@ -1234,10 +1436,38 @@ static int errno_from_err_const(const char *err_const) {
     return 9999;
 }
 
+static void vreport(FILE *f, const char *fmt, va_list args) {
+    if (nullptr == T.report) {
+        vfprintf(f, fmt, args);
+        return;
+    }
+    char buf[1024];
+    va_list args_copy;
+    va_copy(args_copy, args);
+    const int n = vsnprintf(buf, sizeof buf, fmt, args_copy);
+    va_end(args_copy);
+    if (n < 0)
+        return;
+    if (static_cast<size_t>(n) < sizeof buf) {
+        T.report->append(buf, n);
+        return;
+    }
+    std::vector<char> large(n + 1);
+    vsnprintf(large.data(), large.size(), fmt, args);
+    T.report->append(large.data(), n);
+}
+
+static void gie_printf(const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    vreport(T.fout, fmt, args);
+    va_end(args);
+}
+
 static int errmsg(int errlev, const char *msg, ...) {
     va_list args;
     va_start(args, msg);
-    vfprintf(stdout, msg, args);
+    vreport(stdout, msg, args);
     va_end(args);
     if (errlev)
         errno = errlev;
@@ -1490,8 +1720,8 @@ static int get_inp(ffio *G) {
             G->tag = at_tag(G);
             if (nullptr == G->tag) {
                 another_failure();
-                fprintf(T.fout, "unsupported command line %d: %s\n",
-                        (int)G->lineno, G->next_args);
+                gie_printf("unsupported command line %d: %s\n", (int)G->lineno,
+                           G->next_args);
                 return 0;
             }
 
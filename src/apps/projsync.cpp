@@ -29,11 +29,14 @@
 
 #define FROM_PROJ_CPP
 
+#include <atomic>
 #include <cstdlib>
 #include <iostream>
 #include <limits>
+#include <mutex>
 #include <set>
 #include <string>
+#include <thread>
 
 #include "filemanager.hpp"
 #include "proj.h"
@@ -75,6 +78,7 @@ class ParsingException : public std::exception {
     std::cerr << "          [--quiet | --verbose] [--dry-run] [--list-files]"
               << std::endl;
     std::cerr << "          [--no-version-filtering]" << std::endl;
+    std::cerr << "          [--jobs N] [--no-resume] [--subset]" << std::endl;
     std::exit(1);
 }
 
@@ -135,6 +139,9 @@ int main(int argc, char *argv[]) {
     std::string queriedFilename;
     std::string files_geojson_local;
     bool versionFiltering = true;
+    int jobs = 1;
+    bool resume = true;
+    bool subset = false;
 
     for (int i = 1; i < argc; i++) {
         std::string arg(argv[i]);
@@ -215,6 +222,18 @@ int main(int argc, char *argv[]) {
             includeWorldCoverage = false;
         } else if (arg == "--all") {
             queryAll = true;
+        } else if (arg == "--jobs" && i + 1 < argc) {
+            i++;
+            jobs = atoi(argv[i]);
+            if (jobs < 1) {
+                std::cerr << "Invalid value for option --jobs: " << argv[i]
+                          << std::endl;
+                usage();
+            }
+        } else if (arg == "--no-resume") {
+            resume = false;
+        } else if (arg == "--subset") {
+            subset = true;
         } else if (arg == "--no-version-filtering") {
             versionFiltering = false;
         } else if (arg == "-q" || arg == "--quiet") {
@@ -233,6 +252,11 @@ int main(int argc, char *argv[]) {
                   << std::endl;
         usage();
     }
+    if (subset && !hasQueriedBbox) {
+        std::cerr << "--subset requires --bbox to be specified." << std::endl
+                  << std::endl;
+        usage();
+    }
 
     if (targetDir.empty()) {
         targetDir = proj_context_get_user_writable_directory(ctx, true);
@@ -319,7 +343,12 @@ int main(int argc, char *argv[]) {
         if (!j.is_object() || !j.contains("features")) {
             throw ParsingException("no features member");
         }
-        std::vector<std::string> to_download;
+        struct FileToDownload {
+            std::string name{};
+            std::string url{};
+            std::string sha256sum{};
+        };
+        std::vector<FileToDownload> to_download;
         unsigned long long total_size_to_download = 0;
         const auto features = j["features"];
         for (const auto &feat : features) {
@@ -569,7 +598,17 @@ int main(int argc, char *argv[]) {
                     std::string(endpoint).append("/").append(name));
                 if (proj_is_download_needed(ctx, resource_url.c_str(), false)) {
                     total_size_to_download += file_size;
-                    to_download.push_back(resource_url);
+                    FileToDownload fileToDownload;
+                    fileToDownload.name = name;
+                    fileToDownload.url = resource_url;
+                    if (properties.contains("sha256sum")) {
+                        const auto j_sha256sum = properties["sha256sum"];
+                        if (j_sha256sum.is_string()) {
+                            fileToDownload.sha256sum =
+                                j_sha256sum.get<std::string>();
+                        }
+                    }
+                    to_download.push_back(std::move(fileToDownload));
                 } else {
                     if (!quiet) {
                         std::cout << resource_url << " already downloaded."
@@ -588,23 +627,77 @@ int main(int argc, char *argv[]) {
                 std::cout << "Total to download: " << total_size_to_download
                           << " bytes" << std::endl;
         }
-        for (size_t i = 0; i < to_download.size(); ++i) {
-            const auto &url = to_download[i];
-            if (!quiet) {
-                if (dryRun) {
-                    std::cout << "Would download ";
+
+        // Files are dispatched to the workers in order. Each worker uses
+        // its own context, as a context cannot be used by several threads.
+        std::atomic<size_t> nextIdx(0);
+        std::atomic<bool> failed(false);
+        std::mutex outputMutex;
+        const auto worker = [&](PJ_CONTEXT *workerCtx) {
+            while (!failed) {
+                const size_t i = nextIdx++;
+                if (i >= to_download.size())
+                    break;
+                const auto &url = to_download[i].url;
+                // Only GeoTIFF grids can be subset. Other files are small.
+                const auto &name = to_download[i].name;
+                const bool extractSubset =
+                    subset && name.size() > 4 &&
+                    name.compare(name.size() - 4, 4, ".tif") == 0;
+                if (!quiet) {
+                    std::lock_guard<std::mutex> lock(outputMutex);
+                    if (dryRun) {
+                        std::cout << "Would download ";
+                    } else {
+                        std::cout << "Downloading ";
+                    }
+                    if (extractSubset) {
+                        std::cout << "subset of ";
+                    }
+                    std::cout << url << "... (" << i + 1 << " / "
+                              << to_download.size() << ")" << std::endl;
+                }
+                if (dryRun)
+                    continue;
+                bool ok;
+                if (extractSubset) {
+                    const std::string outputFilename(
+                        std::string(targetDir).append("/").append(name));
+                    ok = proj_grid_extract_subset(
+                             workerCtx, url.c_str(), queried_west,
+                             queried_south, queried_east, queried_north,
+                             outputFilename.c_str()) != 0;
                 } else {
-                    std::cout << "Downloading ";
+                    ok = pj_download_file(workerCtx, url.c_str(), false,
+                                          resume, to_download[i].sha256sum,
+                                          nullptr, nullptr);
                 }
-                std::cout << url << "... (" << i + 1 << " / "
-                          << to_download.size() << ")" << std::endl;
+                if (!ok) {
+                    std::lock_guard<std::mutex> lock(outputMutex);
+                    std::cerr << "Cannot download " << url << std::endl;
+                    failed = true;
+                }
+            }
+        };
+        if (jobs == 1 || dryRun || to_download.size() <= 1) {
+            worker(ctx);
+        } else {
+            std::vector<std::thread> threads;
+            std::vector<PJ_CONTEXT *> contexts;
+            const size_t nThreads =
+                std::min(static_cast<size_t>(jobs), to_download.size());
+            for (size_t i = 0; i < nThreads; ++i) {
+                contexts.push_back(proj_context_clone(ctx));
+                threads.emplace_back(worker, contexts.back());
             }
-            if (!dryRun && !proj_download_file(ctx, url.c_str(), false, nullptr,
-                                               nullptr)) {
-                std::cerr << "Cannot download " << url << std::endl;
-                std::exit(1);
+            for (size_t i = 0; i < nThreads; ++i) {
+                threads[i].join();
+                proj_context_destroy(contexts[i]);
             }
         }
+        if (failed) {
+            std::exit(1);
+        }
 
         if (!queriedSourceId.empty() && !foundMatchSourceIdCriterion) {
             std::cerr << "Warning: '" << queriedSourceId
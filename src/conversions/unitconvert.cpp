@@ -105,31 +105,28 @@ static int days_in_year(long year) {
     return is_leap_year(year) ? 366 : 365;
 }
 
+/* Number of days before the first day of each month, in common and leap years
+ */
+static const unsigned int days_before_month[2][13] = {
+    {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334, 365},
+    {0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335, 366}};
+
 /***********************************************************************/
 static unsigned int days_in_month(unsigned long year, unsigned long month) {
     /***********************************************************************/
-    const unsigned int month_table[] = {31, 28, 31, 30, 31, 30,
-                                        31, 31, 30, 31, 30, 31};
-    unsigned int days;
-
     if (month > 12)
         month = 12;
     if (month == 0)
         month = 1;
 
-    days = month_table[month - 1];
-    if (is_leap_year(year) && month == 2)
-        days++;
-
-    return days;
+    const unsigned int *table = days_before_month[is_leap_year(year)];
+    return table[month] - table[month - 1];
 }
 
 /***********************************************************************/
 static int daynumber_in_year(unsigned long year, unsigned long month,
                              unsigned long day) {
     /***********************************************************************/
-    unsigned int daynumber = 0, i;
-
     if (month > 12)
         month = 12;
     if (month == 0)
@@ -137,12 +134,35 @@ static int daynumber_in_year(unsigned long year, unsigned long month,
     if (day > days_in_month(year, month))
         day = days_in_month(year, month);
 
-    for (i = 1; i < month; i++)
-        daynumber += days_in_month(year, i);
+    return static_cast<int>(days_before_month[is_leap_year(year)][month - 1] +
+                            day);
+}
 
-    daynumber += day;
+/***********************************************************************/
+static long long days_since_1859(long long year) {
+    /***********************************************************************
+        Number of days from 1859-01-01 to the first day of year, which
+        must be at least 1859. The leap years are counted directly, rather
+        than year by year.
+    ************************************************************************/
+    const long long y = year - 1;
+    const long long leap_days =
+        (y / 4 - y / 100 + y / 400) - (1858 / 4 - 1858 / 100 + 1858 / 400);
+    return 365 * (year - 1859) + leap_days;
+}
 
-    return daynumber;
+/***********************************************************************/
+static long long year_since_1859(double days) {
+    /***********************************************************************
+        Year containing the day that is the given number of days (at least
+        0) after 1859-01-01.
+    ************************************************************************/
+    long long year = 1859 + static_cast<long long>(days / 365.2425);
+    while (year > 1859 && static_cast<double>(days_since_1859(year)) > days)
+        year--;
+    while (static_cast<double>(days_since_1859(year + 1)) <= days)
+        year++;
+    return year;
 }
 
 /***********************************************************************/
@@ -172,13 +192,12 @@ static double decimalyear_to_mjd(double decimalyear) {
     year = lround(floor(decimalyear));
     fractional_year = decimalyear - year;
     mjd = (year - 1859) * 365 + 14 + 31;
-    mjd += (double)fractional_year * (double)days_in_year(year);
 
     /* take care of leap days */
-    year--;
-    for (; year > 1858; year--)
-        if (is_leap_year(year))
-            mjd++;
+    if (year > 1859)
+        mjd += static_cast<double>(days_since_1859(year) - (year - 1859) * 365);
+
+    mjd += (double)fractional_year * (double)days_in_year(year);
 
     return mjd;
 }
@@ -190,15 +209,19 @@ static double mjd_to_decimalyear(double mjd) {
     ************************************************************************/
     double decimalyear = mjd;
     double mjd_iter = 14 + 31;
-    int year = 1859;
-
-    /* a smarter brain than mine could probably to do this more elegantly
-       - I'll just brute-force my way out of this... */
-    for (; mjd >= mjd_iter; year++) {
-        mjd_iter += days_in_year(year);
+    long year = 1858;
+
+    // Written this way to deal with NaN input. Dates before 1859 are
+    // expressed relative to 1858.
+    if (mjd >= mjd_iter) {
+        // Far beyond any meaningful date
+        if (!(mjd < 1e11))
+            return HUGE_VAL;
+        year = static_cast<long>(year_since_1859(mjd - mjd_iter));
+        mjd_iter += static_cast<double>(days_since_1859(year));
+    } else {
+        mjd_iter -= days_in_year(year);
     }
-    year--;
-    mjd_iter -= days_in_year(year);
 
     decimalyear = year + (mjd - mjd_iter) / days_in_year(year);
     return decimalyear;
@@ -239,8 +262,8 @@ static double yyyymmdd_to_mjd(double yyyymmdd) {
     long day = lround(floor(yyyymmdd - year * 10000 - month * 100));
     double mjd = daynumber_in_year(year, month, day);
 
-    for (year -= 1; year > 1858; year--)
-        mjd += days_in_year(year);
+    if (year > 1859)
+        mjd += static_cast<double>(days_since_1859(year));
 
     return mjd + 13 + 31;
 }
@@ -251,14 +274,15 @@ static double mjd_to_yyyymmdd(double mjd) {
         Date returned in YYYY-MM-DD format.
     ************************************************************************/
     unsigned int date_iter = 14 + 31;
-    unsigned int year = 1859, month = 0, day = 0;
+    unsigned int year = 1858, month = 0, day = 0;
     unsigned int date = (int)lround(mjd);
 
-    for (; date >= date_iter; year++) {
-        date_iter += days_in_year(year);
+    if (date >= date_iter) {
+        year = static_cast<unsigned int>(year_since_1859(date - date_iter));
+        date_iter += static_cast<unsigned int>(days_since_1859(year));
+    } else {
+        date_iter -= days_in_year(year);
     }
-    year--;
-    date_iter -= days_in_year(year);
 
     for (month = 1; date_iter + days_in_month(year, month) <= date; month++)
         date_iter += days_in_month(year, month);
@@ -391,6 +415,97 @@ static void reverse_4d(PJ_COORD &coo, PJ *P) {
         coo.xyzt.t = time_units[Q->t_in_id].t_out(coo.xyzt.t);
 }
 
+/***********************************************************************/
+static void convert_time_array(PJ_COORD *coo, size_t n, int first_id,
+                               int second_id) {
+    /************************************************************************
+        Convert the time of an array of coordinates to modified julian
+        date from time unit first_id, and then from modified julian date
+        to time unit second_id. As time series often have the same epoch
+        for consecutive coordinates, the conversion is done once for each
+        run of identical epochs.
+    ************************************************************************/
+    const tconvert first = first_id < 0 ? nullptr : time_units[first_id].t_in;
+    const tconvert second =
+        second_id < 0 ? nullptr : time_units[second_id].t_out;
+    if (first == nullptr && second == nullptr)
+        return;
+
+    double last_in = 0;
+    double last_out = 0;
+    bool has_last = false;
+    for (size_t i = 0; i < n; i++) {
+        if (coo[i].v[0] == HUGE_VAL)
+            continue;
+        const double t = coo[i].xyzt.t;
+        // Compare the bits, so that 0 and -0 are distinguished
+        if (!has_last || memcmp(&t, &last_in, sizeof(t)) != 0) {
+            last_in = t;
+            last_out = t;
+            if (first)
+                last_out = first(last_out);
+            if (second)
+                last_out = second(last_out);
+            has_last = true;
+        }
+        coo[i].xyzt.t = last_out;
+    }
+}
+
+/***********************************************************************/
+static void forward_4d_array(PJ_COORD *coo, size_t n, PJ *P, int *) {
+    /************************************************************************
+        forward_4d() applied to an array of coordinates
+    ************************************************************************/
+    struct pj_opaque_unitconvert *Q = (struct pj_opaque_unitconvert *)P->opaque;
+    const double xy_factor = Q->xy_factor;
+    const double z_factor = Q->z_factor;
+
+    for (size_t i = 0; i < n; i++) {
+        if (coo[i].v[0] == HUGE_VAL) {
+            coo[i] = proj_coord_error();
+            continue;
+        }
+        coo[i].xyz.x *= xy_factor;
+        coo[i].xyz.y *= xy_factor;
+        coo[i].xyz.z *= z_factor;
+    }
+
+    convert_time_array(coo, n, Q->t_in_id, Q->t_out_id);
+
+    for (size_t i = 0; i < n; i++) {
+        if (coo[i].v[0] == HUGE_VAL)
+            coo[i] = proj_coord_error();
+    }
+}
+
+/***********************************************************************/
+static void reverse_4d_array(PJ_COORD *coo, size_t n, PJ *P, int *) {
+    /************************************************************************
+        reverse_4d() applied to an array of coordinates
+    ************************************************************************/
+    struct pj_opaque_unitconvert *Q = (struct pj_opaque_unitconvert *)P->opaque;
+    const double xy_factor = Q->xy_factor;
+    const double z_factor = Q->z_factor;
+
+    for (size_t i = 0; i < n; i++) {
+        if (coo[i].v[0] == HUGE_VAL) {
+            coo[i] = proj_coord_error();
+            continue;
+        }
+        coo[i].xyz.x /= xy_factor;
+        coo[i].xyz.y /= xy_factor;
+        coo[i].xyz.z /= z_factor;
+    }
+
+    convert_time_array(coo, n, Q->t_out_id, Q->t_in_id);
+
+    for (size_t i = 0; i < n; i++) {
+        if (coo[i].v[0] == HUGE_VAL)
+            coo[i] = proj_coord_error();
+    }
+}
+
 /***********************************************************************/
 static double get_unit_conversion_factor(const char *name, int *p_is_linear,
                                          const char **p_normalized_name) {
@@ -454,6 +569,8 @@ PJ *PJ_CONVERSION(unitconvert, 0) {
 
     P->fwd4d = forward_4d;
     P->inv4d = reverse_4d;
+    P->fwd4d_array = forward_4d_array;
+    P->inv4d_array = reverse_4d_array;
     P->fwd3d = forward_3d;
     P->inv3d = reverse_3d;
     P->fwd = forward_2d;
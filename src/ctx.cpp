@@ -173,6 +173,7 @@ pj_ctx::pj_ctx(const pj_ctx &other)
       iniFileLoaded(other.iniFileLoaded), endpoint(other.endpoint),
       networking(other.networking), ca_bundle_path(other.ca_bundle_path),
       gridChunkCache(other.gridChunkCache),
+      gridAvailabilityCacheTTL(other.gridAvailabilityCacheTTL),
       defaultTmercAlgo(other.defaultTmercAlgo),
       // END ini file settings
       projStringParserCreateFromPROJStringRecursionCounter(0),
@@ -197,6 +198,7 @@ PJ_CONTEXT *pj_get_default_ctx()
 /************************************************************************/
 
 pj_ctx::~pj_ctx() {
+    proj_destroy(validatedPJ);
     delete[] c_compat_paths;
     proj_context_delete_cpp_context(cpp_context);
 }
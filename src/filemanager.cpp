@@ -65,6 +65,8 @@
 #ifdef HAVE_LIBDL
 #include <dlfcn.h>
 #endif
+#include <fcntl.h>
+#include <sys/file.h>
 #include <sys/types.h>
 #include <unistd.h>
 #endif
@@ -85,6 +87,10 @@ File::~File() = default;
 
 // ---------------------------------------------------------------------------
 
+FileLock::~FileLock() = default;
+
+// ---------------------------------------------------------------------------
+
 std::string File::read_line(size_t maxLen, bool &maxLenReached,
                             bool &eofReached) {
     constexpr size_t MAX_MAXLEN = 1024 * 1024;
@@ -1002,6 +1008,107 @@ bool FileManager::rename(PJ_CONTEXT *ctx, const char *oldPath,
 
 // ---------------------------------------------------------------------------
 
+#ifdef _WIN32
+
+// The lock is the handle itself, opened without sharing: other attempts to
+// open the file fail until it is closed, which also removes the file.
+class FileLockWin32 : public FileLock {
+    HANDLE m_handle;
+
+    FileLockWin32(const FileLockWin32 &) = delete;
+    FileLockWin32 &operator=(const FileLockWin32 &) = delete;
+
+  public:
+    explicit FileLockWin32(HANDLE handle) : m_handle(handle) {}
+    ~FileLockWin32() override { CloseHandle(m_handle); }
+};
+
+#else
+
+// flock() locks are attached to the open file description, so they are not
+// released when other descriptors of the same file are closed, and they
+// exclude other threads of the same process.
+class FileLockPosix : public FileLock {
+    std::string m_filename;
+    int m_fd;
+
+    FileLockPosix(const FileLockPosix &) = delete;
+    FileLockPosix &operator=(const FileLockPosix &) = delete;
+
+  public:
+    FileLockPosix(const std::string &filename, int fd)
+        : m_filename(filename), m_fd(fd) {}
+    ~FileLockPosix() override {
+        // Removed while still locked, so that nobody can lock the old file
+        ::unlink(m_filename.c_str());
+        ::close(m_fd);
+    }
+};
+
+#endif
+
+// ---------------------------------------------------------------------------
+
+std::unique_ptr<FileLock> FileManager::lock(PJ_CONTEXT *ctx,
+                                            const char *filename) {
+    if (ctx->fileApi.open_cbk != nullptr) {
+        return nullptr;
+    }
+
+#ifdef _WIN32
+    try {
+#if UWP
+        CREATEFILE2_EXTENDED_PARAMETERS extendedParameters;
+        ZeroMemory(&extendedParameters, sizeof(extendedParameters));
+        extendedParameters.dwSize = sizeof(extendedParameters);
+        extendedParameters.dwFileAttributes = FILE_ATTRIBUTE_NORMAL;
+        extendedParameters.dwFileFlags = FILE_FLAG_DELETE_ON_CLOSE;
+        HANDLE hFile = CreateFile2(UTF8ToWString(std::string(filename)).c_str(),
+                                   GENERIC_READ | GENERIC_WRITE, 0, OPEN_ALWAYS,
+                                   &extendedParameters);
+#else  // UWP
+        HANDLE hFile = CreateFileW(
+            UTF8ToWString(std::string(filename)).c_str(),
+            GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_ALWAYS,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+#endif // UWP
+        return std::unique_ptr<FileLock>(
+            hFile != INVALID_HANDLE_VALUE ? new FileLockWin32(hFile) : nullptr);
+    } catch (const std::exception &e) {
+        pj_log(ctx, PJ_LOG_DEBUG, "%s", e.what());
+        return nullptr;
+    }
+#else
+    while (true) {
+        int flags = O_RDWR | O_CREAT;
+#ifdef O_CLOEXEC
+        flags |= O_CLOEXEC;
+#endif
+        const int fd = ::open(filename, flags, 0644);
+        if (fd < 0) {
+            pj_log(ctx, PJ_LOG_DEBUG, "Cannot create %s", filename);
+            return nullptr;
+        }
+        if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+            ::close(fd);
+            return nullptr;
+        }
+        // The previous owner of the lock may have removed the file between
+        // our open() and flock(): retry with the current one in that case.
+        struct stat sStatFd;
+        struct stat sStatFile;
+        if (fstat(fd, &sStatFd) == 0 && stat(filename, &sStatFile) == 0 &&
+            sStatFd.st_dev == sStatFile.st_dev &&
+            sStatFd.st_ino == sStatFile.st_ino) {
+            return std::unique_ptr<FileLock>(new FileLockPosix(filename, fd));
+        }
+        ::close(fd);
+    }
+#endif
+}
+
+// ---------------------------------------------------------------------------
+
 std::string FileManager::getProjDataEnvVar(PJ_CONTEXT *ctx) {
     if (!ctx->env_var_proj_data.empty()) {
         return ctx->env_var_proj_data;
@@ -1849,6 +1956,15 @@ void pj_load_ini(PJ_CONTEXT *ctx) {
             ci_equal(proj_only_best_default, "TRUE");
     }
 
+    const char *grid_availability_cache_ttl =
+        getenv("PROJ_GRID_AVAILABILITY_CACHE_TTL_SEC");
+    if (grid_availability_cache_ttl &&
+        grid_availability_cache_ttl[0] != '\0') {
+        ctx->gridAvailabilityCacheTTL = atoi(grid_availability_cache_ttl);
+    } else {
+        grid_availability_cache_ttl = nullptr;
+    }
+
     ctx->iniFileLoaded = true;
     auto file = std::unique_ptr<NS_PROJ::File>(
         reinterpret_cast<NS_PROJ::File *>(pj_open_lib_internal(
@@ -1894,6 +2010,9 @@ void pj_load_ini(PJ_CONTEXT *ctx) {
                     val > 0 ? static_cast<long long>(val) * 1024 * 1024 : -1;
             } else if (key == "cache_ttl_sec") {
                 ctx->gridChunkCache.ttl = atoi(value.c_str());
+            } else if (grid_availability_cache_ttl == nullptr &&
+                       key == "grid_availability_cache_ttl_sec") {
+                ctx->gridAvailabilityCacheTTL = atoi(value.c_str());
             } else if (key == "tmerc_default_algo") {
                 if (value == "auto") {
                     ctx->defaultTmercAlgo = TMercAlgo::AUTO;
@@ -40,6 +40,7 @@
 NS_PROJ_START
 
 class File;
+class FileLock;
 
 enum class FileAccess {
     READ_ONLY,   // "rb"
@@ -61,6 +62,11 @@ class FileManager {
     static bool rename(PJ_CONTEXT *ctx, const char *oldPath,
                        const char *newPath);
     static std::string getProjDataEnvVar(PJ_CONTEXT *ctx);
+    // Exclusive lock on a file of the local file system, created if needed.
+    // Returns nullptr if it is already locked, including by another thread
+    // of the same process, or if a custom file API is used.
+    static PROJ_DLL std::unique_ptr<FileLock> lock(PJ_CONTEXT *ctx,
+                                                   const char *filename);
 
     // "High-level" interface, honoring PROJ_DATA and the like.
     static std::unique_ptr<File>
@@ -98,6 +104,18 @@ class File {
 
 // ---------------------------------------------------------------------------
 
+// Lock returned by FileManager::lock(). The locked file is removed when it is
+// released.
+class FileLock {
+  protected:
+    FileLock() = default;
+
+  public:
+    virtual PROJ_DLL ~FileLock();
+};
+
+// ---------------------------------------------------------------------------
+
 std::unique_ptr<File> pj_network_file_open(PJ_CONTEXT *ctx,
                                            const char *filename);
 NS_PROJ_END
@@ -105,6 +123,14 @@ NS_PROJ_END
 // Exported for projsync
 std::vector<std::string> PROJ_DLL pj_get_default_searchpaths(PJ_CONTEXT *ctx);
 
+// Exported for projsync
+bool PROJ_DLL pj_download_file(PJ_CONTEXT *ctx, const char *url_or_filename,
+                               bool ignore_ttl_setting, bool resume,
+                               const std::string &expected_sha256sum,
+                               int (*progress_cbk)(PJ_CONTEXT *, double pct,
+                                                   void *user_data),
+                               void *user_data);
+
 //! @endcond Doxygen_Suppress
 
 #endif // FILEMANAGER_HPP_INCLUDED
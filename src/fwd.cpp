@@ -294,3 +294,46 @@ bool pj_fwd4d(PJ_COORD &coo, PJ *P) {
     P->ctx->last_errno = last_errno;
     return true;
 }
+
+/* pj_fwd4d() for operations that skip the prepare and finalize steps and */
+/* have a 4D forward method: pipelines, axisswap, unitconvert... */
+static void fwd4d_direct(PJ_COORD &coo, PJ *P) {
+    const int last_errno = P->ctx->last_errno;
+    P->ctx->last_errno = 0;
+
+    if (HUGE_VAL != coo.v[0])
+        P->fwd4d(coo, P);
+    if (HUGE_VAL == coo.v[0] || P->ctx->last_errno) {
+        coo = proj_coord_error();
+        return;
+    }
+
+    P->ctx->last_errno = last_errno;
+}
+
+static void fwd4d_generic(PJ_COORD &coo, PJ *P) { pj_fwd4d(coo, P); }
+
+/* Select the function applying P in the forward direction. Must be called */
+/* once the operation is set up. */
+PJ_OPERATOR pj_fwd4d_function(const PJ *P) {
+    if (P->skip_fwd_prepare && P->skip_fwd_finalize && P->fwd4d)
+        return fwd4d_direct;
+    return fwd4d_generic;
+}
+
+/* Select the batch function applying P in the forward direction, or nullptr. */
+/* The batch method of an operation stands for pj_fwd4d() as a whole, */
+/* including the check of the input coordinates for HUGE_VAL, so it is only */
+/* used when the prepare and finalize steps have nothing else to do. */
+PJ_ARRAY_OPERATOR pj_fwd4d_array_function(const PJ *P) {
+    if (!P->fwd4d_array)
+        return nullptr;
+    if (!P->skip_fwd_prepare && P->left != PJ_IO_UNITS_WHATEVER)
+        return nullptr;
+    if (!P->skip_fwd_finalize &&
+        ((P->right != PJ_IO_UNITS_WHATEVER &&
+          P->right != PJ_IO_UNITS_DEGREES) ||
+         P->axisswap))
+        return nullptr;
+    return P->fwd4d_array;
+}
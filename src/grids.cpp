@@ -494,6 +494,10 @@ class GTiffGrid : public Grid {
 
     uint32_t subfileType() const { return m_subfileType; }
 
+    toff_t dirOffset() const { return m_dirOffset; }
+
+    bool bottomUp() const { return m_bottomUp; }
+
     void reassign_context(PJ_CONTEXT *ctx) { m_ctx = ctx; }
 
     bool hasChanged() const override { return m_fp->hasChanged(); }
@@ -1005,6 +1009,9 @@ class GTiffDataset {
 
     std::unique_ptr<GTiffGrid> nextGrid();
 
+    // cppcheck-suppress functionStatic
+    TIFF *tiffHandle() const { return m_hTIFF; }
+
     void reassign_context(PJ_CONTEXT *ctx) {
         m_ctx = ctx;
         m_fp->reassign_context(ctx);
@@ -1324,6 +1331,250 @@ std::unique_ptr<GTiffGrid> GTiffDataset::nextGrid() {
 
 // ---------------------------------------------------------------------------
 
+// Writes a GeoTIFF file made of rectangular windows of the grids of another
+// one. Windows are aligned on the blocks (tiles or strips) of the source
+// grids, so that blocks are copied without being decoded and re-encoded.
+class GTiffSubsetWriter {
+    PJ_CONTEXT *m_ctx;
+    std::unique_ptr<File> m_fp;
+    TIFF *m_hTIFF = nullptr;
+
+    GTiffSubsetWriter(const GTiffSubsetWriter &) = delete;
+    GTiffSubsetWriter &operator=(const GTiffSubsetWriter &) = delete;
+
+    // libtiff I/O routines
+    static tsize_t tiffReadProc(thandle_t fd, tdata_t buf, tsize_t size) {
+        GTiffSubsetWriter *self = static_cast<GTiffSubsetWriter *>(fd);
+        return self->m_fp->read(buf, size);
+    }
+
+    static tsize_t tiffWriteProc(thandle_t fd, tdata_t buf, tsize_t size) {
+        GTiffSubsetWriter *self = static_cast<GTiffSubsetWriter *>(fd);
+        return self->m_fp->write(buf, size);
+    }
+
+    static toff_t tiffSeekProc(thandle_t fd, toff_t off, int whence) {
+        GTiffSubsetWriter *self = static_cast<GTiffSubsetWriter *>(fd);
+        if (self->m_fp->seek(off, whence))
+            return static_cast<toff_t>(self->m_fp->tell());
+        else
+            return static_cast<toff_t>(-1);
+    }
+
+    static int tiffCloseProc(thandle_t) {
+        // done in destructor
+        return 0;
+    }
+
+    static toff_t tiffSizeProc(thandle_t fd) {
+        GTiffSubsetWriter *self = static_cast<GTiffSubsetWriter *>(fd);
+        const auto old_off = self->m_fp->tell();
+        self->m_fp->seek(0, SEEK_END);
+        const auto file_size = static_cast<toff_t>(self->m_fp->tell());
+        self->m_fp->seek(old_off);
+        return file_size;
+    }
+
+    static int tiffMapProc(thandle_t, tdata_t *, toff_t *) { return (0); }
+
+    static void tiffUnmapProc(thandle_t, tdata_t, toff_t) {}
+
+  public:
+    GTiffSubsetWriter(PJ_CONTEXT *ctx, std::unique_ptr<File> &&fp)
+        : m_ctx(ctx), m_fp(std::move(fp)) {}
+
+    ~GTiffSubsetWriter() {
+        if (m_hTIFF)
+            TIFFClose(m_hTIFF);
+    }
+
+    bool open(const std::string &filename, bool bigEndian) {
+        m_hTIFF = TIFFClientOpen(
+            filename.c_str(), bigEndian ? "wb" : "wl",
+            static_cast<thandle_t>(this), tiffReadProc, tiffWriteProc,
+            tiffSeekProc, tiffCloseProc, tiffSizeProc, tiffMapProc,
+            tiffUnmapProc);
+        return m_hTIFF != nullptr;
+    }
+
+    bool copyWindow(TIFF *hSrc, const GTiffGrid &grid, int xMin, int yMin,
+                    int xMax, int yMax);
+
+    bool close() {
+        const bool ret = TIFFFlush(m_hTIFF) != 0;
+        TIFFClose(m_hTIFF);
+        m_hTIFF = nullptr;
+        return ret;
+    }
+};
+
+// ---------------------------------------------------------------------------
+
+template <class T>
+static void copyTIFFTag(TIFF *hSrc, TIFF *hDst, ttag_t tag) {
+    T value{};
+    if (TIFFGetField(hSrc, tag, &value)) {
+        TIFFSetField(hDst, tag, value);
+    }
+}
+
+template <class T>
+static void copyTIFFArrayTag(TIFF *hSrc, TIFF *hDst, ttag_t tag) {
+    uint16_t count = 0;
+    T *values = nullptr;
+    if (TIFFGetField(hSrc, tag, &count, &values)) {
+        TIFFSetField(hDst, tag, count, values);
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+// Copy the blocks of the current directory of hSrc intersecting the window
+// [xMin,xMax]x[yMin,yMax] (in TIFF pixel space, inclusive) as a new
+// directory.
+bool GTiffSubsetWriter::copyWindow(TIFF *hSrc, const GTiffGrid &grid, int xMin,
+                                   int yMin, int xMax, int yMax) {
+    if (TIFFCurrentDirOffset(hSrc) != grid.dirOffset() &&
+        !TIFFSetSubDirectory(hSrc, grid.dirOffset())) {
+        return false;
+    }
+
+    const bool tiled = TIFFIsTiled(hSrc) != 0;
+    const uint32_t width = static_cast<uint32_t>(grid.width());
+    const uint32_t height = static_cast<uint32_t>(grid.height());
+    uint32_t blockWidth = width;
+    uint32_t blockHeight = height;
+    if (tiled) {
+        TIFFGetField(hSrc, TIFFTAG_TILEWIDTH, &blockWidth);
+        TIFFGetField(hSrc, TIFFTAG_TILELENGTH, &blockHeight);
+    } else {
+        TIFFGetField(hSrc, TIFFTAG_ROWSPERSTRIP, &blockHeight);
+        if (blockHeight > height)
+            blockHeight = height;
+    }
+    if (blockWidth == 0 || blockHeight == 0)
+        return false;
+
+    // Extend the window to block boundaries
+    const uint32_t xBlockOff = static_cast<uint32_t>(xMin) / blockWidth;
+    const uint32_t yBlockOff = static_cast<uint32_t>(yMin) / blockHeight;
+    const uint32_t dstBlocksPerRow =
+        static_cast<uint32_t>(xMax) / blockWidth - xBlockOff + 1;
+    const uint32_t dstBlocksPerCol =
+        static_cast<uint32_t>(yMax) / blockHeight - yBlockOff + 1;
+    const uint32_t xOff = xBlockOff * blockWidth;
+    const uint32_t yOff = yBlockOff * blockHeight;
+    const uint32_t dstWidth =
+        std::min(width - xOff, dstBlocksPerRow * blockWidth);
+    const uint32_t dstHeight =
+        std::min(height - yOff, dstBlocksPerCol * blockHeight);
+
+    uint16_t samplesPerPixel = 1;
+    uint16_t planarConfig = PLANARCONFIG_CONTIG;
+    uint16_t compression = COMPRESSION_NONE;
+    TIFFGetField(hSrc, TIFFTAG_SAMPLESPERPIXEL, &samplesPerPixel);
+    TIFFGetField(hSrc, TIFFTAG_PLANARCONFIG, &planarConfig);
+    TIFFGetField(hSrc, TIFFTAG_COMPRESSION, &compression);
+
+    TIFFSetField(m_hTIFF, TIFFTAG_IMAGEWIDTH, dstWidth);
+    TIFFSetField(m_hTIFF, TIFFTAG_IMAGELENGTH, dstHeight);
+    TIFFSetField(m_hTIFF, TIFFTAG_SAMPLESPERPIXEL, samplesPerPixel);
+    TIFFSetField(m_hTIFF, TIFFTAG_PLANARCONFIG, planarConfig);
+    TIFFSetField(m_hTIFF, TIFFTAG_COMPRESSION, compression);
+    if (tiled) {
+        TIFFSetField(m_hTIFF, TIFFTAG_TILEWIDTH, blockWidth);
+        TIFFSetField(m_hTIFF, TIFFTAG_TILELENGTH, blockHeight);
+    } else {
+        TIFFSetField(m_hTIFF, TIFFTAG_ROWSPERSTRIP, blockHeight);
+    }
+    if (compression != COMPRESSION_NONE) {
+        copyTIFFTag<uint16_t>(hSrc, m_hTIFF, TIFFTAG_PREDICTOR);
+    }
+    copyTIFFTag<uint16_t>(hSrc, m_hTIFF, TIFFTAG_BITSPERSAMPLE);
+    copyTIFFTag<uint16_t>(hSrc, m_hTIFF, TIFFTAG_SAMPLEFORMAT);
+    copyTIFFTag<uint16_t>(hSrc, m_hTIFF, TIFFTAG_PHOTOMETRIC);
+    copyTIFFTag<uint32_t>(hSrc, m_hTIFF, TIFFTAG_SUBFILETYPE);
+    copyTIFFArrayTag<uint16_t>(hSrc, m_hTIFF, TIFFTAG_EXTRASAMPLES);
+    copyTIFFTag<char *>(hSrc, m_hTIFF, TIFFTAG_IMAGEDESCRIPTION);
+    copyTIFFTag<char *>(hSrc, m_hTIFF, TIFFTAG_COPYRIGHT);
+    copyTIFFTag<char *>(hSrc, m_hTIFF, TIFFTAG_DATETIME);
+    copyTIFFTag<char *>(hSrc, m_hTIFF, TIFFTAG_SOFTWARE);
+    copyTIFFTag<char *>(hSrc, m_hTIFF, TIFFTAG_GDAL_METADATA);
+    copyTIFFTag<char *>(hSrc, m_hTIFF, TIFFTAG_GDAL_NODATA);
+
+    // Georeferencing, shifted by the offset of the window
+    copyTIFFArrayTag<uint16_t>(hSrc, m_hTIFF, TIFFTAG_GEOKEYDIRECTORY);
+    copyTIFFArrayTag<double>(hSrc, m_hTIFF, TIFFTAG_GEODOUBLEPARAMS);
+    copyTIFFTag<char *>(hSrc, m_hTIFF, TIFFTAG_GEOASCIIPARAMS);
+    uint16_t count = 0;
+    double *values = nullptr;
+    if (TIFFGetField(hSrc, TIFFTAG_GEOTRANSMATRIX, &count, &values) &&
+        count == 16) {
+        std::vector<double> matrix(values, values + count);
+        matrix[3] += matrix[0] * xOff + matrix[1] * yOff;
+        matrix[7] += matrix[4] * xOff + matrix[5] * yOff;
+        TIFFSetField(m_hTIFF, TIFFTAG_GEOTRANSMATRIX, count, matrix.data());
+    } else {
+        copyTIFFArrayTag<double>(hSrc, m_hTIFF, TIFFTAG_GEOPIXELSCALE);
+        if (TIFFGetField(hSrc, TIFFTAG_GEOTIEPOINTS, &count, &values) &&
+            count == 6) {
+            std::vector<double> tiepoints(values, values + count);
+            tiepoints[0] -= xOff;
+            tiepoints[1] -= yOff;
+            TIFFSetField(m_hTIFF, TIFFTAG_GEOTIEPOINTS, count,
+                         tiepoints.data());
+        }
+    }
+
+    uint64_t *byteCounts = nullptr;
+    if (!TIFFGetField(hSrc,
+                      tiled ? TIFFTAG_TILEBYTECOUNTS : TIFFTAG_STRIPBYTECOUNTS,
+                      &byteCounts)) {
+        return false;
+    }
+    const uint32_t srcBlocksPerRow = (width + blockWidth - 1) / blockWidth;
+    const uint32_t srcBlocksPerCol = (height + blockHeight - 1) / blockHeight;
+    const uint32_t planes =
+        planarConfig == PLANARCONFIG_SEPARATE ? samplesPerPixel : 1;
+    std::vector<unsigned char> buffer;
+    for (uint32_t plane = 0; plane < planes; ++plane) {
+        for (uint32_t y = 0; y < dstBlocksPerCol; ++y) {
+            for (uint32_t x = 0; x < dstBlocksPerRow; ++x) {
+                const uint32_t srcBlock =
+                    (plane * srcBlocksPerCol + y + yBlockOff) *
+                        srcBlocksPerRow +
+                    x + xBlockOff;
+                const uint32_t dstBlock =
+                    (plane * dstBlocksPerCol + y) * dstBlocksPerRow + x;
+                const auto size = static_cast<tmsize_t>(byteCounts[srcBlock]);
+                if (size == 0) {
+                    continue;
+                }
+                buffer.resize(static_cast<size_t>(size));
+                if (tiled) {
+                    if (TIFFReadRawTile(hSrc, srcBlock, buffer.data(), size) !=
+                            size ||
+                        TIFFWriteRawTile(m_hTIFF, dstBlock, buffer.data(),
+                                         size) != size) {
+                        return false;
+                    }
+                } else {
+                    if (TIFFReadRawStrip(hSrc, srcBlock, buffer.data(),
+                                         size) != size ||
+                        TIFFWriteRawStrip(m_hTIFF, dstBlock, buffer.data(),
+                                          size) != size) {
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+
+    return TIFFWriteDirectory(m_hTIFF) != 0;
+}
+
+// ---------------------------------------------------------------------------
+
 class GTiffVGridShiftSet : public VerticalShiftGridSet {
 
     std::unique_ptr<GTiffDataset> m_GTiffDataset;
@@ -3911,4 +4162,271 @@ bool pj_bilinear_interpolation_three_samples(
     return true;
 }
 
+// ---------------------------------------------------------------------------
+
+GridCoverageMask::GridCoverageMask() = default;
+
+// ---------------------------------------------------------------------------
+
+GridCoverageMask::~GridCoverageMask() = default;
+
+// ---------------------------------------------------------------------------
+
+bool GridCoverageMask::addGrids(PJ_CONTEXT *ctx, const std::string &gridNames,
+                                bool verticalGrids) {
+    // Maximum dimension of the bitmap of a layer.
+    constexpr int MAX_SIZE = 256;
+    // The extent of each grid is dilated by at least that amount (0.1 deg),
+    // which is larger than the difference between the coordinates of the
+    // point passed to mayContain() and the ones at which the grid is
+    // actually sampled, for the grid based transformations between
+    // geographic CRS.
+    static constexpr double MARGIN = 0.1 / 180 * M_PI;
+
+    std::vector<ExtentAndRes> extents;
+    for (const auto &gridName : split(gridNames, ',')) {
+        if (gridName.empty() || gridName[0] == '@') {
+            // The grid is optional: the transformation may succeed outside
+            // of it.
+            return false;
+        }
+        const auto addExtent = [&extents](const Grid &grid) {
+            auto extent = grid.extentAndRes();
+            const double margin = std::max(
+                MARGIN, 2 * std::max(std::fabs(extent.resX),
+                                     std::fabs(extent.resY)));
+            extent.west -= margin;
+            extent.south -= margin;
+            extent.east += margin;
+            extent.north += margin;
+            extents.push_back(extent);
+        };
+        if (verticalGrids) {
+            auto gridSet = VerticalShiftGridSet::open(ctx, gridName);
+            if (!gridSet)
+                return false;
+            for (const auto &grid : gridSet->grids()) {
+                if (grid->isNullGrid() || !grid->extentAndRes().isGeographic)
+                    return false;
+                addExtent(*grid);
+            }
+        } else {
+            auto gridSet = HorizontalShiftGridSet::open(ctx, gridName);
+            if (!gridSet)
+                return false;
+            for (const auto &grid : gridSet->grids()) {
+                if (grid->isNullGrid() || !grid->extentAndRes().isGeographic)
+                    return false;
+                addExtent(*grid);
+            }
+        }
+    }
+    if (extents.empty())
+        return false;
+
+    Layer layer;
+    layer.west = extents[0].west;
+    layer.south = extents[0].south;
+    layer.east = extents[0].east;
+    layer.north = extents[0].north;
+    for (const auto &extent : extents) {
+        layer.west = std::min(layer.west, extent.west);
+        layer.south = std::min(layer.south, extent.south);
+        layer.east = std::max(layer.east, extent.east);
+        layer.north = std::max(layer.north, extent.north);
+    }
+    layer.resX = std::max(MARGIN, (layer.east - layer.west) / MAX_SIZE);
+    layer.resY = std::max(MARGIN, (layer.north - layer.south) / MAX_SIZE);
+    layer.width = std::min(
+        MAX_SIZE,
+        static_cast<int>(std::ceil((layer.east - layer.west) / layer.resX)));
+    layer.height = std::min(
+        MAX_SIZE,
+        static_cast<int>(std::ceil((layer.north - layer.south) / layer.resY)));
+    layer.width = std::max(1, layer.width);
+    layer.height = std::max(1, layer.height);
+    layer.bits.resize(static_cast<size_t>(layer.width) * layer.height);
+
+    // Mark all the cells that intersect the (dilated) extent of a grid
+    const auto clampX = [&layer](double x) {
+        return std::max(0, std::min(layer.width - 1, static_cast<int>(x)));
+    };
+    const auto clampY = [&layer](double y) {
+        return std::max(0, std::min(layer.height - 1, static_cast<int>(y)));
+    };
+    for (const auto &extent : extents) {
+        const int x0 = clampX((extent.west - layer.west) / layer.resX);
+        const int x1 = clampX((extent.east - layer.west) / layer.resX);
+        const int y0 = clampY((extent.south - layer.south) / layer.resY);
+        const int y1 = clampY((extent.north - layer.south) / layer.resY);
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) {
+                layer.bits[static_cast<size_t>(y) * layer.width + x] = true;
+            }
+        }
+    }
+
+    m_layers.emplace_back(std::move(layer));
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+
+bool GridCoverageMask::Layer::mayContain(double longitude, double lat) const {
+    if (!(lat >= south && lat <= north))
+        return false;
+    const double candidateLongitudes[] = {longitude, longitude + 2 * M_PI,
+                                          longitude - 2 * M_PI};
+    for (double x : candidateLongitudes) {
+        if (x >= west && x <= east) {
+            const int ix =
+                std::min(width - 1, static_cast<int>((x - west) / resX));
+            const int iy =
+                std::min(height - 1, static_cast<int>((lat - south) / resY));
+            if (bits[static_cast<size_t>(iy) * width + ix])
+                return true;
+        }
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------------------
+
+bool GridCoverageMask::mayContain(double longitude, double lat) const {
+    for (const auto &layer : m_layers) {
+        if (!layer.mayContain(longitude, lat))
+            return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+
+bool pj_grid_extract_subset(PJ_CONTEXT *ctx, const char *gridname,
+                            double west, double south, double east,
+                            double north, const std::string &outputFilename) {
+#ifdef TIFF_ENABLED
+    auto fp = FileManager::open_resource_file(ctx, gridname);
+    if (!fp) {
+        return false;
+    }
+    const std::string actualName(fp->name());
+    unsigned char header[4];
+    if (fp->read(header, sizeof(header)) != sizeof(header) ||
+        !IsTIFF(sizeof(header), header)) {
+        pj_log(ctx, PJ_LOG_ERROR, _("%s is not a GeoTIFF grid"), gridname);
+        return false;
+    }
+    fp->seek(0);
+    GTiffDataset dataset(ctx, std::move(fp));
+    if (!dataset.openTIFF(actualName)) {
+        return false;
+    }
+    TIFF *hSrc = dataset.tiffHandle();
+
+    auto fpOut = FileManager::open(ctx, outputFilename.c_str(),
+                                   FileAccess::CREATE);
+    if (!fpOut) {
+        pj_log(ctx, PJ_LOG_ERROR, _("Cannot create %s"),
+               outputFilename.c_str());
+        return false;
+    }
+    GTiffSubsetWriter writer(ctx, std::move(fpOut));
+    if (!writer.open(outputFilename, TIFFIsBigEndian(hSrc) != 0)) {
+        return false;
+    }
+
+    if (east < west) {
+        east += 360;
+    }
+    int copiedGrids = 0;
+    while (true) {
+        auto grid = dataset.nextGrid();
+        if (!grid) {
+            break;
+        }
+        // Overviews are never read by PROJ
+        const auto subfileType = grid->subfileType();
+        if (subfileType != 0 && subfileType != FILETYPE_PAGE) {
+            continue;
+        }
+        const auto &extent = grid->extentAndRes();
+        const double mulFactor = extent.isGeographic ? DEG_TO_RAD : 1;
+        double w = west * mulFactor;
+        double e = east * mulFactor;
+        const double s = south * mulFactor;
+        const double n = north * mulFactor;
+        if (extent.isGeographic) {
+            if (e - w >= 2 * M_PI) {
+                w = extent.west;
+                e = extent.east;
+            } else {
+                // Deal with the longitude convention of the grid
+                for (const double shift : {0.0, 2 * M_PI, -2 * M_PI}) {
+                    if (w + shift <= extent.east && e + shift >= extent.west) {
+                        w += shift;
+                        e += shift;
+                        break;
+                    }
+                }
+            }
+        }
+        if (w > extent.east || e < extent.west || s > extent.north ||
+            n < extent.south) {
+            continue;
+        }
+
+        // Grid nodes needed to interpolate within the area of interest
+        const int width = grid->width();
+        const int height = grid->height();
+        const int x0 = std::max(
+            0,
+            static_cast<int>(std::floor((w - extent.west) * extent.invResX)));
+        const int x1 = std::min(
+            width - 1,
+            static_cast<int>(std::ceil((e - extent.west) * extent.invResX)));
+        const int y0 = std::max(
+            0,
+            static_cast<int>(std::floor((s - extent.south) * extent.invResY)));
+        const int y1 = std::min(
+            height - 1,
+            static_cast<int>(std::ceil((n - extent.south) * extent.invResY)));
+        if (x0 > x1 || y0 > y1) {
+            continue;
+        }
+        // Convert from south-up grid rows to TIFF rows
+        const int row0 = grid->bottomUp() ? y0 : height - 1 - y1;
+        const int row1 = grid->bottomUp() ? y1 : height - 1 - y0;
+        if (!writer.copyWindow(hSrc, *grid, x0, row0, x1, row1)) {
+            pj_log(ctx, PJ_LOG_ERROR, _("Cannot copy data of %s to %s"),
+                   gridname, outputFilename.c_str());
+            return false;
+        }
+        ++copiedGrids;
+    }
+    if (copiedGrids == 0) {
+        pj_log(ctx, PJ_LOG_ERROR,
+               _("%s does not intersect the area of interest"), gridname);
+        return false;
+    }
+    if (!writer.close()) {
+        pj_log(ctx, PJ_LOG_ERROR, _("Cannot write %s"),
+               outputFilename.c_str());
+        return false;
+    }
+    return true;
+#else
+    (void)gridname;
+    (void)west;
+    (void)south;
+    (void)east;
+    (void)north;
+    (void)outputFilename;
+    pj_log(ctx, PJ_LOG_ERROR,
+           _("Extracting a subset of a grid requires PROJ to be built with "
+             "TIFF support"));
+    return false;
+#endif
+}
+
 NS_PROJ_END
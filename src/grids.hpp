@@ -253,6 +253,47 @@ class PROJ_GCC_DLL GenericShiftGridSet {
 
 // ---------------------------------------------------------------------------
 
+// Coarse and conservative bitmap of the area covered by geographic grids.
+// A point for which mayContain() returns false is guaranteed to be outside
+// of the grids (with a safety margin), whereas true means that it might be
+// inside of them.
+class PROJ_GCC_DLL GridCoverageMask {
+  public:
+    PROJ_FOR_TEST GridCoverageMask();
+    PROJ_FOR_TEST ~GridCoverageMask();
+
+    // Add the constraint that a point must be covered by at least one of
+    // the grids of gridNames (comma separated list as found in +grids=).
+    // Returns false if one of the grids cannot be opened or is not
+    // geographic, in which case the mask must not be used.
+    PROJ_FOR_TEST bool addGrids(PJ_CONTEXT *ctx, const std::string &gridNames,
+                                bool verticalGrids);
+
+    PROJ_FOR_TEST bool empty() const { return m_layers.empty(); }
+
+    // longitude and latitude in radians
+    PROJ_FOR_TEST bool mayContain(double longitude, double lat) const;
+
+  private:
+    struct Layer {
+        double west = 0;
+        double south = 0;
+        double east = 0;
+        double north = 0;
+        double resX = 0;
+        double resY = 0;
+        int width = 0;
+        int height = 0;
+        std::vector<bool> bits{};
+
+        bool mayContain(double longitude, double lat) const;
+    };
+
+    std::vector<Layer> m_layers{};
+};
+
+// ---------------------------------------------------------------------------
+
 typedef std::vector<std::unique_ptr<HorizontalShiftGridSet>> ListOfHGrids;
 typedef std::vector<std::unique_ptr<VerticalShiftGridSet>> ListOfVGrids;
 typedef std::vector<std::unique_ptr<GenericShiftGridSet>> ListOfGenericGrids;
@@ -274,6 +315,10 @@ bool pj_bilinear_interpolation_three_samples(
     PJ_CONTEXT *ctx, const GenericShiftGrid *grid, const PJ_LP &lp, int idx1,
     int idx2, int idx3, double &v1, double &v2, double &v3, bool &must_retry);
 
+bool pj_grid_extract_subset(PJ_CONTEXT *ctx, const char *gridname,
+                            double west, double south, double east,
+                            double north, const std::string &outputFilename);
+
 NS_PROJ_END
 
 #endif // GRIDS_HPP_INCLUDED
@@ -316,7 +316,8 @@ static paralist *get_init(PJ_CONTEXT *ctx, const char *key,
     return init_items;
 }
 
-static void append_default_ellipsoid_to_paralist(paralist *start) {
+static void append_default_ellipsoid_to_paralist(pj_arena *arena,
+                                                 paralist *start) {
     if (nullptr == start)
         return;
 
@@ -359,7 +360,19 @@ static void append_default_ellipsoid_to_paralist(paralist *start) {
         ;
 
     /* If we're here, it's OK to append the current default item */
-    last->next = pj_mkparam("ellps=GRS80");
+    last->next = pj_mkparam_arena(arena, "ellps=GRS80");
+}
+
+/*****************************************************************************/
+static PJ *free_params_and_arena(PJ_CONTEXT *ctx, paralist *start,
+                                 pj_arena *arena, int errlev) {
+    /*****************************************************************************
+        Error exit of pj_init_ctx before the parameter list has been handed
+        over to the PJ object.
+    ******************************************************************************/
+    free_params(ctx, start, errlev);
+    pj_arena_destroy(arena);
+    return nullptr;
 }
 
 /*****************************************************************************/
@@ -437,6 +450,7 @@ PJ *pj_init_ctx_with_allow_init_epsg(PJ_CONTEXT *ctx, int argc, char **argv,
     char *name;
     PJ_CONSTRUCTOR proj;
     paralist *curr, *init, *start;
+    pj_arena *arena;
     int i;
     int err;
     PJ *PIN = nullptr;
@@ -479,19 +493,29 @@ PJ *pj_init_ctx_with_allow_init_epsg(PJ_CONTEXT *ctx, int argc, char **argv,
         return nullptr;
     }
 
-    /* put arguments into internal linked list */
-    start = curr = pj_mkparam(argv[0]);
-    if (!curr) {
-        free_params(ctx, start, PROJ_ERR_OTHER /*ENOMEM*/);
+    /* put arguments into internal linked list, allocated from an arena */
+    /* sized so that, in the common case, the parameter list, the default */
+    /* ellipsoid and the argv arrays of a pipeline fit in a single chunk */
+    size_t arena_size = sizeof(paralist) + sizeof("ellps=GRS80");
+    for (i = 0; i < argc; ++i)
+        arena_size += 2 * sizeof(paralist) + strlen(argv[i]) + 1 +
+                      2 * sizeof(char *);
+    arena = pj_arena_create(arena_size);
+    if (!arena) {
+        proj_context_errno_set(ctx, PROJ_ERR_OTHER /*ENOMEM*/);
         return nullptr;
     }
 
+    start = curr = pj_mkparam_arena(arena, argv[0]);
+    if (!curr)
+        return free_params_and_arena(ctx, start, arena,
+                                     PROJ_ERR_OTHER /*ENOMEM*/);
+
     for (i = 1; i < argc; ++i) {
-        curr->next = pj_mkparam(argv[i]);
-        if (!curr->next) {
-            free_params(ctx, start, PROJ_ERR_OTHER /*ENOMEM*/);
-            return nullptr;
-        }
+        curr->next = pj_mkparam_arena(arena, argv[i]);
+        if (!curr->next)
+            return free_params_and_arena(ctx, start, arena,
+                                         PROJ_ERR_OTHER /*ENOMEM*/);
         curr = curr->next;
     }
 
@@ -505,49 +529,46 @@ PJ *pj_init_ctx_with_allow_init_epsg(PJ_CONTEXT *ctx, int argc, char **argv,
     init = pj_param_exists(start, "init");
     if (init && n_pipelines == 0) {
         init = pj_expand_init_internal(ctx, init, allow_init_epsg);
-        if (!init) {
-            free_params(ctx, start, PROJ_ERR_INVALID_OP_WRONG_SYNTAX);
-            return nullptr;
-        }
-    }
-    if (ctx->last_errno) {
-        free_params(ctx, start, ctx->last_errno);
-        return nullptr;
+        if (!init)
+            return free_params_and_arena(ctx, start, arena,
+                                         PROJ_ERR_INVALID_OP_WRONG_SYNTAX);
     }
+    if (ctx->last_errno)
+        return free_params_and_arena(ctx, start, arena, ctx->last_errno);
 
     /* Find projection selection */
     curr = pj_param_exists(start, "proj");
     if (nullptr == curr) {
         pj_log(ctx, PJ_LOG_ERROR, _("Missing proj"));
-        free_params(ctx, start, PROJ_ERR_INVALID_OP_MISSING_ARG);
-        return nullptr;
+        return free_params_and_arena(ctx, start, arena,
+                                     PROJ_ERR_INVALID_OP_MISSING_ARG);
     }
     name = curr->param;
     if (strlen(name) < 6) {
         pj_log(ctx, PJ_LOG_ERROR, _("Invalid value for proj"));
-        free_params(ctx, start, PROJ_ERR_INVALID_OP_ILLEGAL_ARG_VALUE);
-        return nullptr;
+        return free_params_and_arena(ctx, start, arena,
+                                     PROJ_ERR_INVALID_OP_ILLEGAL_ARG_VALUE);
     }
     name += 5;
 
     proj = locate_constructor(name);
     if (nullptr == proj) {
         pj_log(ctx, PJ_LOG_ERROR, _("Unknown projection"));
-        free_params(ctx, start, PROJ_ERR_INVALID_OP_ILLEGAL_ARG_VALUE);
-        return nullptr;
+        return free_params_and_arena(ctx, start, arena,
+                                     PROJ_ERR_INVALID_OP_ILLEGAL_ARG_VALUE);
     }
 
-    append_default_ellipsoid_to_paralist(start);
+    append_default_ellipsoid_to_paralist(arena, start);
 
     /* Allocate projection structure */
     PIN = proj(nullptr);
-    if (nullptr == PIN) {
-        free_params(ctx, start, PROJ_ERR_OTHER /*ENOMEM*/);
-        return nullptr;
-    }
+    if (nullptr == PIN)
+        return free_params_and_arena(ctx, start, arena,
+                                     PROJ_ERR_OTHER /*ENOMEM*/);
 
     PIN->ctx = ctx;
     PIN->params = start;
+    PIN->arena = arena;
     PIN->is_latlong = 0;
     PIN->is_geocent = 0;
     PIN->is_long_wrap_set = 0;
@@ -794,5 +815,12 @@ PJ *pj_init_ctx_with_allow_init_epsg(PJ_CONTEXT *ctx, int argc, char **argv,
         return nullptr;
     }
     proj_errno_restore(PIN, err);
+
+    if (PIN) {
+        PIN->trans_fwd4d = pj_fwd4d_function(PIN);
+        PIN->trans_inv4d = pj_inv4d_function(PIN);
+        PIN->trans_fwd4d_array = pj_fwd4d_array_function(PIN);
+        PIN->trans_inv4d_array = pj_inv4d_array_function(PIN);
+    }
     return PIN;
 }
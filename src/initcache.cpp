@@ -51,6 +51,7 @@ paralist *pj_clone_paralist(const paralist *list) {
         assert(newitem);
 
         newitem->used = 0;
+        newitem->in_arena = 0;
         newitem->next = nullptr;
         strcpy(newitem->param, list->param);
 
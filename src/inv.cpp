@@ -262,3 +262,44 @@ bool pj_inv4d(PJ_COORD &coo, PJ *P) {
     P->ctx->last_errno = last_errno;
     return true;
 }
+
+/* pj_inv4d() for operations that skip the prepare and finalize steps and */
+/* have a 4D inverse method: pipelines, axisswap, unitconvert... */
+static void inv4d_direct(PJ_COORD &coo, PJ *P) {
+    const int last_errno = P->ctx->last_errno;
+    P->ctx->last_errno = 0;
+
+    if (HUGE_VAL != coo.v[0])
+        P->inv4d(coo, P);
+    if (HUGE_VAL == coo.v[0] || P->ctx->last_errno) {
+        coo = proj_coord_error();
+        return;
+    }
+
+    P->ctx->last_errno = last_errno;
+}
+
+static void inv4d_generic(PJ_COORD &coo, PJ *P) { pj_inv4d(coo, P); }
+
+/* Select the function applying P in the inverse direction. Must be called */
+/* once the operation is set up. */
+PJ_OPERATOR pj_inv4d_function(const PJ *P) {
+    if (P->skip_inv_prepare && P->skip_inv_finalize && P->inv4d)
+        return inv4d_direct;
+    return inv4d_generic;
+}
+
+/* Select the batch function applying P in the inverse direction, or nullptr. */
+/* The batch method of an operation stands for pj_inv4d() as a whole, */
+/* including the check of the input coordinates for HUGE_VAL, so it is only */
+/* used when the prepare and finalize steps have nothing else to do. */
+PJ_ARRAY_OPERATOR pj_inv4d_array_function(const PJ *P) {
+    if (!P->inv4d_array)
+        return nullptr;
+    if (!P->skip_inv_prepare &&
+        (P->right != PJ_IO_UNITS_WHATEVER || P->axisswap))
+        return nullptr;
+    if (!P->skip_inv_finalize && P->left == PJ_IO_UNITS_RADIANS)
+        return nullptr;
+    return P->inv4d_array;
+}
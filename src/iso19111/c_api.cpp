@@ -137,9 +137,10 @@ void proj_context_delete_cpp_context(struct projCppContext *cppContext) {
 // ---------------------------------------------------------------------------
 
 projCppContext::projCppContext(PJ_CONTEXT *ctx, const char *dbPath,
-                               const std::vector<std::string> &auxDbPaths)
+                               const std::vector<std::string> &auxDbPaths,
+                               bool sharedDbCaches)
     : ctx_(ctx), dbPath_(dbPath ? dbPath : std::string()),
-      auxDbPaths_(auxDbPaths) {}
+      auxDbPaths_(auxDbPaths), sharedDbCaches_(sharedDbCaches) {}
 
 // ---------------------------------------------------------------------------
 
@@ -155,8 +156,8 @@ projCppContext::toVector(const char *const *auxDbPaths) {
 // ---------------------------------------------------------------------------
 
 projCppContext *projCppContext::clone(PJ_CONTEXT *ctx) const {
-    projCppContext *newContext =
-        new projCppContext(ctx, getDbPath().c_str(), getAuxDbPaths());
+    projCppContext *newContext = new projCppContext(
+        ctx, getDbPath().c_str(), getAuxDbPaths(), getSharedDbCaches());
     return newContext;
 }
 
@@ -168,12 +169,48 @@ NS_PROJ::io::DatabaseContextNNPtr projCppContext::getDatabaseContext() {
     }
     auto dbContext =
         NS_PROJ::io::DatabaseContext::create(dbPath_, auxDbPaths_, ctx_);
+    if (sharedDbCaches_) {
+        dbContext->useSharedCaches();
+    }
     databaseContext_ = dbContext;
+    // PROJ strings are exported with the help of the database
+    cachePROJString_.clear();
     return dbContext;
 }
 
 // ---------------------------------------------------------------------------
 
+bool projCppContext::getPROJStringFromCache(const BaseObjectNNPtr &obj,
+                                            std::string &projString) {
+    auto iter = cachePROJString_.find(obj.get());
+    if (iter == cachePROJString_.end()) {
+        return false;
+    }
+    // Check that this is not another object allocated at the same address
+    // as a destroyed one
+    if (iter->second.obj.lock() != obj.as_nullable()) {
+        cachePROJString_.erase(iter);
+        return false;
+    }
+    projString = iter->second.projString;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+
+void projCppContext::cache(const BaseObjectNNPtr &obj,
+                           const std::string &projString) {
+    constexpr size_t MAX_CACHED_PROJ_STRINGS = 64;
+    if (cachePROJString_.size() >= MAX_CACHED_PROJ_STRINGS) {
+        cachePROJString_.clear();
+    }
+    auto &cached = cachePROJString_[obj.get()];
+    cached.obj = obj.as_nullable();
+    cached.projString = projString;
+}
+
+// ---------------------------------------------------------------------------
+
 static PROJ_NO_INLINE DatabaseContextNNPtr getDBcontext(PJ_CONTEXT *ctx) {
     return ctx->get_cpp_context()->getDatabaseContext();
 }
@@ -196,14 +233,38 @@ PJ *pj_obj_create(PJ_CONTEXT *ctx, const BaseObjectNNPtr &objIn) {
     if (coordop) {
         auto dbContext = getDBcontextNoException(ctx, __FUNCTION__);
         try {
-            auto formatter = PROJStringFormatter::create(
-                PROJStringFormatter::Convention::PROJ_5, std::move(dbContext));
-            auto projString = coordop->exportToPROJString(formatter.get());
-            if (proj_context_is_network_enabled(ctx)) {
-                ctx->defer_grid_opening = true;
+            // Re-instantiating the same object (proj_clone(), alternative
+            // operations of proj_create_crs_to_crs()...) is frequent, so
+            // avoid formatting its PROJ string again.
+            std::string projString;
+            if (!dbContext || !ctx->cpp_context->getPROJStringFromCache(
+                                  objIn, projString)) {
+                const bool cacheable = dbContext != nullptr;
+                auto formatter = PROJStringFormatter::create(
+                    PROJStringFormatter::Convention::PROJ_5,
+                    std::move(dbContext));
+                projString = coordop->exportToPROJString(formatter.get());
+                if (cacheable) {
+                    ctx->cpp_context->cache(objIn, projString);
+                }
+            }
+            PJ *pj = nullptr;
+            if (ctx->validatedPJ) {
+                if (ctx->validatedPROJString == projString) {
+                    pj = ctx->validatedPJ;
+                } else {
+                    proj_destroy(ctx->validatedPJ);
+                }
+                ctx->validatedPJ = nullptr;
+                ctx->validatedPROJString.clear();
+            }
+            if (!pj) {
+                if (proj_context_is_network_enabled(ctx)) {
+                    ctx->defer_grid_opening = true;
+                }
+                pj = pj_create_internal(ctx, projString.c_str());
+                ctx->defer_grid_opening = false;
             }
-            auto pj = pj_create_internal(ctx, projString.c_str());
-            ctx->defer_grid_opening = false;
             if (pj) {
                 pj->iso_obj = objIn;
                 pj->iso_obj_is_coordinate_operation = true;
@@ -212,6 +273,8 @@ PJ *pj_obj_create(PJ_CONTEXT *ctx, const BaseObjectNNPtr &objIn) {
                 if (sourceEpoch.has_value()) {
                     if (!targetEpoch.has_value()) {
                         pj->hasCoordinateEpoch = true;
+                        pj->trans_fwd4d = nullptr;
+                        pj->trans_inv4d = nullptr;
                         pj->coordinateEpoch =
                             sourceEpoch->coordinateEpoch().convertToUnit(
                                 common::UnitOfMeasure::YEAR);
@@ -219,6 +282,8 @@ PJ *pj_obj_create(PJ_CONTEXT *ctx, const BaseObjectNNPtr &objIn) {
                 } else {
                     if (targetEpoch.has_value()) {
                         pj->hasCoordinateEpoch = true;
+                        pj->trans_fwd4d = nullptr;
+                        pj->trans_inv4d = nullptr;
                         pj->coordinateEpoch =
                             targetEpoch->coordinateEpoch().convertToUnit(
                                 common::UnitOfMeasure::YEAR);
@@ -267,6 +332,46 @@ PJ *pj_obj_create(PJ_CONTEXT *ctx, const BaseObjectNNPtr &objIn) {
     }
     return pj;
 }
+
+// ---------------------------------------------------------------------------
+
+/** Same as pj_obj_create(), except that a coordinate operation is not
+ * instantiated as a PROJ pipeline, which is the most expensive part of its
+ * creation. The returned object can be used for all the functions that only
+ * need its ISO-19111 object, and must be passed to pj_obj_create() before
+ * transforming coordinates.
+ */
+PJ *pj_obj_create_not_instantiated(PJ_CONTEXT *ctx,
+                                   const BaseObjectNNPtr &objIn) {
+    if (!dynamic_cast<const CoordinateOperation *>(objIn.get())) {
+        return pj_obj_create(ctx, objIn);
+    }
+    auto pj = pj_new();
+    if (pj) {
+        pj->ctx = ctx;
+        pj->descr = "ISO-19111 object";
+        pj->iso_obj = objIn;
+        pj->iso_obj_is_coordinate_operation = true;
+    }
+    return pj;
+}
+
+// ---------------------------------------------------------------------------
+
+PJ *pj_clone_not_instantiated(PJ_CONTEXT *ctx, const PJ *obj) {
+    if (!obj->iso_obj) {
+        return proj_clone(ctx, obj);
+    }
+    auto pj = pj_obj_create_not_instantiated(ctx, NN_NO_CHECK(obj->iso_obj));
+    if (pj) {
+        pj->over = obj->over;
+        pj->errorIfBestTransformationNotAvailable =
+            obj->errorIfBestTransformationNotAvailable;
+        pj->warnIfBestTransformationNotAvailable =
+            obj->warnIfBestTransformationNotAvailable;
+    }
+    return pj;
+}
 //! @endcond
 
 // ---------------------------------------------------------------------------
@@ -304,6 +409,18 @@ PJ_OBJ_LIST::~PJ_OBJ_LIST() = default;
 
 // ---------------------------------------------------------------------------
 
+//! @cond Doxygen_Suppress
+static const char *getOptionValue(const char *option,
+                                  const char *keyWithEqual) noexcept {
+    if (ci_starts_with(option, keyWithEqual)) {
+        return option + strlen(keyWithEqual);
+    }
+    return nullptr;
+}
+//! @endcond
+
+// ---------------------------------------------------------------------------
+
 /** \brief Starting with PROJ 8.1, this function does nothing.
  *
  * If you want to take into account changes to the PROJ database, you need to
@@ -335,32 +452,57 @@ void proj_context_set_autoclose_database(PJ_CONTEXT *ctx, int autoclose) {
  * @param dbPath Path to main database, or NULL for default.
  * @param auxDbPaths NULL-terminated list of auxiliary database filenames, or
  * NULL.
- * @param options should be set to NULL for now
+ * @param options NULL-terminated list of strings with "KEY=VALUE" format, or
+ * NULL. Supported options:
+ * <ul>
+ * <li>SHARED_CACHE=YES/NO. Defaults to NO (since PROJ 9.5).
+ * If set to YES, the caches of objects instantiated from the database are
+ * shared with all other contexts using the same database(s) with that option
+ * (including contexts later created with proj_context_clone(), or with
+ * proj_context_create() if ctx is the default context).
+ * This avoids each context of a multi-threaded application having to warm up
+ * its own caches. Each context still uses its own database prepared
+ * statements and must still be used by only one thread at a time.</li>
+ * </ul>
  * @return TRUE in case of success
  */
 int proj_context_set_database_path(PJ_CONTEXT *ctx, const char *dbPath,
                                    const char *const *auxDbPaths,
                                    const char *const *options) {
     SANITIZE_CTX(ctx);
-    (void)options;
+    bool sharedDbCaches = false;
+    for (auto iter = options; iter && iter[0]; ++iter) {
+        const char *value;
+        if ((value = getOptionValue(*iter, "SHARED_CACHE="))) {
+            sharedDbCaches = ci_equal(value, "YES");
+        } else {
+            std::string msg("Unknown option :");
+            msg += *iter;
+            proj_log_error(ctx, __FUNCTION__, msg.c_str());
+            return false;
+        }
+    }
     std::string osPrevDbPath;
     std::vector<std::string> osPrevAuxDbPaths;
+    bool prevSharedDbCaches = false;
     if (ctx->cpp_context) {
         osPrevDbPath = ctx->cpp_context->getDbPath();
         osPrevAuxDbPaths = ctx->cpp_context->getAuxDbPaths();
+        prevSharedDbCaches = ctx->cpp_context->getSharedDbCaches();
     }
     delete ctx->cpp_context;
     ctx->cpp_context = nullptr;
     try {
         ctx->cpp_context = new projCppContext(
-            ctx, dbPath, projCppContext::toVector(auxDbPaths));
+            ctx, dbPath, projCppContext::toVector(auxDbPaths), sharedDbCaches);
         ctx->cpp_context->getDatabaseContext();
         return true;
     } catch (const std::exception &e) {
         proj_log_error(ctx, __FUNCTION__, e.what());
         delete ctx->cpp_context;
-        ctx->cpp_context =
-            new projCppContext(ctx, osPrevDbPath.c_str(), osPrevAuxDbPaths);
+        ctx->cpp_context = new projCppContext(ctx, osPrevDbPath.c_str(),
+                                              osPrevAuxDbPaths,
+                                              prevSharedDbCaches);
         return false;
     }
 }
@@ -501,18 +643,6 @@ PJ_GUESSED_WKT_DIALECT proj_context_guess_wkt_dialect(PJ_CONTEXT *ctx,
 
 // ---------------------------------------------------------------------------
 
-//! @cond Doxygen_Suppress
-static const char *getOptionValue(const char *option,
-                                  const char *keyWithEqual) noexcept {
-    if (ci_starts_with(option, keyWithEqual)) {
-        return option + strlen(keyWithEqual);
-    }
-    return nullptr;
-}
-//! @endcond
-
-// ---------------------------------------------------------------------------
-
 /** \brief "Clone" an object.
  *
  * The object might be used independently of the original object, provided that
@@ -564,6 +694,38 @@ PJ *proj_clone(PJ_CONTEXT *ctx, const PJ *obj) {
 
 // ---------------------------------------------------------------------------
 
+//! @cond Doxygen_Suppress
+
+// Lets PROJStringParser keep the PJ it instantiates to validate a PROJ
+// string, so that pj_obj_create() can reuse it, for the lifetime of this
+// object only.
+struct ValidatedPJScope {
+    explicit ValidatedPJScope(PJ_CONTEXT *ctx)
+        : ctx_(ctx), prevKeepValidatedPJ_(ctx->keepValidatedPJ) {
+        ctx_->keepValidatedPJ = true;
+    }
+
+    ~ValidatedPJScope() {
+        ctx_->keepValidatedPJ = prevKeepValidatedPJ_;
+        if (!prevKeepValidatedPJ_) {
+            proj_destroy(ctx_->validatedPJ);
+            ctx_->validatedPJ = nullptr;
+            ctx_->validatedPROJString.clear();
+        }
+    }
+
+    ValidatedPJScope(const ValidatedPJScope &) = delete;
+    ValidatedPJScope &operator=(const ValidatedPJScope &) = delete;
+
+  private:
+    PJ_CONTEXT *ctx_;
+    bool prevKeepValidatedPJ_;
+};
+
+//! @endcond
+
+// ---------------------------------------------------------------------------
+
 /** \brief Instantiate an object from a WKT string, PROJ string, object code
  * (like "EPSG:4326", "urn:ogc:def:crs:EPSG::4326",
  * "urn:ogc:def:coordinateOperation:EPSG::1671"), a PROJJSON string, an object
@@ -593,6 +755,7 @@ PJ *proj_create(PJ_CONTEXT *ctx, const char *text) {
         getDBcontextNoException(ctx, __FUNCTION__);
     }
     try {
+        ValidatedPJScope validatedPJScope(ctx);
         auto obj =
             nn_dynamic_pointer_cast<BaseObject>(createFromUserInput(text, ctx));
         if (obj) {
@@ -643,6 +806,10 @@ PJ *proj_create(PJ_CONTEXT *ctx, const char *text) {
  *     When set to YES, object identifiers are unset when there is
  *     a contradiction between the definition from WKT and the one from
  *     the database./<li>
+ * <li>GRAMMAR_VALIDATION=YES/NO (added in 9.5). Whether the WKT string should
+ *     be validated against the WKT grammar, which requires a second parse of
+ *     it. Defaults to YES if STRICT=YES or if out_grammar_errors is not NULL,
+ *     and NO otherwise.</li>
  * </ul>
  * @param out_warnings Pointer to a PROJ_STRING_LIST object, or NULL.
  * If provided, *out_warnings will contain a list of warnings, typically for
@@ -678,15 +845,22 @@ PJ *proj_create_from_wkt(PJ_CONTEXT *ctx, const char *wkt,
         if (dbContext) {
             parser.attachDatabaseContext(NN_NO_CHECK(dbContext));
         }
-        parser.setStrict(false);
+        bool strict = false;
+        // Grammar errors can only be observed through out_grammar_errors,
+        // or as a failure in strict mode.
+        bool grammarValidation = out_grammar_errors != nullptr;
+        bool grammarValidationSet = false;
         for (auto iter = options; iter && iter[0]; ++iter) {
             const char *value;
             if ((value = getOptionValue(*iter, "STRICT="))) {
-                parser.setStrict(ci_equal(value, "YES"));
+                strict = ci_equal(value, "YES");
             } else if ((value = getOptionValue(
                             *iter, "UNSET_IDENTIFIERS_IF_INCOMPATIBLE_DEF="))) {
                 parser.setUnsetIdentifiersIfIncompatibleDef(
                     ci_equal(value, "YES"));
+            } else if ((value = getOptionValue(*iter, "GRAMMAR_VALIDATION="))) {
+                grammarValidation = ci_equal(value, "YES");
+                grammarValidationSet = true;
             } else {
                 std::string msg("Unknown option :");
                 msg += *iter;
@@ -694,6 +868,9 @@ PJ *proj_create_from_wkt(PJ_CONTEXT *ctx, const char *wkt,
                 return nullptr;
             }
         }
+        parser.setStrict(strict);
+        parser.setGrammarValidation(grammarValidation ||
+                                    (strict && !grammarValidationSet));
         auto obj = parser.createFromWKT(wkt);
 
         if (out_grammar_errors) {
@@ -8523,6 +8700,10 @@ proj_create_operations(PJ_CONTEXT *ctx, const PJ *source_crs,
  * box, but this function is faster when one needs to evaluate on many points
  * with the same (source_crs, target_crs) tuple.
  *
+ * Contrary to proj_trans(), this function only considers the area of use of
+ * the operations, and does not check that the grids they use actually cover
+ * the point.
+ *
  * @param ctx PROJ context, or NULL for default context
  * @param operations List of operations returned by proj_create_operations()
  * @param direction Direction into which to transform the point.
@@ -8554,6 +8735,7 @@ int proj_get_suggested_operation(PJ_CONTEXT *ctx, PJ_OBJ_LIST *operations,
     const auto &preparedOps = opList->getPreparedOperations(ctx);
     int idx = pj_get_suggested_operation(ctx, preparedOps, iExcluded,
                                          /* skipNonInstantiable= */ false,
+                                         /* skipOutsideGrids= */ false,
                                          direction, coord);
     if (idx >= 0) {
         idx = preparedOps[idx].idxInOriginalList;
@@ -8605,6 +8787,23 @@ PJ *proj_list_get(PJ_CONTEXT *ctx, const PJ_OBJ_LIST *result, int index) {
 
 // ---------------------------------------------------------------------------
 
+//! @cond Doxygen_Suppress
+
+/** Same as proj_list_get(), except that a coordinate operation is not
+ * instantiated as a PROJ pipeline. Cf pj_obj_create_not_instantiated()
+ */
+PJ *pj_list_get_not_instantiated(PJ_CONTEXT *ctx, const PJ_OBJ_LIST *result,
+                                 int index) {
+    if (index < 0 || index >= proj_list_get_count(result)) {
+        return nullptr;
+    }
+    return pj_obj_create_not_instantiated(ctx, result->objects[index]);
+}
+
+//! @endcond
+
+// ---------------------------------------------------------------------------
+
 /** \brief Drops a reference on the result set.
  *
  * This method should be called one and exactly one for each function
@@ -613,14 +613,42 @@ std::string DateTime::toString() const { return d->str_; }
 // cppcheck-suppress copyCtorAndEqOperator
 struct IdentifiedObject::Private {
     IdentifierNNPtr name{Identifier::create()};
-    std::vector<IdentifierNNPtr> identifiers{};
-    std::vector<GenericNameNNPtr> aliases{};
-    std::string remarks{};
+
+    // Identifiers, aliases and remarks are rarely modified after the object
+    // has been created, so they are shared (copy-on-write) between an object
+    // and its copies, such as the ones returned by shallowClone().
+    struct SharedMetadata {
+        std::vector<IdentifierNNPtr> identifiers{};
+        std::vector<GenericNameNNPtr> aliases{};
+        std::string remarks{};
+    };
+    std::shared_ptr<SharedMetadata> metadata{emptyMetadata()};
     bool isDeprecated{};
 
+    const std::vector<IdentifierNNPtr> &identifiers() const {
+        return metadata->identifiers;
+    }
+    const std::vector<GenericNameNNPtr> &aliases() const {
+        return metadata->aliases;
+    }
+    const std::string &remarks() const { return metadata->remarks; }
+
+    SharedMetadata &mutableMetadata() {
+        if (metadata.use_count() != 1) {
+            metadata = std::make_shared<SharedMetadata>(*metadata);
+        }
+        return *metadata;
+    }
+
     void setIdentifiers(const PropertyMap &properties);
     void setName(const PropertyMap &properties);
     void setAliases(const PropertyMap &properties);
+
+  private:
+    static const std::shared_ptr<SharedMetadata> &emptyMetadata() {
+        static const auto empty = std::make_shared<SharedMetadata>();
+        return empty;
+    }
 };
 //! @endcond
 
@@ -669,7 +697,7 @@ const std::string &IdentifiedObject::nameStr() PROJ_PURE_DEFN {
  */
 const std::vector<IdentifierNNPtr> &
 IdentifiedObject::identifiers() PROJ_PURE_DEFN {
-    return d->identifiers;
+    return d->identifiers();
 }
 
 // ---------------------------------------------------------------------------
@@ -678,7 +706,7 @@ IdentifiedObject::identifiers() PROJ_PURE_DEFN {
  */
 const std::vector<GenericNameNNPtr> &
 IdentifiedObject::aliases() PROJ_PURE_DEFN {
-    return d->aliases;
+    return d->aliases();
 }
 
 // ---------------------------------------------------------------------------
@@ -688,9 +716,10 @@ IdentifiedObject::aliases() PROJ_PURE_DEFN {
  * Shortcut for aliases()[0]->toFullyQualifiedName()->toString()
  */
 std::string IdentifiedObject::alias() PROJ_PURE_DEFN {
-    if (d->aliases.empty())
+    const auto &l_aliases = d->aliases();
+    if (l_aliases.empty())
         return std::string();
-    return d->aliases[0]->toFullyQualifiedName()->toString();
+    return l_aliases[0]->toFullyQualifiedName()->toString();
 }
 
 // ---------------------------------------------------------------------------
@@ -712,7 +741,7 @@ int IdentifiedObject::getEPSGCode() PROJ_PURE_DEFN {
 /** \brief Return the remarks.
  */
 const std::string &IdentifiedObject::remarks() PROJ_PURE_DEFN {
-    return d->remarks;
+    return d->remarks();
 }
 
 // ---------------------------------------------------------------------------
@@ -761,6 +790,7 @@ void IdentifiedObject::Private::setIdentifiers(
 
         pVal = properties.get(Identifier::CODE_KEY);
         if (pVal) {
+            auto &identifiers = mutableMetadata().identifiers;
             identifiers.clear();
             identifiers.push_back(
                 Identifier::create(std::string(), properties));
@@ -768,10 +798,12 @@ void IdentifiedObject::Private::setIdentifiers(
         return;
     }
     if (auto identifier = util::nn_dynamic_pointer_cast<Identifier>(*pVal)) {
+        auto &identifiers = mutableMetadata().identifiers;
         identifiers.clear();
         identifiers.push_back(NN_NO_CHECK(identifier));
     } else {
         if (auto array = dynamic_cast<const ArrayOfBaseObject *>(pVal->get())) {
+            auto &identifiers = mutableMetadata().identifiers;
             identifiers.clear();
             for (const auto &val : *array) {
                 identifier = util::nn_dynamic_pointer_cast<Identifier>(val);
@@ -799,11 +831,13 @@ void IdentifiedObject::Private::setAliases(
         return;
     }
     if (auto l_name = util::nn_dynamic_pointer_cast<GenericName>(*pVal)) {
+        auto &aliases = mutableMetadata().aliases;
         aliases.clear();
         aliases.push_back(NN_NO_CHECK(l_name));
     } else {
         if (const auto array =
                 dynamic_cast<const ArrayOfBaseObject *>(pVal->get())) {
+            auto &aliases = mutableMetadata().aliases;
             aliases.clear();
             for (const auto &val : *array) {
                 l_name = util::nn_dynamic_pointer_cast<GenericName>(val);
@@ -828,6 +862,7 @@ void IdentifiedObject::Private::setAliases(
         } else {
             std::string temp;
             if (properties.getStringValue(ALIAS_KEY, temp)) {
+                auto &aliases = mutableMetadata().aliases;
                 aliases.clear();
                 aliases.push_back(NameFactory::createLocalName(nullptr, temp));
             } else {
@@ -848,7 +883,12 @@ void IdentifiedObject::setProperties(
     d->setIdentifiers(properties);
     d->setAliases(properties);
 
-    properties.getStringValue(REMARKS_KEY, d->remarks);
+    {
+        std::string remarks;
+        if (properties.getStringValue(REMARKS_KEY, remarks)) {
+            d->mutableMetadata().remarks = std::move(remarks);
+        }
+    }
 
     {
         const auto pVal = properties.get(DEPRECATED_KEY);
@@ -1161,7 +1201,24 @@ bool ObjectDomain::_isEquivalentTo(
 
 //! @cond Doxygen_Suppress
 struct ObjectUsage::Private {
-    std::vector<ObjectDomainNNPtr> domains_{};
+    // Shared (copy-on-write) between an object and its copies
+    std::shared_ptr<std::vector<ObjectDomainNNPtr>> domains_{emptyDomains()};
+
+    std::vector<ObjectDomainNNPtr> &mutableDomains() {
+        if (domains_.use_count() != 1) {
+            domains_ =
+                std::make_shared<std::vector<ObjectDomainNNPtr>>(*domains_);
+        }
+        return *domains_;
+    }
+
+  private:
+    static const std::shared_ptr<std::vector<ObjectDomainNNPtr>> &
+    emptyDomains() {
+        static const auto empty =
+            std::make_shared<std::vector<ObjectDomainNNPtr>>();
+        return empty;
+    }
 };
 //! @endcond
 
@@ -1185,7 +1242,7 @@ ObjectUsage::~ObjectUsage() = default;
 /** \brief Return the domains of the object.
  */
 const std::vector<ObjectDomainNNPtr> &ObjectUsage::domains() PROJ_PURE_DEFN {
-    return d->domains_;
+    return *(d->domains_);
 }
 
 // ---------------------------------------------------------------------------
@@ -1211,7 +1268,8 @@ void ObjectUsage::setProperties(
     }
 
     if (scope.has_value() || domainOfValidity) {
-        d->domains_.emplace_back(ObjectDomain::create(scope, domainOfValidity));
+        d->mutableDomains().emplace_back(
+            ObjectDomain::create(scope, domainOfValidity));
     }
 
     {
@@ -1219,7 +1277,7 @@ void ObjectUsage::setProperties(
         if (pVal) {
             if (auto objectDomain =
                     util::nn_dynamic_pointer_cast<ObjectDomain>(*pVal)) {
-                d->domains_.emplace_back(NN_NO_CHECK(objectDomain));
+                d->mutableDomains().emplace_back(NN_NO_CHECK(objectDomain));
             } else if (const auto array =
                            dynamic_cast<const ArrayOfBaseObject *>(
                                pVal->get())) {
@@ -1227,7 +1285,8 @@ void ObjectUsage::setProperties(
                     objectDomain =
                         util::nn_dynamic_pointer_cast<ObjectDomain>(val);
                     if (objectDomain) {
-                        d->domains_.emplace_back(NN_NO_CHECK(objectDomain));
+                        d->mutableDomains().emplace_back(
+                            NN_NO_CHECK(objectDomain));
                     } else {
                         throw InvalidValueTypeException(
                             "Invalid value type for " + OBJECT_DOMAIN_KEY);
@@ -55,6 +55,7 @@
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
+#include <ctime>
 #include <functional>
 #include <iomanip>
 #include <limits>
@@ -656,6 +657,178 @@ void SQLiteHandleCache::invalidateHandles() {
 
 // ---------------------------------------------------------------------------
 
+// Caches of objects instantiated from a database. The caches are protected
+// by a mutex, so that a same instance can be shared by DatabaseContext
+// instances used by different threads.
+class DatabaseObjectCaches {
+  public:
+    using LRUCacheOfObjects =
+        lru11::Cache<std::string, util::BaseObjectPtr, std::mutex>;
+
+    static constexpr size_t CACHE_SIZE = 128;
+    LRUCacheOfObjects cacheUOM_{CACHE_SIZE};
+    LRUCacheOfObjects cacheCRS_{CACHE_SIZE};
+    LRUCacheOfObjects cacheEllipsoid_{CACHE_SIZE};
+    LRUCacheOfObjects cacheGeodeticDatum_{CACHE_SIZE};
+    LRUCacheOfObjects cacheDatumEnsemble_{CACHE_SIZE};
+    LRUCacheOfObjects cachePrimeMeridian_{CACHE_SIZE};
+    LRUCacheOfObjects cacheCS_{CACHE_SIZE};
+    LRUCacheOfObjects cacheExtent_{CACHE_SIZE};
+    // Usages (extent + scope) are shared by many objects, and their extent
+    // descriptions can be verbose, so keep more of them.
+    LRUCacheOfObjects cacheObjectDomain_{8 * CACHE_SIZE};
+    LRUCacheOfObjects cacheOperationParameter_{CACHE_SIZE};
+    lru11::Cache<std::string, std::vector<operation::CoordinateOperationNNPtr>,
+                 std::mutex>
+        cacheCRSToCrsCoordOp_{CACHE_SIZE};
+    lru11::Cache<std::string, std::list<std::string>, std::mutex>
+        cacheAliasNames_{CACHE_SIZE};
+
+    void clear();
+
+    static std::shared_ptr<DatabaseObjectCaches>
+    getShared(const std::string &key);
+
+    static void clearShared();
+
+  private:
+    static std::mutex &sharedMutex();
+    static std::map<std::string, std::shared_ptr<DatabaseObjectCaches>> &
+    sharedMap();
+};
+
+// ---------------------------------------------------------------------------
+
+void DatabaseObjectCaches::clear() {
+    cacheUOM_.clear();
+    cacheCRS_.clear();
+    cacheEllipsoid_.clear();
+    cacheGeodeticDatum_.clear();
+    cacheDatumEnsemble_.clear();
+    cachePrimeMeridian_.clear();
+    cacheCS_.clear();
+    cacheExtent_.clear();
+    cacheObjectDomain_.clear();
+    cacheOperationParameter_.clear();
+    cacheCRSToCrsCoordOp_.clear();
+    cacheAliasNames_.clear();
+}
+
+// ---------------------------------------------------------------------------
+
+std::mutex &DatabaseObjectCaches::sharedMutex() {
+    static std::mutex gMutex;
+    return gMutex;
+}
+
+// ---------------------------------------------------------------------------
+
+std::map<std::string, std::shared_ptr<DatabaseObjectCaches>> &
+DatabaseObjectCaches::sharedMap() {
+    // Map a key identifying the main and auxiliary databases to their caches
+    static std::map<std::string, std::shared_ptr<DatabaseObjectCaches>> gMap;
+    return gMap;
+}
+
+// ---------------------------------------------------------------------------
+
+std::shared_ptr<DatabaseObjectCaches>
+DatabaseObjectCaches::getShared(const std::string &key) {
+    std::lock_guard<std::mutex> lock(sharedMutex());
+    auto &map = sharedMap();
+    auto iter = map.find(key);
+    if (iter != map.end()) {
+        return iter->second;
+    }
+    auto caches = std::make_shared<DatabaseObjectCaches>();
+    map[key] = caches;
+    return caches;
+}
+
+// ---------------------------------------------------------------------------
+
+void DatabaseObjectCaches::clearShared() {
+    std::lock_guard<std::mutex> lock(sharedMutex());
+    sharedMap().clear();
+}
+
+// ---------------------------------------------------------------------------
+
+struct GridInfoCache {
+    std::string fullFilename{};
+    std::string packageName{};
+    std::string url{};
+    bool found = false;
+    bool directDownload = false;
+    bool openLicense = false;
+    bool gridAvailable = false;
+};
+
+// ---------------------------------------------------------------------------
+
+/** Process-wide registry of the results of
+ * DatabaseContext::lookForGridInfo(), so that contexts sharing the same
+ * database and resource file search settings do not probe the file system
+ * again for the same grids. Entries expire after the time-to-live configured
+ * in the context (grid_availability_cache_ttl_sec setting of proj.ini).
+ */
+class GridAvailabilityRegistry {
+  public:
+    static bool get(const std::string &key, int ttl, GridInfoCache &info);
+
+    static void insert(const std::string &key, const GridInfoCache &info);
+
+    static void clear();
+
+  private:
+    struct Entry {
+        GridInfoCache info{};
+        time_t timestamp = 0;
+    };
+
+    static lru11::Cache<std::string, Entry, std::mutex> &cache();
+};
+
+// ---------------------------------------------------------------------------
+
+lru11::Cache<std::string, GridAvailabilityRegistry::Entry, std::mutex> &
+GridAvailabilityRegistry::cache() {
+    static lru11::Cache<std::string, Entry, std::mutex> gCache(4096);
+    return gCache;
+}
+
+// ---------------------------------------------------------------------------
+
+bool GridAvailabilityRegistry::get(const std::string &key, int ttl,
+                                   GridInfoCache &info) {
+    Entry entry;
+    if (!cache().tryGet(key, entry)) {
+        return false;
+    }
+    if (ttl > 0 && time(nullptr) - entry.timestamp > ttl) {
+        cache().remove(key);
+        return false;
+    }
+    info = std::move(entry.info);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+
+void GridAvailabilityRegistry::insert(const std::string &key,
+                                      const GridInfoCache &info) {
+    Entry entry;
+    entry.info = info;
+    entry.timestamp = time(nullptr);
+    cache().insert(key, entry);
+}
+
+// ---------------------------------------------------------------------------
+
+void GridAvailabilityRegistry::clear() { cache().clear(); }
+
+// ---------------------------------------------------------------------------
+
 struct DatabaseContext::Private {
     Private();
     ~Private();
@@ -751,6 +924,18 @@ struct DatabaseContext::Private {
     // cppcheck-suppress functionStatic
     void cache(const std::string &code, const metadata::ExtentNNPtr &extent);
 
+    // cppcheck-suppress functionStatic
+    ObjectDomainPtr getObjectDomainFromCache(const std::string &code);
+    // cppcheck-suppress functionStatic
+    void cache(const std::string &code, const ObjectDomainNNPtr &domain);
+
+    // cppcheck-suppress functionStatic
+    operation::OperationParameterPtr
+    getOperationParameterFromCache(const std::string &code);
+    // cppcheck-suppress functionStatic
+    void cache(const std::string &code,
+               const operation::OperationParameterNNPtr &param);
+
     // cppcheck-suppress functionStatic
     bool getCRSToCRSCoordOpFromCache(
         const std::string &code,
@@ -759,21 +944,15 @@ struct DatabaseContext::Private {
     void cache(const std::string &code,
                const std::vector<operation::CoordinateOperationNNPtr> &list);
 
-    struct GridInfoCache {
-        std::string fullFilename{};
-        std::string packageName{};
-        std::string url{};
-        bool found = false;
-        bool directDownload = false;
-        bool openLicense = false;
-        bool gridAvailable = false;
-    };
+    using GridInfoCache = io::GridInfoCache;
 
     // cppcheck-suppress functionStatic
     bool getGridInfoFromCache(const std::string &code, GridInfoCache &info);
     // cppcheck-suppress functionStatic
     void cache(const std::string &code, const GridInfoCache &info);
 
+    std::string getGridAvailabilityRegistryKey(const std::string &gridKey);
+
     struct VersionedAuthName {
         std::string versionedAuthName{};
         std::string authName{};
@@ -803,26 +982,20 @@ struct DatabaseContext::Private {
     std::string memoryDbForInsertPath_{};
     std::unique_ptr<SQLiteHandle> memoryDbHandle_{};
 
-    using LRUCacheOfObjects = lru11::Cache<std::string, util::BaseObjectPtr>;
+    using LRUCacheOfObjects = DatabaseObjectCaches::LRUCacheOfObjects;
 
-    static constexpr size_t CACHE_SIZE = 128;
-    LRUCacheOfObjects cacheUOM_{CACHE_SIZE};
-    LRUCacheOfObjects cacheCRS_{CACHE_SIZE};
-    LRUCacheOfObjects cacheEllipsoid_{CACHE_SIZE};
-    LRUCacheOfObjects cacheGeodeticDatum_{CACHE_SIZE};
-    LRUCacheOfObjects cacheDatumEnsemble_{CACHE_SIZE};
-    LRUCacheOfObjects cachePrimeMeridian_{CACHE_SIZE};
-    LRUCacheOfObjects cacheCS_{CACHE_SIZE};
-    LRUCacheOfObjects cacheExtent_{CACHE_SIZE};
-    lru11::Cache<std::string, std::vector<operation::CoordinateOperationNNPtr>>
-        cacheCRSToCrsCoordOp_{CACHE_SIZE};
+    // Either owned by this instance, or shared with other instances using the
+    // same database(s) when sharedCaches_ is set.
+    std::shared_ptr<DatabaseObjectCaches> caches_ =
+        std::make_shared<DatabaseObjectCaches>();
+    bool sharedCaches_ = false;
+
+    // Depends on the file search rules of the PJ_CONTEXT, so not shared.
+    static constexpr size_t CACHE_SIZE = DatabaseObjectCaches::CACHE_SIZE;
     lru11::Cache<std::string, GridInfoCache> cacheGridInfo_{CACHE_SIZE};
 
     std::map<std::string, std::vector<std::string>> cacheAllowedAuthorities_{};
 
-    lru11::Cache<std::string, std::list<std::string>> cacheAliasNames_{
-        CACHE_SIZE};
-
     std::vector<VersionedAuthName> cacheAuthNameWithVersion_{};
 
     static void insertIntoCache(LRUCacheOfObjects &cache,
@@ -836,6 +1009,8 @@ struct DatabaseContext::Private {
 
     void clearCaches();
 
+    void useSharedCaches();
+
     std::string findFreeCode(const std::string &tableName,
                              const std::string &authName,
                              const std::string &codePrototype);
@@ -975,18 +1150,25 @@ void DatabaseContext::Private::closeDB() noexcept {
 
 void DatabaseContext::Private::clearCaches() {
 
-    cacheUOM_.clear();
-    cacheCRS_.clear();
-    cacheEllipsoid_.clear();
-    cacheGeodeticDatum_.clear();
-    cacheDatumEnsemble_.clear();
-    cachePrimeMeridian_.clear();
-    cacheCS_.clear();
-    cacheExtent_.clear();
-    cacheCRSToCrsCoordOp_.clear();
+    caches_->clear();
     cacheGridInfo_.clear();
     cacheAllowedAuthorities_.clear();
-    cacheAliasNames_.clear();
+}
+
+// ---------------------------------------------------------------------------
+
+void DatabaseContext::Private::useSharedCaches() {
+    sharedCaches_ = true;
+    std::string key(databasePath_);
+    for (const auto &path : auxiliaryDatabasePaths_) {
+        key += '\n';
+        key += path;
+    }
+    if (pjCtxt_) {
+        key += '\n';
+        key += pjCtxt_->custom_sqlite3_vfs_name;
+    }
+    caches_ = DatabaseObjectCaches::getShared(key);
 }
 
 // ---------------------------------------------------------------------------
@@ -1025,7 +1207,7 @@ void DatabaseContext::Private::getFromCache(LRUCacheOfObjects &cache,
 bool DatabaseContext::Private::getCRSToCRSCoordOpFromCache(
     const std::string &code,
     std::vector<operation::CoordinateOperationNNPtr> &list) {
-    return cacheCRSToCrsCoordOp_.tryGet(code, list);
+    return caches_->cacheCRSToCrsCoordOp_.tryGet(code, list);
 }
 
 // ---------------------------------------------------------------------------
@@ -1033,14 +1215,14 @@ bool DatabaseContext::Private::getCRSToCRSCoordOpFromCache(
 void DatabaseContext::Private::cache(
     const std::string &code,
     const std::vector<operation::CoordinateOperationNNPtr> &list) {
-    cacheCRSToCrsCoordOp_.insert(code, list);
+    caches_->cacheCRSToCrsCoordOp_.insert(code, list);
 }
 
 // ---------------------------------------------------------------------------
 
 crs::CRSPtr DatabaseContext::Private::getCRSFromCache(const std::string &code) {
     util::BaseObjectPtr obj;
-    getFromCache(cacheCRS_, code, obj);
+    getFromCache(caches_->cacheCRS_, code, obj);
     return std::static_pointer_cast<crs::CRS>(obj);
 }
 
@@ -1048,7 +1230,7 @@ crs::CRSPtr DatabaseContext::Private::getCRSFromCache(const std::string &code) {
 
 void DatabaseContext::Private::cache(const std::string &code,
                                      const crs::CRSNNPtr &crs) {
-    insertIntoCache(cacheCRS_, code, crs.as_nullable());
+    insertIntoCache(caches_->cacheCRS_, code, crs.as_nullable());
 }
 
 // ---------------------------------------------------------------------------
@@ -1056,7 +1238,7 @@ void DatabaseContext::Private::cache(const std::string &code,
 common::UnitOfMeasurePtr
 DatabaseContext::Private::getUOMFromCache(const std::string &code) {
     util::BaseObjectPtr obj;
-    getFromCache(cacheUOM_, code, obj);
+    getFromCache(caches_->cacheUOM_, code, obj);
     return std::static_pointer_cast<common::UnitOfMeasure>(obj);
 }
 
@@ -1064,7 +1246,7 @@ DatabaseContext::Private::getUOMFromCache(const std::string &code) {
 
 void DatabaseContext::Private::cache(const std::string &code,
                                      const common::UnitOfMeasureNNPtr &uom) {
-    insertIntoCache(cacheUOM_, code, uom.as_nullable());
+    insertIntoCache(caches_->cacheUOM_, code, uom.as_nullable());
 }
 
 // ---------------------------------------------------------------------------
@@ -1072,7 +1254,7 @@ void DatabaseContext::Private::cache(const std::string &code,
 datum::GeodeticReferenceFramePtr
 DatabaseContext::Private::getGeodeticDatumFromCache(const std::string &code) {
     util::BaseObjectPtr obj;
-    getFromCache(cacheGeodeticDatum_, code, obj);
+    getFromCache(caches_->cacheGeodeticDatum_, code, obj);
     return std::static_pointer_cast<datum::GeodeticReferenceFrame>(obj);
 }
 
@@ -1080,7 +1262,7 @@ DatabaseContext::Private::getGeodeticDatumFromCache(const std::string &code) {
 
 void DatabaseContext::Private::cache(
     const std::string &code, const datum::GeodeticReferenceFrameNNPtr &datum) {
-    insertIntoCache(cacheGeodeticDatum_, code, datum.as_nullable());
+    insertIntoCache(caches_->cacheGeodeticDatum_, code, datum.as_nullable());
 }
 
 // ---------------------------------------------------------------------------
@@ -1088,7 +1270,7 @@ void DatabaseContext::Private::cache(
 datum::DatumEnsemblePtr
 DatabaseContext::Private::getDatumEnsembleFromCache(const std::string &code) {
     util::BaseObjectPtr obj;
-    getFromCache(cacheDatumEnsemble_, code, obj);
+    getFromCache(caches_->cacheDatumEnsemble_, code, obj);
     return std::static_pointer_cast<datum::DatumEnsemble>(obj);
 }
 
@@ -1096,7 +1278,8 @@ DatabaseContext::Private::getDatumEnsembleFromCache(const std::string &code) {
 
 void DatabaseContext::Private::cache(
     const std::string &code, const datum::DatumEnsembleNNPtr &datumEnsemble) {
-    insertIntoCache(cacheDatumEnsemble_, code, datumEnsemble.as_nullable());
+    insertIntoCache(caches_->cacheDatumEnsemble_, code,
+                    datumEnsemble.as_nullable());
 }
 
 // ---------------------------------------------------------------------------
@@ -1104,7 +1287,7 @@ void DatabaseContext::Private::cache(
 datum::EllipsoidPtr
 DatabaseContext::Private::getEllipsoidFromCache(const std::string &code) {
     util::BaseObjectPtr obj;
-    getFromCache(cacheEllipsoid_, code, obj);
+    getFromCache(caches_->cacheEllipsoid_, code, obj);
     return std::static_pointer_cast<datum::Ellipsoid>(obj);
 }
 
@@ -1112,7 +1295,7 @@ DatabaseContext::Private::getEllipsoidFromCache(const std::string &code) {
 
 void DatabaseContext::Private::cache(const std::string &code,
                                      const datum::EllipsoidNNPtr &ellps) {
-    insertIntoCache(cacheEllipsoid_, code, ellps.as_nullable());
+    insertIntoCache(caches_->cacheEllipsoid_, code, ellps.as_nullable());
 }
 
 // ---------------------------------------------------------------------------
@@ -1120,7 +1303,7 @@ void DatabaseContext::Private::cache(const std::string &code,
 datum::PrimeMeridianPtr
 DatabaseContext::Private::getPrimeMeridianFromCache(const std::string &code) {
     util::BaseObjectPtr obj;
-    getFromCache(cachePrimeMeridian_, code, obj);
+    getFromCache(caches_->cachePrimeMeridian_, code, obj);
     return std::static_pointer_cast<datum::PrimeMeridian>(obj);
 }
 
@@ -1128,7 +1311,7 @@ DatabaseContext::Private::getPrimeMeridianFromCache(const std::string &code) {
 
 void DatabaseContext::Private::cache(const std::string &code,
                                      const datum::PrimeMeridianNNPtr &pm) {
-    insertIntoCache(cachePrimeMeridian_, code, pm.as_nullable());
+    insertIntoCache(caches_->cachePrimeMeridian_, code, pm.as_nullable());
 }
 
 // ---------------------------------------------------------------------------
@@ -1136,7 +1319,7 @@ void DatabaseContext::Private::cache(const std::string &code,
 cs::CoordinateSystemPtr DatabaseContext::Private::getCoordinateSystemFromCache(
     const std::string &code) {
     util::BaseObjectPtr obj;
-    getFromCache(cacheCS_, code, obj);
+    getFromCache(caches_->cacheCS_, code, obj);
     return std::static_pointer_cast<cs::CoordinateSystem>(obj);
 }
 
@@ -1144,7 +1327,7 @@ cs::CoordinateSystemPtr DatabaseContext::Private::getCoordinateSystemFromCache(
 
 void DatabaseContext::Private::cache(const std::string &code,
                                      const cs::CoordinateSystemNNPtr &cs) {
-    insertIntoCache(cacheCS_, code, cs.as_nullable());
+    insertIntoCache(caches_->cacheCS_, code, cs.as_nullable());
 }
 
 // ---------------------------------------------------------------------------
@@ -1152,7 +1335,7 @@ void DatabaseContext::Private::cache(const std::string &code,
 metadata::ExtentPtr
 DatabaseContext::Private::getExtentFromCache(const std::string &code) {
     util::BaseObjectPtr obj;
-    getFromCache(cacheExtent_, code, obj);
+    getFromCache(caches_->cacheExtent_, code, obj);
     return std::static_pointer_cast<metadata::Extent>(obj);
 }
 
@@ -1160,7 +1343,41 @@ DatabaseContext::Private::getExtentFromCache(const std::string &code) {
 
 void DatabaseContext::Private::cache(const std::string &code,
                                      const metadata::ExtentNNPtr &extent) {
-    insertIntoCache(cacheExtent_, code, extent.as_nullable());
+    insertIntoCache(caches_->cacheExtent_, code, extent.as_nullable());
+}
+
+// ---------------------------------------------------------------------------
+
+ObjectDomainPtr
+DatabaseContext::Private::getObjectDomainFromCache(const std::string &code) {
+    util::BaseObjectPtr obj;
+    getFromCache(caches_->cacheObjectDomain_, code, obj);
+    return std::static_pointer_cast<ObjectDomain>(obj);
+}
+
+// ---------------------------------------------------------------------------
+
+void DatabaseContext::Private::cache(const std::string &code,
+                                     const ObjectDomainNNPtr &domain) {
+    insertIntoCache(caches_->cacheObjectDomain_, code, domain.as_nullable());
+}
+
+// ---------------------------------------------------------------------------
+
+operation::OperationParameterPtr
+DatabaseContext::Private::getOperationParameterFromCache(
+    const std::string &code) {
+    util::BaseObjectPtr obj;
+    getFromCache(caches_->cacheOperationParameter_, code, obj);
+    return std::static_pointer_cast<operation::OperationParameter>(obj);
+}
+
+// ---------------------------------------------------------------------------
+
+void DatabaseContext::Private::cache(
+    const std::string &code, const operation::OperationParameterNNPtr &param) {
+    insertIntoCache(caches_->cacheOperationParameter_, code,
+                    param.as_nullable());
 }
 
 // ---------------------------------------------------------------------------
@@ -1179,6 +1396,42 @@ void DatabaseContext::Private::cache(const std::string &code,
 
 // ---------------------------------------------------------------------------
 
+// Return the key under which the result of lookForGridInfo() for gridKey
+// can be stored in the process-wide GridAvailabilityRegistry, or an empty
+// string if the registry must not be used.
+std::string DatabaseContext::Private::getGridAvailabilityRegistryKey(
+    const std::string &gridKey) {
+    auto ctxt = pjCtxt();
+    if (ctxt->gridAvailabilityCacheTTL == 0 || databasePath_.empty() ||
+        ctxt->file_finder != nullptr || ctxt->fileApi.open_cbk != nullptr) {
+        // Resolution through user callbacks cannot be assumed to be the
+        // same from one context to another.
+        return std::string();
+    }
+    std::string key(gridKey);
+    key += '\n';
+    key += databasePath_;
+    for (const auto &path : auxiliaryDatabasePaths_) {
+        key += '\n';
+        key += path;
+    }
+    key += '\n';
+    key += ctxt->custom_sqlite3_vfs_name;
+    for (const auto &path : ctxt->search_paths) {
+        key += '\n';
+        key += path;
+    }
+    key += '\n';
+    key += ctxt->env_var_proj_data;
+    key += '\n';
+    key += ctxt->user_writable_directory;
+    key += '\n';
+    key += ctxt->endpoint;
+    return key;
+}
+
+// ---------------------------------------------------------------------------
+
 void DatabaseContext::Private::open(const std::string &databasePath,
                                     PJ_CONTEXT *ctx) {
     if (!ctx) {
@@ -1296,10 +1549,18 @@ void DatabaseContext::Private::attachExtraDatabases(
                                       attachedDbName + '.');
     }
 
+    // Only tables and views for which an auxiliary database has records are
+    // replaced by a UNION ALL view. Other names resolve to the tables of
+    // db_0, since it is the first attached database, which keeps the queries
+    // on them as efficient as without auxiliary database.
+    // The database used by startInsertStatementsSession() is filled after
+    // being attached, so it is always included.
     for (const auto &pair : tableStructure) {
         std::string sql("CREATE TEMP VIEW ");
         sql += pair.first;
         sql += " AS ";
+        bool hasAuxiliaryRecords = false;
+        bool firstSelect = true;
         for (size_t i = 0; i <= auxiliaryDatabasePaths.size(); ++i) {
             std::string selectFromAux("SELECT ");
             bool firstCol = true;
@@ -1316,18 +1577,29 @@ void DatabaseContext::Private::attachExtraDatabases(
             selectFromAux += pair.first;
 
             try {
-                // Check that the request will succeed. In case of 'sparse'
-                // databases...
-                run(selectFromAux + " LIMIT 0");
+                if (i == 0) {
+                    // Check that the request will succeed. In case of 'sparse'
+                    // databases...
+                    run(selectFromAux + " LIMIT 0");
+                } else if (auxiliaryDatabasePaths[i - 1] !=
+                               memoryDbForInsertPath_ &&
+                           run(selectFromAux + " LIMIT 1").empty()) {
+                    continue;
+                } else {
+                    hasAuxiliaryRecords = true;
+                }
 
-                if (i > 0) {
+                if (!firstSelect) {
                     sql += " UNION ALL ";
                 }
+                firstSelect = false;
                 sql += selectFromAux;
             } catch (const std::exception &) {
             }
         }
-        run(sql);
+        if (hasAuxiliaryRecords) {
+            run(sql);
+        }
     }
 }
 
@@ -3020,6 +3292,12 @@ void DatabaseContext::startInsertStatementsSession() {
         sqlite3_free(errmsg);
     }
 
+    // Objects created during the session must not leak into caches shared
+    // with other database contexts
+    if (d->sharedCaches_) {
+        d->caches_ = std::make_shared<DatabaseObjectCaches>();
+    }
+
     // Attach this database to the current one(s)
     auto auxiliaryDatabasePaths(d->auxiliaryDatabasePaths_);
     auxiliaryDatabasePaths.push_back(d->memoryDbForInsertPath_);
@@ -3243,6 +3521,9 @@ void DatabaseContext::stopInsertStatementsSession() {
         d->attachExtraDatabases(d->auxiliaryDatabasePaths_);
         d->memoryDbHandle_.reset();
         d->memoryDbForInsertPath_.clear();
+        if (d->sharedCaches_) {
+            d->useSharedCaches();
+        }
     }
 }
 
@@ -3262,6 +3543,15 @@ void *DatabaseContext::getSqliteHandle() const { return d->handle()->handle(); }
 
 // ---------------------------------------------------------------------------
 
+// Make this database context use object caches shared with all other
+// database contexts opened on the same database(s) that also use this mode.
+// Prepared statements remain specific to each database context, so a given
+// database context should still be used by only one thread at a time, but
+// objects instantiated by one thread become available to the others.
+void DatabaseContext::useSharedCaches() { d->useSharedCaches(); }
+
+// ---------------------------------------------------------------------------
+
 bool DatabaseContext::lookForGridAlternative(const std::string &officialName,
                                              std::string &projFilename,
                                              std::string &projFormat,
@@ -3309,7 +3599,15 @@ bool DatabaseContext::lookForGridInfo(
     std::string key(projFilename);
     key += proj_context_is_network_enabled(ctxt) ? "true" : "false";
     key += considerKnownGridsAsAvailable ? "true" : "false";
-    if (d->getGridInfoFromCache(key, info)) {
+    const std::string registryKey(d->getGridAvailabilityRegistryKey(key));
+    bool cached = d->getGridInfoFromCache(key, info);
+    if (!cached && !registryKey.empty() &&
+        GridAvailabilityRegistry::get(registryKey,
+                                      ctxt->gridAvailabilityCacheTTL, info)) {
+        d->cache(key, info);
+        cached = true;
+    }
+    if (cached) {
         fullFilename = info.fullFilename;
         packageName = info.packageName;
         url = info.url;
@@ -3423,6 +3721,9 @@ bool DatabaseContext::lookForGridInfo(
     info.gridAvailable = gridAvailable;
     info.found = ret;
     d->cache(key, info);
+    if (!registryKey.empty()) {
+        GridAvailabilityRegistry::insert(registryKey, info);
+    }
     return ret;
 }
 
@@ -3566,7 +3867,7 @@ std::list<std::string> DatabaseContext::getAliases(
 
     std::list<std::string> res;
     const auto key(authName + code + officialName + tableName + source);
-    if (d->cacheAliasNames_.tryGet(key, res)) {
+    if (d->caches_->cacheAliasNames_.tryGet(key, res)) {
         return res;
     }
 
@@ -3593,7 +3894,7 @@ std::list<std::string> DatabaseContext::getAliases(
                             "alt_name = ? AND source IN ('EPSG', 'PROJ')",
                             {genuineTableName, officialName});
             if (resSql.size() != 1) {
-                d->cacheAliasNames_.insert(key, res);
+                d->caches_->cacheAliasNames_.insert(key, res);
                 return res;
             }
         }
@@ -3621,7 +3922,7 @@ std::list<std::string> DatabaseContext::getAliases(
         }
     }
 
-    d->cacheAliasNames_.insert(key, res);
+    d->caches_->cacheAliasNames_.insert(key, res);
     return res;
 }
 
@@ -3980,6 +4281,10 @@ struct AuthorityFactory::Private {
     UnitOfMeasure createUnitOfMeasure(const std::string &auth_name,
                                       const std::string &code);
 
+    operation::OperationParameterNNPtr
+    createOperationParameter(const std::string &auth_name,
+                             const std::string &code, const std::string &name);
+
     util::PropertyMap
     createProperties(const std::string &code, const std::string &name,
                      bool deprecated,
@@ -4049,6 +4354,32 @@ AuthorityFactory::Private::createUnitOfMeasure(const std::string &auth_name,
 
 // ---------------------------------------------------------------------------
 
+// Parameters are shared between all operations that use them.
+operation::OperationParameterNNPtr
+AuthorityFactory::Private::createOperationParameter(
+    const std::string &auth_name, const std::string &code,
+    const std::string &name) {
+    const std::string cacheKey(
+        std::string(auth_name).append(":").append(code).append(":").append(
+            name));
+    const auto &dbContextPrivate = context()->getPrivate();
+    {
+        auto param = dbContextPrivate->getOperationParameterFromCache(cacheKey);
+        if (param) {
+            return NN_NO_CHECK(param);
+        }
+    }
+    auto param = operation::OperationParameter::create(
+        util::PropertyMap()
+            .set(metadata::Identifier::CODESPACE_KEY, auth_name)
+            .set(metadata::Identifier::CODE_KEY, code)
+            .set(common::IdentifiedObject::NAME_KEY, name));
+    dbContextPrivate->cache(cacheKey, param);
+    return param;
+}
+
+// ---------------------------------------------------------------------------
+
 util::PropertyMap AuthorityFactory::Private::createProperties(
     const std::string &code, const std::string &name, bool deprecated,
     const std::vector<ObjectDomainNNPtr> &usages) {
@@ -4087,15 +4418,18 @@ util::PropertyMap AuthorityFactory::Private::createPropertiesSearchUsages(
         // 10.076 and earlier
         res = run("SELECT extent.description, extent.south_lat, "
                   "extent.north_lat, extent.west_lon, extent.east_lon, "
-                  "scope.scope, 0 AS score FROM extent, scope WHERE "
-                  "extent.code = 1262 and scope.code = 1183");
+                  "scope.scope, 0 AS score, extent.auth_name, extent.code, "
+                  "scope.auth_name, scope.code FROM extent, scope WHERE "
+                  "extent.auth_name = 'EPSG' AND extent.code = 1262 AND "
+                  "scope.auth_name = 'EPSG' AND scope.code = 1183");
     } else {
         const std::string sql(
             "SELECT extent.description, extent.south_lat, "
             "extent.north_lat, extent.west_lon, extent.east_lon, "
             "scope.scope, "
             "(CASE WHEN scope.scope LIKE '%large scale%' THEN 0 ELSE 1 END) "
-            "AS score "
+            "AS score, usage.extent_auth_name, usage.extent_code, "
+            "usage.scope_auth_name, usage.scope_code "
             "FROM usage "
             "JOIN extent ON usage.extent_auth_name = extent.auth_name AND "
             "usage.extent_code = extent.code "
@@ -4112,6 +4446,7 @@ util::PropertyMap AuthorityFactory::Private::createPropertiesSearchUsages(
         res = run(sql, {table_name, authority(), code});
     }
     std::vector<ObjectDomainNNPtr> usages;
+    const auto &dbContextPrivate = context()->getPrivate();
     for (const auto &row : res) {
         try {
             size_t idx = 0;
@@ -4120,35 +4455,69 @@ util::PropertyMap AuthorityFactory::Private::createPropertiesSearchUsages(
             const auto &north_lat_str = row[idx++];
             const auto &west_lon_str = row[idx++];
             const auto &east_lon_str = row[idx++];
-            const auto &scope = row[idx];
+            const auto &scope = row[idx++];
+            idx++; // score
+            const auto &extent_auth_name = row[idx++];
+            const auto &extent_code = row[idx++];
+            const auto &scope_auth_name = row[idx++];
+            const auto &scope_code = row[idx];
+
+            // Usages are shared between all objects that refer to the same
+            // extent and scope.
+            const std::string domainCacheKey(
+                std::string(extent_auth_name)
+                    .append(":")
+                    .append(extent_code)
+                    .append("|")
+                    .append(scope_auth_name)
+                    .append(":")
+                    .append(scope_code));
+            {
+                auto domain =
+                    dbContextPrivate->getObjectDomainFromCache(domainCacheKey);
+                if (domain) {
+                    usages.emplace_back(NN_NO_CHECK(domain));
+                    continue;
+                }
+            }
 
             util::optional<std::string> scopeOpt;
             if (!scope.empty()) {
                 scopeOpt = scope;
             }
 
-            metadata::ExtentPtr extent;
-            if (south_lat_str.empty()) {
-                extent = metadata::Extent::create(
-                             util::optional<std::string>(extent_description),
-                             {}, {}, {})
-                             .as_nullable();
-            } else {
-                double south_lat = c_locale_stod(south_lat_str);
-                double north_lat = c_locale_stod(north_lat_str);
-                double west_lon = c_locale_stod(west_lon_str);
-                double east_lon = c_locale_stod(east_lon_str);
-                auto bbox = metadata::GeographicBoundingBox::create(
-                    west_lon, south_lat, east_lon, north_lat);
-                extent = metadata::Extent::create(
-                             util::optional<std::string>(extent_description),
-                             std::vector<metadata::GeographicExtentNNPtr>{bbox},
-                             std::vector<metadata::VerticalExtentNNPtr>(),
-                             std::vector<metadata::TemporalExtentNNPtr>())
-                             .as_nullable();
-            }
-
-            usages.emplace_back(ObjectDomain::create(scopeOpt, extent));
+            // Same cache key as in AuthorityFactory::createExtent()
+            const std::string extentCacheKey(extent_auth_name + extent_code);
+            metadata::ExtentPtr extent =
+                dbContextPrivate->getExtentFromCache(extentCacheKey);
+            if (!extent) {
+                if (south_lat_str.empty()) {
+                    extent = metadata::Extent::create(
+                                 util::optional<std::string>(
+                                     extent_description),
+                                 {}, {}, {})
+                                 .as_nullable();
+                } else {
+                    double south_lat = c_locale_stod(south_lat_str);
+                    double north_lat = c_locale_stod(north_lat_str);
+                    double west_lon = c_locale_stod(west_lon_str);
+                    double east_lon = c_locale_stod(east_lon_str);
+                    auto bbox = metadata::GeographicBoundingBox::create(
+                        west_lon, south_lat, east_lon, north_lat);
+                    extent =
+                        metadata::Extent::create(
+                            util::optional<std::string>(extent_description),
+                            std::vector<metadata::GeographicExtentNNPtr>{bbox},
+                            std::vector<metadata::VerticalExtentNNPtr>(),
+                            std::vector<metadata::TemporalExtentNNPtr>())
+                            .as_nullable();
+                }
+                dbContextPrivate->cache(extentCacheKey, NN_NO_CHECK(extent));
+            }
+
+            auto domain = ObjectDomain::create(scopeOpt, extent);
+            dbContextPrivate->cache(domainCacheKey, domain);
+            usages.emplace_back(std::move(domain));
         } catch (const std::exception &) {
         }
     }
@@ -5494,11 +5863,8 @@ AuthorityFactory::createConversion(const std::string &code) const {
             const auto &param_value = row[base_param_idx + i * 6 + 3];
             const auto &param_uom_auth_name = row[base_param_idx + i * 6 + 4];
             const auto &param_uom_code = row[base_param_idx + i * 6 + 5];
-            parameters.emplace_back(operation::OperationParameter::create(
-                util::PropertyMap()
-                    .set(metadata::Identifier::CODESPACE_KEY, param_auth_name)
-                    .set(metadata::Identifier::CODE_KEY, param_code)
-                    .set(common::IdentifiedObject::NAME_KEY, param_name)));
+            parameters.emplace_back(d->createOperationParameter(
+                param_auth_name, param_code, param_name));
             std::string normalized_uom_code(param_uom_code);
             const double normalized_value = normalizeMeasure(
                 param_uom_code, param_value, normalized_uom_code);
@@ -6274,23 +6640,13 @@ operation::CoordinateOperationNNPtr AuthorityFactory::createCoordinateOperation(
             std::vector<operation::OperationParameterNNPtr> parameters;
             std::vector<operation::ParameterValueNNPtr> values;
 
-            parameters.emplace_back(operation::OperationParameter::create(
-                util::PropertyMap()
-                    .set(common::IdentifiedObject::NAME_KEY, grid_param_name)
-                    .set(metadata::Identifier::CODESPACE_KEY,
-                         grid_param_auth_name)
-                    .set(metadata::Identifier::CODE_KEY, grid_param_code)));
+            parameters.emplace_back(d->createOperationParameter(
+                grid_param_auth_name, grid_param_code, grid_param_name));
             values.emplace_back(
                 operation::ParameterValue::createFilename(grid_name));
             if (!grid2_name.empty()) {
-                parameters.emplace_back(operation::OperationParameter::create(
-                    util::PropertyMap()
-                        .set(common::IdentifiedObject::NAME_KEY,
-                             grid2_param_name)
-                        .set(metadata::Identifier::CODESPACE_KEY,
-                             grid2_param_auth_name)
-                        .set(metadata::Identifier::CODE_KEY,
-                             grid2_param_code)));
+                parameters.emplace_back(d->createOperationParameter(
+                    grid2_param_auth_name, grid2_param_code, grid2_param_name));
                 values.emplace_back(
                     operation::ParameterValue::createFilename(grid2_name));
             }
@@ -6406,12 +6762,8 @@ operation::CoordinateOperationNNPtr AuthorityFactory::createCoordinateOperation(
                 const auto &param_uom_auth_name =
                     row[base_param_idx + i * 6 + 4];
                 const auto &param_uom_code = row[base_param_idx + i * 6 + 5];
-                parameters.emplace_back(operation::OperationParameter::create(
-                    util::PropertyMap()
-                        .set(metadata::Identifier::CODESPACE_KEY,
-                             param_auth_name)
-                        .set(metadata::Identifier::CODE_KEY, param_code)
-                        .set(common::IdentifiedObject::NAME_KEY, param_name)));
+                parameters.emplace_back(d->createOperationParameter(
+                    param_auth_name, param_code, param_name));
                 std::string normalized_uom_code(param_uom_code);
                 const double normalized_value = normalizeMeasure(
                     param_uom_code, param_value, normalized_uom_code);
@@ -9987,4 +10339,14 @@ NS_PROJ_END
 
 // ---------------------------------------------------------------------------
 
-void pj_clear_sqlite_cache() { NS_PROJ::io::SQLiteHandleCache::get().clear(); }
+void pj_clear_sqlite_cache() {
+    NS_PROJ::io::SQLiteHandleCache::get().clear();
+    NS_PROJ::io::DatabaseObjectCaches::clearShared();
+    pj_clear_grid_availability_cache();
+}
+
+// ---------------------------------------------------------------------------
+
+void pj_clear_grid_availability_cache() {
+    NS_PROJ::io::GridAvailabilityRegistry::clear();
+}
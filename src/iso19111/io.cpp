@@ -1265,6 +1265,7 @@ struct WKTParser::Private {
 
     bool strict_ = true;
     bool unsetIdentifiersIfIncompatibleDef_ = true;
+    bool grammarValidation_ = true;
     std::list<std::string> warningList_{};
     std::list<std::string> grammarErrorList_{};
     std::vector<double> toWGS84Parameters_{};
@@ -1503,6 +1504,26 @@ WKTParser &WKTParser::setUnsetIdentifiersIfIncompatibleDef(bool unset) {
 
 // ---------------------------------------------------------------------------
 
+/** \brief Set whether the WKT string should be validated against the WKT
+ * grammar.
+ *
+ * Validation requires a second parse of the string with the grammar
+ * generated parsers, which roughly doubles the parsing time. When it is
+ * disabled, grammarErrorList() is always empty, and grammar errors are not
+ * reported as exceptions in strict mode, although the WKT might still be
+ * rejected by the construction of the object.
+ *
+ * Defaults to true.
+ *
+ * @since PROJ 9.5
+ */
+WKTParser &WKTParser::setGrammarValidation(bool validate) {
+    d->grammarValidation_ = validate;
+    return *this;
+}
+
+// ---------------------------------------------------------------------------
+
 /** \brief Return the list of warnings found during parsing.
  *
  * \note The list might be non-empty only is setStrict(false) has been called.
@@ -7567,9 +7588,12 @@ static BaseObjectNNPtr createFromUserInput(const std::string &text,
                     if (isspace(static_cast<unsigned char>(*wkt)))
                         continue;
                     if (*wkt == '[') {
+                        // Grammar errors would be ignored in non-strict
+                        // mode, so do not bother looking for them.
                         return WKTParser()
                             .attachDatabaseContext(dbContext)
                             .setStrict(false)
+                            .setGrammarValidation(false)
                             .createFromWKT(text);
                     }
                     break;
@@ -8283,6 +8307,10 @@ BaseObjectNNPtr WKTParser::createFromWKT(const std::string &wkt) {
 
     auto obj = build();
 
+    if (!d->grammarValidation_) {
+        return obj;
+    }
+
     if (dialect == WKTGuessedDialect::WKT1_GDAL ||
         dialect == WKTGuessedDialect::WKT1_ESRI) {
         auto errorMsg = pj_wkt1_parse(wkt);
@@ -8484,12 +8512,12 @@ struct Step {
         std::string value{};
         bool usedByParser = false; // only for PROJStringParser used
 
-        explicit KeyValue(const std::string &keyIn) : key(keyIn) {}
+        explicit KeyValue(std::string keyIn) : key(std::move(keyIn)) {}
 
         KeyValue(const char *keyIn, const std::string &valueIn);
 
-        KeyValue(const std::string &keyIn, const std::string &valueIn)
-            : key(keyIn), value(valueIn) {}
+        KeyValue(std::string keyIn, std::string valueIn)
+            : key(std::move(keyIn)), value(std::move(valueIn)) {}
 
         // cppcheck-suppress functionStatic
         bool keyEquals(const char *otherKey) const noexcept {
@@ -9894,12 +9922,30 @@ void PROJStringFormatter::Private::appendToResult(const char *str) {
 
 // ---------------------------------------------------------------------------
 
+// Whether the NUL-terminated str starts with the string literal prefix.
+template <size_t N>
+static inline bool tokenStartsWith(const char *str,
+                                   const char (&prefix)[N]) noexcept {
+    return strncmp(str, prefix, N - 1) == 0;
+}
+
+// ---------------------------------------------------------------------------
+
+static Step::KeyValue tokenToKeyValue(const char *token) {
+    const char *equal = strchr(token, '=');
+    if (equal == nullptr) {
+        return Step::KeyValue(std::string(token));
+    }
+    return Step::KeyValue(std::string(token, equal - token),
+                          std::string(equal + 1));
+}
+
+// ---------------------------------------------------------------------------
+
 static void
 PROJStringSyntaxParser(const std::string &projString, std::vector<Step> &steps,
                        std::vector<Step::KeyValue> &globalParamValues,
                        std::string &title) {
-    std::vector<std::string> tokens;
-
     bool hasProj = false;
     bool hasInit = false;
     bool hasPipeline = false;
@@ -9921,18 +9967,22 @@ PROJStringSyntaxParser(const std::string &projString, std::vector<Step> &steps,
         }
     }
 
+    // The tokens point into projStringModified: they are only copied when
+    // stored as step names or parameters.
     size_t argc = pj_trim_argc(&projStringModified[0]);
     char **argv = pj_trim_argv(argc, &projStringModified[0]);
+    std::vector<const char *> tokens;
+    tokens.reserve(argc);
     for (size_t i = 0; i < argc; i++) {
-        std::string token(argv[i]);
-        if (!hasPipeline && token == "proj=pipeline") {
+        const char *token = argv[i];
+        if (!hasPipeline && strcmp(token, "proj=pipeline") == 0) {
             hasPipeline = true;
-        } else if (!hasProj && starts_with(token, "proj=")) {
+        } else if (!hasProj && tokenStartsWith(token, "proj=")) {
             hasProj = true;
-        } else if (!hasInit && starts_with(token, "init=")) {
+        } else if (!hasInit && tokenStartsWith(token, "init=")) {
             hasInit = true;
         }
-        tokens.emplace_back(token);
+        tokens.push_back(token);
     }
     free(argv);
 
@@ -9941,35 +9991,27 @@ PROJStringSyntaxParser(const std::string &projString, std::vector<Step> &steps,
             steps.push_back(Step());
         }
 
-        for (auto &word : tokens) {
-            if (starts_with(word, "proj=") && !hasInit &&
+        for (const char *word : tokens) {
+            if (tokenStartsWith(word, "proj=") && !hasInit &&
                 steps.back().name.empty()) {
                 assert(hasProj);
-                auto stepName = word.substr(strlen("proj="));
-                steps.back().name = std::move(stepName);
-            } else if (starts_with(word, "init=")) {
+                steps.back().name = word + strlen("proj=");
+            } else if (tokenStartsWith(word, "init=")) {
                 assert(hasInit);
-                auto initName = word.substr(strlen("init="));
-                steps.back().name = std::move(initName);
+                steps.back().name = word + strlen("init=");
                 steps.back().isInit = true;
-            } else if (word == "inv") {
+            } else if (strcmp(word, "inv") == 0) {
                 if (!steps.empty()) {
                     steps.back().inverted = true;
                 }
-            } else if (starts_with(word, "title=")) {
-                title = word.substr(strlen("title="));
-            } else if (word != "step") {
-                const auto pos = word.find('=');
-                auto key = word.substr(0, pos);
-
-                const Step::KeyValue pair(
-                    (pos != std::string::npos)
-                        ? Step::KeyValue(key, word.substr(pos + 1))
-                        : Step::KeyValue(key));
+            } else if (tokenStartsWith(word, "title=")) {
+                title = word + strlen("title=");
+            } else if (strcmp(word, "step") != 0) {
                 if (steps.empty()) {
-                    globalParamValues.push_back(pair);
+                    globalParamValues.emplace_back(tokenToKeyValue(word));
                 } else {
-                    steps.back().paramValues.push_back(pair);
+                    steps.back().paramValues.emplace_back(
+                        tokenToKeyValue(word));
                 }
             }
         }
@@ -9978,44 +10020,39 @@ PROJStringSyntaxParser(const std::string &projString, std::vector<Step> &steps,
 
     bool inPipeline = false;
     bool invGlobal = false;
-    for (auto &word : tokens) {
-        if (word == "proj=pipeline") {
+    for (const char *word : tokens) {
+        if (strcmp(word, "proj=pipeline") == 0) {
             if (inPipeline) {
                 throw ParsingException("nested pipeline not supported");
             }
             inPipeline = true;
-        } else if (word == "step") {
+        } else if (strcmp(word, "step") == 0) {
             if (!inPipeline) {
                 throw ParsingException("+step found outside pipeline");
             }
             steps.push_back(Step());
-        } else if (word == "inv") {
+        } else if (strcmp(word, "inv") == 0) {
             if (steps.empty()) {
                 invGlobal = true;
             } else {
                 steps.back().inverted = true;
             }
-        } else if (inPipeline && !steps.empty() && starts_with(word, "proj=") &&
+        } else if (inPipeline && !steps.empty() &&
+                   tokenStartsWith(word, "proj=") &&
                    steps.back().name.empty()) {
-            auto stepName = word.substr(strlen("proj="));
-            steps.back().name = std::move(stepName);
-        } else if (inPipeline && !steps.empty() && starts_with(word, "init=") &&
+            steps.back().name = word + strlen("proj=");
+        } else if (inPipeline && !steps.empty() &&
+                   tokenStartsWith(word, "init=") &&
                    steps.back().name.empty()) {
-            auto initName = word.substr(strlen("init="));
-            steps.back().name = std::move(initName);
+            steps.back().name = word + strlen("init=");
             steps.back().isInit = true;
-        } else if (!inPipeline && starts_with(word, "title=")) {
-            title = word.substr(strlen("title="));
+        } else if (!inPipeline && tokenStartsWith(word, "title=")) {
+            title = word + strlen("title=");
         } else {
-            const auto pos = word.find('=');
-            auto key = word.substr(0, pos);
-            Step::KeyValue pair((pos != std::string::npos)
-                                    ? Step::KeyValue(key, word.substr(pos + 1))
-                                    : Step::KeyValue(key));
             if (steps.empty()) {
-                globalParamValues.emplace_back(std::move(pair));
+                globalParamValues.emplace_back(tokenToKeyValue(word));
             } else {
-                steps.back().paramValues.emplace_back(std::move(pair));
+                steps.back().paramValues.emplace_back(tokenToKeyValue(word));
             }
         }
     }
@@ -12480,11 +12517,12 @@ PROJStringParser::createFromPROJString(const std::string &projString) {
         proj_context_use_proj4_init_rules(pj_context, d->usePROJ4InitRules_);
     }
     pj_context->projStringParserCreateFromPROJStringRecursionCounter++;
+    const bool isCRSString = projString.find("type=crs") != std::string::npos;
     auto pj = pj_create_internal(
-        pj_context, (projString.find("type=crs") != std::string::npos
-                         ? projString + " +disable_grid_presence_check"
-                         : projString)
-                        .c_str());
+        pj_context,
+        (isCRSString ? projString + " +disable_grid_presence_check"
+                     : projString)
+            .c_str());
     pj_context->projStringParserCreateFromPROJStringRecursionCounter--;
     valid = pj != nullptr;
 
@@ -12558,7 +12596,16 @@ PROJStringParser::createFromPROJString(const std::string &projString) {
         }
     }
 
-    proj_destroy(pj);
+    if (valid && pj_context == d->ctx_ && pj_context->keepValidatedPJ &&
+        !isCRSString) {
+        // Keep it, so that pj_obj_create() does not need to instantiate
+        // the same pipeline again.
+        proj_destroy(pj_context->validatedPJ);
+        pj_context->validatedPROJString = projString;
+        pj_context->validatedPJ = pj;
+    } else {
+        proj_destroy(pj);
+    }
 
     if (!valid) {
         const int l_errno = proj_context_errno(pj_context);
@@ -61,7 +61,8 @@ struct CoordinateOperation::Private {
                      const crs::CRSNNPtr &targetCRSIn)
             : sourceCRS_(sourceCRSIn), targetCRS_(targetCRSIn) {}
     };
-    std::unique_ptr<CRSStrongRef> strongRef_{};
+    // Immutable once set, and thus shared between an operation and its copies
+    std::shared_ptr<const CRSStrongRef> strongRef_{};
 
     Private() = default;
     Private(const Private &other)
@@ -73,9 +74,7 @@ struct CoordinateOperation::Private {
           sourceCoordinateEpoch_(other.sourceCoordinateEpoch_),
           targetCoordinateEpoch_(other.targetCoordinateEpoch_),
           hasBallparkTransformation_(other.hasBallparkTransformation_),
-          strongRef_(other.strongRef_ ? internal::make_unique<CRSStrongRef>(
-                                            *(other.strongRef_))
-                                      : nullptr) {}
+          strongRef_(other.strongRef_) {}
 
     Private &operator=(const Private &) = delete;
 };
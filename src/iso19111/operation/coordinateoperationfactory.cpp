@@ -1177,6 +1177,11 @@ struct FilterResults {
     bool hasOpThatContainsAreaOfInterestAndNoGrid = false;
     std::vector<CoordinateOperationNNPtr> res{};
 
+    // PROJ strings of the operations that could be exported, computed by
+    // sort() and reused by removeDuplicateOps()
+    std::map<const CoordinateOperation *, std::string> projStrings{};
+    bool projStringsComputed = false;
+
     // ----------------------------------------------------------------------
     void computeAreaOfInterest() {
 
@@ -1422,7 +1427,11 @@ struct FilterResults {
             auto formatter = io::PROJStringFormatter::create();
             size_t projStepCount = 0;
             try {
-                const auto str = op->exportToPROJString(formatter.get());
+                const auto &str =
+                    projStrings
+                        .emplace(op.get(),
+                                 op->exportToPROJString(formatter.get()))
+                        .first->second;
                 // Grids might be missing, but at least this is something
                 // PROJ could potentially process
                 isPROJExportable = true;
@@ -1465,6 +1474,7 @@ struct FilterResults {
                     std::string::npos,
                 isNullTransformation(op->nameStr()));
         }
+        projStringsComputed = true;
 
         // Sort !
         SortFunction sortFunc(map);
@@ -1594,9 +1604,19 @@ struct FilterResults {
         std::set<std::string> setPROJPlusExtent;
         std::vector<CoordinateOperationNNPtr> resTemp;
         for (const auto &op : res) {
-            auto formatter = io::PROJStringFormatter::create();
             try {
-                std::string key(op->exportToPROJString(formatter.get()));
+                std::string key;
+                const auto iter = projStrings.find(op.get());
+                if (iter != projStrings.end()) {
+                    key = iter->second;
+                } else if (projStringsComputed) {
+                    // Not exportable
+                    resTemp.emplace_back(op);
+                    continue;
+                } else {
+                    auto formatter = io::PROJStringFormatter::create();
+                    key = op->exportToPROJString(formatter.get());
+                }
                 bool dummy = false;
                 auto extentOp = getExtent(op, true, dummy);
                 if (extentOp) {
@@ -228,7 +228,7 @@ void CoordinateOperation::setCRSs(const crs::CRSNNPtr &sourceCRSIn,
                                   const crs::CRSNNPtr &targetCRSIn,
                                   const crs::CRSPtr &interpolationCRSIn) {
     d->strongRef_ =
-        internal::make_unique<Private::CRSStrongRef>(sourceCRSIn, targetCRSIn);
+        std::make_shared<Private::CRSStrongRef>(sourceCRSIn, targetCRSIn);
     d->sourceCRSWeak_ = sourceCRSIn.as_nullable();
     d->targetCRSWeak_ = targetCRSIn.as_nullable();
     d->interpolationCRS_ = interpolationCRSIn;
@@ -1132,9 +1132,20 @@ int OperationParameter::getEPSGCode() PROJ_PURE_DEFN {
 
 //! @cond Doxygen_Suppress
 struct SingleOperation::Private {
-    std::vector<GeneralParameterValueNNPtr> parameterValues_{};
+    // Parameter values are immutable once set, and thus shared between an
+    // operation and its copies
+    std::shared_ptr<const std::vector<GeneralParameterValueNNPtr>>
+        parameterValues_{emptyParameterValues()};
     OperationMethodNNPtr method_;
 
+    static const std::shared_ptr<const std::vector<GeneralParameterValueNNPtr>>
+        &emptyParameterValues() {
+        static const std::shared_ptr<
+            const std::vector<GeneralParameterValueNNPtr>>
+            empty = std::make_shared<std::vector<GeneralParameterValueNNPtr>>();
+        return empty;
+    }
+
     explicit Private(const OperationMethodNNPtr &methodIn)
         : method_(methodIn) {}
 };
@@ -1169,7 +1180,7 @@ SingleOperation::~SingleOperation() = default;
  */
 const std::vector<GeneralParameterValueNNPtr> &
 SingleOperation::parameterValues() PROJ_PURE_DEFN {
-    return d->parameterValues_;
+    return *(d->parameterValues_);
 }
 
 // ---------------------------------------------------------------------------
@@ -1186,7 +1197,8 @@ const OperationMethodNNPtr &SingleOperation::method() PROJ_PURE_DEFN {
 
 void SingleOperation::setParameterValues(
     const std::vector<GeneralParameterValueNNPtr> &values) {
-    d->parameterValues_ = values;
+    d->parameterValues_ =
+        std::make_shared<std::vector<GeneralParameterValueNNPtr>>(values);
 }
 
 // ---------------------------------------------------------------------------
@@ -1490,8 +1502,8 @@ bool SingleOperation::_isEquivalentTo(const util::IComparable *other,
         return false;
     }
 
-    const auto &values = d->parameterValues_;
-    const auto &otherValues = otherSO->d->parameterValues_;
+    const auto &values = *(d->parameterValues_);
+    const auto &otherValues = *(otherSO->d->parameterValues_);
     const auto valuesSize = values.size();
     const auto otherValuesSize = otherValues.size();
     if (criterion == util::IComparable::Criterion::STRICT) {
@@ -253,6 +253,8 @@ set(SRC_LIBPROJ_CORE
   filemanager.hpp
   filemanager.cpp
   networkfilemanager.cpp
+  sha256.hpp
+  sha256.cpp
   sqlite3_utils.hpp
   sqlite3_utils.cpp
   ${CMAKE_CURRENT_BINARY_DIR}/proj_config.h
@@ -69,6 +69,79 @@ char *pj_strdup(const char *str)
     return dup;
 }
 
+/*****************************************************************************/
+/*                               pj_arena                                    */
+/*                                                                           */
+/*      Monotonic allocator used for the storage whose lifetime is the one   */
+/*      of a PJ object (parameter list, pipeline argv, ...). Allocations are */
+/*      carved out of a chain of chunks, and are all released at once by     */
+/*      pj_arena_destroy(). The returned memory is zero-initialized.         */
+/*****************************************************************************/
+
+struct pj_arena {
+    pj_arena *next;    /* next chunk */
+    pj_arena *current; /* chunk being filled (only set in the first chunk) */
+    size_t capacity;   /* number of bytes available after the header */
+    size_t used;
+};
+
+static constexpr size_t ARENA_ALIGNMENT = 16;
+
+static size_t pj_arena_round_up(size_t size) {
+    return (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+}
+
+static const size_t ARENA_HEADER_SIZE = pj_arena_round_up(sizeof(pj_arena));
+
+static pj_arena *pj_arena_new_chunk(size_t capacity) {
+    capacity = pj_arena_round_up(capacity < 256 ? 256 : capacity);
+    auto chunk =
+        static_cast<pj_arena *>(calloc(1, ARENA_HEADER_SIZE + capacity));
+    if (chunk)
+        chunk->capacity = capacity;
+    return chunk;
+}
+
+/*****************************************************************************/
+pj_arena *pj_arena_create(size_t initial_size) {
+    /*****************************************************************************/
+    pj_arena *arena = pj_arena_new_chunk(initial_size);
+    if (arena)
+        arena->current = arena;
+    return arena;
+}
+
+/*****************************************************************************/
+void *pj_arena_alloc(pj_arena *arena, size_t size) {
+    /*****************************************************************************/
+    if (nullptr == arena)
+        return nullptr;
+    size = pj_arena_round_up(size ? size : 1);
+    pj_arena *chunk = arena->current;
+    if (chunk->capacity - chunk->used < size) {
+        const size_t twice = 2 * chunk->capacity;
+        pj_arena *new_chunk = pj_arena_new_chunk(size > twice ? size : twice);
+        if (nullptr == new_chunk)
+            return nullptr;
+        chunk->next = new_chunk;
+        arena->current = chunk = new_chunk;
+    }
+    char *ptr =
+        reinterpret_cast<char *>(chunk) + ARENA_HEADER_SIZE + chunk->used;
+    chunk->used += size;
+    return ptr;
+}
+
+/*****************************************************************************/
+void pj_arena_destroy(pj_arena *arena) {
+    /*****************************************************************************/
+    while (arena) {
+        pj_arena *next = arena->next;
+        free(arena);
+        arena = next;
+    }
+}
+
 /*****************************************************************************/
 void *free_params(PJ_CONTEXT *ctx, paralist *start, int errlev) {
     /*****************************************************************************
@@ -77,11 +150,14 @@ void *free_params(PJ_CONTEXT *ctx, paralist *start, int errlev) {
 
         Also called from pj_init_ctx when encountering errors before the PJ
         proper is allocated.
+
+        Elements allocated from an arena are left to pj_arena_destroy().
     ******************************************************************************/
     paralist *t, *n;
     for (t = start; t; t = n) {
         n = t->next;
-        free(t);
+        if (!t->in_arena)
+            free(t);
     }
     proj_context_errno_set(ctx, errlev);
     return (void *)nullptr;
@@ -156,6 +232,7 @@ PJ *pj_default_destructor(PJ *P, int errlev) { /* Destructor */
 
     /* free parameter list elements */
     free_params(pj_get_ctx(P), P->params, errlev);
+    pj_arena_destroy(P->arena);
     free(P->def_full);
 
     /* free the cs2cs emulation elements */
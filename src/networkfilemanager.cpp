@@ -47,6 +47,7 @@
 #include "proj/internal/internal.hpp"
 #include "proj/internal/lru_cache.hpp"
 #include "proj_internal.h"
+#include "sha256.hpp"
 #include "sqlite3_utils.hpp"
 
 #ifdef CURL_ENABLED
@@ -2186,6 +2187,43 @@ void proj_grid_cache_clear(PJ_CONTEXT *ctx) {
 
 // ---------------------------------------------------------------------------
 
+/** Override, for the considered context, the time-to-live delay of the
+ * entries of the process-wide grid availability cache.
+ *
+ * This cache records the result of looking for the grids referenced by
+ * coordinate operations, so that contexts using the same database and the
+ * same resource file search settings do not probe the file system again.
+ * It is not used by contexts with a custom file finder or file API.
+ *
+ * @param ctx PROJ context, or NULL
+ * @param ttl_seconds Delay in seconds. Use 0 to disable the use of the cache
+ * by this context (default), and a negative value for no expiration.
+ * @since 9.5
+ */
+void proj_grid_availability_cache_set_ttl(PJ_CONTEXT *ctx, int ttl_seconds) {
+    if (ctx == nullptr) {
+        ctx = pj_get_default_ctx();
+    }
+    // Load ini file, now so as to override its settings
+    pj_load_ini(ctx);
+    ctx->gridAvailabilityCacheTTL = ttl_seconds;
+}
+
+// ---------------------------------------------------------------------------
+
+/** Clear the process-wide grid availability cache.
+ *
+ * This should be called after grids have been installed or removed by other
+ * means than proj_download_file().
+ *
+ * @since 9.5
+ */
+void proj_grid_availability_cache_clear(void) {
+    pj_clear_grid_availability_cache();
+}
+
+// ---------------------------------------------------------------------------
+
 /** Return if a file must be downloaded or is already available in the
  * PROJ user-writable directory.
  *
@@ -2352,6 +2390,71 @@ int proj_download_file(PJ_CONTEXT *ctx, const char *url_or_filename,
                        int (*progress_cbk)(PJ_CONTEXT *, double pct,
                                            void *user_data),
                        void *user_data) {
+    return pj_download_file(ctx, url_or_filename, ignore_ttl_setting != 0,
+                            false, std::string(), progress_cbk, user_data);
+}
+
+// ---------------------------------------------------------------------------
+
+// Properties of the remote file a partial download (".part" file) belongs to,
+// stored in a ".part.props" file next to it, one value per line.
+
+static bool
+pj_read_partial_download_props(PJ_CONTEXT *ctx, const std::string &filename,
+                               NS_PROJ::FileProperties &props) {
+    auto f = NS_PROJ::FileManager::open(ctx, filename.c_str(),
+                                        NS_PROJ::FileAccess::READ_ONLY);
+    if (!f)
+        return false;
+    std::string lines[3];
+    for (auto &line : lines) {
+        bool maxLenReached = false;
+        bool eofReached = false;
+        line = f->read_line(1024, maxLenReached, eofReached);
+        if (maxLenReached)
+            return false;
+    }
+    try {
+        props.size = std::stoull(lines[0]);
+    } catch (const std::exception &) {
+        return false;
+    }
+    props.lastModified = lines[1];
+    props.etag = lines[2];
+    return props.size > 0;
+}
+
+// ---------------------------------------------------------------------------
+
+static bool
+pj_write_partial_download_props(PJ_CONTEXT *ctx, const std::string &filename,
+                                const NS_PROJ::FileProperties &props) {
+    auto f = NS_PROJ::FileManager::open(ctx, filename.c_str(),
+                                        NS_PROJ::FileAccess::CREATE);
+    if (!f)
+        return false;
+    const std::string content(std::to_string(props.size) + '\n' +
+                              props.lastModified + '\n' + props.etag + '\n');
+    return f->write(content.data(), content.size()) == content.size();
+}
+
+// ---------------------------------------------------------------------------
+
+// Same as proj_download_file(), with the following additions:
+// - if resume is true, the file is first downloaded as a ".part" file, which
+//   is kept if the download is interrupted. Later attempts only request the
+//   missing bytes, provided that the remote file has not changed meanwhile.
+//   The ".part" file is protected by a lock on a ".part.lock" file, held
+//   during the whole download.
+// - if expected_sha256sum is not empty, the SHA-256 digest of the file is
+//   computed while it is downloaded, and the download fails if it does not
+//   match.
+bool pj_download_file(PJ_CONTEXT *ctx, const char *url_or_filename,
+                      bool ignore_ttl_setting, bool resume,
+                      const std::string &expected_sha256sum,
+                      int (*progress_cbk)(PJ_CONTEXT *, double pct,
+                                          void *user_data),
+                      void *user_data) {
     if (ctx == nullptr) {
         ctx = pj_get_default_ctx();
     }
@@ -2371,22 +2474,77 @@ int proj_download_file(PJ_CONTEXT *ctx, const char *url_or_filename,
         std::string(proj_context_get_user_writable_directory(ctx, true)) +
         filename);
 
+    // The partial download may only be used by one download at a time.
+    // Concurrent ones use a temporary file of their own, as when not
+    // resuming.
+    std::unique_ptr<NS_PROJ::FileLock> partLock;
+    if (resume) {
+        partLock = NS_PROJ::FileManager::lock(
+            ctx, (localFilename + ".part.lock").c_str());
+        if (!partLock) {
+            pj_log(ctx, PJ_LOG_DEBUG,
+                   "Cannot lock partial download of %s. Not resuming it",
+                   url.c_str());
+            resume = false;
+        }
+    }
+
+    std::string localFilenameTmp;
+    std::string localFilenamePartProps;
+    std::unique_ptr<NS_PROJ::File> f;
+    unsigned long long resumeOffset = 0;
+    NS_PROJ::FileProperties resumeProps;
+    if (resume) {
+        localFilenameTmp = localFilename + ".part";
+        localFilenamePartProps = localFilenameTmp + ".props";
+        if (pj_read_partial_download_props(ctx, localFilenamePartProps,
+                                           resumeProps)) {
+            f = NS_PROJ::FileManager::open(ctx, localFilenameTmp.c_str(),
+                                           NS_PROJ::FileAccess::READ_UPDATE);
+            if (f && f->seek(0, SEEK_END)) {
+                resumeOffset = f->tell();
+                if (resumeOffset >= resumeProps.size) {
+                    resumeOffset = 0;
+                }
+            }
+        }
+    } else {
 #ifdef _WIN32
-    const int nPID = GetCurrentProcessId();
+        const int nPID = GetCurrentProcessId();
 #else
-    const int nPID = getpid();
+        const int nPID = getpid();
 #endif
-    char szUniqueSuffix[128];
-    snprintf(szUniqueSuffix, sizeof(szUniqueSuffix), "%d_%p", nPID,
-             static_cast<const void *>(&url));
-    const auto localFilenameTmp(localFilename + szUniqueSuffix);
-    auto f = NS_PROJ::FileManager::open(ctx, localFilenameTmp.c_str(),
-                                        NS_PROJ::FileAccess::CREATE);
+        char szUniqueSuffix[128];
+        snprintf(szUniqueSuffix, sizeof(szUniqueSuffix), "%d_%p", nPID,
+                 static_cast<const void *>(&url));
+        localFilenameTmp = localFilename + szUniqueSuffix;
+    }
+    if (resumeOffset == 0) {
+        f = NS_PROJ::FileManager::open(ctx, localFilenameTmp.c_str(),
+                                       NS_PROJ::FileAccess::CREATE);
+    }
     if (!f) {
         pj_log(ctx, PJ_LOG_ERROR, "Cannot create %s", localFilenameTmp.c_str());
         return false;
     }
 
+    // On failure, a partial download is kept so that it can be resumed,
+    // unless its content is known to be wrong.
+    PROJ_NETWORK_HANDLE *handle = nullptr;
+    const auto failure = [ctx, resume, &handle, &f, &localFilenameTmp,
+                          &localFilenamePartProps](bool discard) {
+        if (handle)
+            ctx->networking.close(ctx, handle, ctx->networking.user_data);
+        f.reset();
+        if (!resume || discard) {
+            NS_PROJ::FileManager::unlink(ctx, localFilenameTmp.c_str());
+            if (resume)
+                NS_PROJ::FileManager::unlink(ctx,
+                                             localFilenamePartProps.c_str());
+        }
+        return false;
+    };
+
     constexpr size_t FULL_FILE_CHUNK_SIZE = 1024 * 1024;
     std::vector<unsigned char> buffer(FULL_FILE_CHUNK_SIZE);
     // For testing purposes only
@@ -2398,45 +2556,97 @@ int proj_download_file(PJ_CONTEXT *ctx, const char *url_or_filename,
     }
     size_t size_read = 0;
     std::string errorBuffer;
-    errorBuffer.resize(1024);
-    auto handle = ctx->networking.open(
-        ctx, url.c_str(), 0, buffer.size(), &buffer[0], &size_read,
-        errorBuffer.size(), &errorBuffer[0], ctx->networking.user_data);
-    if (!handle) {
-        errorBuffer.resize(strlen(errorBuffer.data()));
-        pj_log(ctx, PJ_LOG_ERROR, "Cannot open %s: %s", url.c_str(),
-               errorBuffer.c_str());
-        f.reset();
-        NS_PROJ::FileManager::unlink(ctx, localFilenameTmp.c_str());
-        return false;
-    }
-
     time_t curTime;
-    time(&curTime);
     NS_PROJ::FileProperties props;
-    if (!NS_PROJ::NetworkFile::get_props_from_headers(ctx, handle, props)) {
-        ctx->networking.close(ctx, handle, ctx->networking.user_data);
+    while (true) {
+        errorBuffer.resize(1024);
+        handle = ctx->networking.open(ctx, url.c_str(), resumeOffset,
+                                      buffer.size(), &buffer[0], &size_read,
+                                      errorBuffer.size(), &errorBuffer[0],
+                                      ctx->networking.user_data);
+        errorBuffer.resize(strlen(errorBuffer.data()));
+        time(&curTime);
+        const bool propsOK =
+            handle &&
+            NS_PROJ::NetworkFile::get_props_from_headers(ctx, handle, props);
+        if (resumeOffset == 0) {
+            if (!handle) {
+                pj_log(ctx, PJ_LOG_ERROR, "Cannot open %s: %s", url.c_str(),
+                       errorBuffer.c_str());
+            }
+            if (!propsOK) {
+                return failure(false);
+            }
+            break;
+        }
+        if (propsOK && props.size == resumeProps.size &&
+            props.lastModified == resumeProps.lastModified &&
+            props.etag == resumeProps.etag) {
+            break;
+        }
+
+        // The range request failed (for example because the remote file
+        // shrank), or the remote file has changed since the partial
+        // download: discard it and restart from scratch.
+        pj_log(ctx, PJ_LOG_DEBUG,
+               "Cannot resume download of %s. Restarting it", url.c_str());
+        if (handle) {
+            ctx->networking.close(ctx, handle, ctx->networking.user_data);
+            handle = nullptr;
+        }
         f.reset();
         NS_PROJ::FileManager::unlink(ctx, localFilenameTmp.c_str());
-        return false;
+        NS_PROJ::FileManager::unlink(ctx, localFilenamePartProps.c_str());
+        resumeOffset = 0;
+        f = NS_PROJ::FileManager::open(ctx, localFilenameTmp.c_str(),
+                                       NS_PROJ::FileAccess::CREATE);
+        if (!f) {
+            pj_log(ctx, PJ_LOG_ERROR, "Cannot create %s",
+                   localFilenameTmp.c_str());
+            return failure(true);
+        }
+    }
+    if (resume && resumeOffset == 0 &&
+        !pj_write_partial_download_props(ctx, localFilenamePartProps, props)) {
+        pj_log(ctx, PJ_LOG_ERROR, "Cannot create %s",
+               localFilenamePartProps.c_str());
+        return failure(true);
+    }
+
+    std::unique_ptr<NS_PROJ::SHA256> sha256;
+    if (!expected_sha256sum.empty()) {
+        sha256.reset(new NS_PROJ::SHA256());
+        if (resumeOffset > 0) {
+            // Digest the already downloaded bytes
+            std::vector<unsigned char> existing(FULL_FILE_CHUNK_SIZE);
+            f->seek(0);
+            unsigned long long remaining = resumeOffset;
+            while (remaining > 0) {
+                const size_t toRead = static_cast<size_t>(
+                    std::min<unsigned long long>(remaining, existing.size()));
+                if (f->read(existing.data(), toRead) != toRead) {
+                    pj_log(ctx, PJ_LOG_ERROR, "Read error");
+                    return failure(true);
+                }
+                sha256->update(existing.data(), toRead);
+                remaining -= toRead;
+            }
+            f->seek(0, SEEK_END);
+        }
     }
 
     if (size_read == 0) {
         pj_log(ctx, PJ_LOG_ERROR, "Did not get as many bytes as expected");
-        ctx->networking.close(ctx, handle, ctx->networking.user_data);
-        f.reset();
-        NS_PROJ::FileManager::unlink(ctx, localFilenameTmp.c_str());
-        return false;
+        return failure(false);
     }
     if (f->write(buffer.data(), size_read) != size_read) {
         pj_log(ctx, PJ_LOG_ERROR, "Write error");
-        ctx->networking.close(ctx, handle, ctx->networking.user_data);
-        f.reset();
-        NS_PROJ::FileManager::unlink(ctx, localFilenameTmp.c_str());
-        return false;
+        return failure(false);
     }
+    if (sha256)
+        sha256->update(buffer.data(), size_read);
 
-    unsigned long long totalDownloaded = size_read;
+    unsigned long long totalDownloaded = resumeOffset + size_read;
     while (totalDownloaded < props.size) {
         if (totalDownloaded + buffer.size() > props.size) {
             buffer.resize(static_cast<size_t>(props.size - totalDownloaded));
@@ -2448,32 +2658,38 @@ int proj_download_file(PJ_CONTEXT *ctx, const char *url_or_filename,
 
         if (size_read < buffer.size()) {
             pj_log(ctx, PJ_LOG_ERROR, "Did not get as many bytes as expected");
-            ctx->networking.close(ctx, handle, ctx->networking.user_data);
-            f.reset();
-            NS_PROJ::FileManager::unlink(ctx, localFilenameTmp.c_str());
-            return false;
+            return failure(false);
         }
         if (f->write(buffer.data(), size_read) != size_read) {
             pj_log(ctx, PJ_LOG_ERROR, "Write error");
-            ctx->networking.close(ctx, handle, ctx->networking.user_data);
-            f.reset();
-            NS_PROJ::FileManager::unlink(ctx, localFilenameTmp.c_str());
-            return false;
+            return failure(false);
         }
+        if (sha256)
+            sha256->update(buffer.data(), size_read);
 
         totalDownloaded += size_read;
         if (progress_cbk &&
             !progress_cbk(ctx, double(totalDownloaded) / props.size,
                           user_data)) {
-            ctx->networking.close(ctx, handle, ctx->networking.user_data);
-            f.reset();
-            NS_PROJ::FileManager::unlink(ctx, localFilenameTmp.c_str());
-            return false;
+            return failure(false);
+        }
+    }
+
+    if (sha256) {
+        const auto sha256sum = sha256->hexDigest();
+        if (!ci_equal(sha256sum, expected_sha256sum)) {
+            pj_log(ctx, PJ_LOG_ERROR,
+                   "Checksum mismatch for %s: got %s, expected %s",
+                   url.c_str(), sha256sum.c_str(), expected_sha256sum.c_str());
+            return failure(true);
         }
     }
 
     ctx->networking.close(ctx, handle, ctx->networking.user_data);
+    handle = nullptr;
     f.reset();
+    if (resume)
+        NS_PROJ::FileManager::unlink(ctx, localFilenamePartProps.c_str());
     NS_PROJ::FileManager::unlink(ctx, localFilename.c_str());
     if (!NS_PROJ::FileManager::rename(ctx, localFilenameTmp.c_str(),
                                       localFilename.c_str())) {
@@ -2481,6 +2697,8 @@ int proj_download_file(PJ_CONTEXT *ctx, const char *url_or_filename,
                localFilenameTmp.c_str(), localFilename.c_str());
         return false;
     }
+    // The availability of the file has changed
+    pj_clear_grid_availability_cache();
 
     auto diskCache = NS_PROJ::DiskChunkCache::open(ctx);
     if (!diskCache)
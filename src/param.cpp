@@ -16,6 +16,7 @@ paralist *pj_mkparam(const char *str) {
     if ((newitem = (paralist *)malloc(sizeof(paralist) + strlen(str))) !=
         nullptr) {
         newitem->used = 0;
+        newitem->in_arena = 0;
         newitem->next = nullptr;
         if (*str == '+')
             ++str;
@@ -24,6 +25,20 @@ paralist *pj_mkparam(const char *str) {
     return newitem;
 }
 
+/* As pj_mkparam, but the entry is allocated from <arena> */
+paralist *pj_mkparam_arena(struct pj_arena *arena, const char *str) {
+    paralist *newitem;
+
+    if (*str == '+')
+        ++str;
+    if ((newitem = (paralist *)pj_arena_alloc(
+             arena, sizeof(paralist) + strlen(str) + 1)) != nullptr) {
+        newitem->in_arena = 1;
+        (void)strcpy(newitem->param, str);
+    }
+    return newitem;
+}
+
 /* As pj_mkparam, but payload ends at first whitespace, rather than at end of
  * <str> */
 paralist *pj_mkparam_ws(const char *str, const char **next_str) {
@@ -97,6 +97,7 @@ Thomas Knudsen, thokn@sdfe.dk, 2016-05-20
 *
 ********************************************************************************/
 
+#include <algorithm>
 #include <math.h>
 #include <stack>
 #include <stddef.h>
@@ -149,10 +150,16 @@ struct PushPop {
 
 static void pipeline_forward_4d(PJ_COORD &point, PJ *P);
 static void pipeline_reverse_4d(PJ_COORD &point, PJ *P);
+static void pipeline_forward_4d_array(PJ_COORD *coo, size_t n, PJ *P,
+                                      int *errnos);
+static void pipeline_reverse_4d_array(PJ_COORD *coo, size_t n, PJ *P,
+                                      int *errnos);
 static PJ_XYZ pipeline_forward_3d(PJ_LPZ lpz, PJ *P);
 static PJ_LPZ pipeline_reverse_3d(PJ_XYZ xyz, PJ *P);
 static PJ_XY pipeline_forward(PJ_LP lp, PJ *P);
 static PJ_LP pipeline_reverse(PJ_XY xy, PJ *P);
+static void push(PJ_COORD &point, PJ *P);
+static void pop(PJ_COORD &point, PJ *P);
 
 static void pipeline_reassign_context(PJ *P, PJ_CONTEXT *ctx) {
     auto pipeline = static_cast<struct Pipeline *>(P->opaque);
@@ -165,9 +172,9 @@ static void pipeline_forward_4d(PJ_COORD &point, PJ *P) {
     for (auto &step : pipeline->steps) {
         if (!step.omit_fwd) {
             if (!step.pj->inverted)
-                pj_fwd4d(point, step.pj);
+                step.pj->trans_fwd4d(point, step.pj);
             else
-                pj_inv4d(point, step.pj);
+                step.pj->trans_inv4d(point, step.pj);
             if (point.xyzt.x == HUGE_VAL) {
                 break;
             }
@@ -182,9 +189,9 @@ static void pipeline_reverse_4d(PJ_COORD &point, PJ *P) {
         const auto &step = *iterStep;
         if (!step.omit_inv) {
             if (step.pj->inverted)
-                pj_fwd4d(point, step.pj);
+                step.pj->trans_fwd4d(point, step.pj);
             else
-                pj_inv4d(point, step.pj);
+                step.pj->trans_inv4d(point, step.pj);
             if (point.xyzt.x == HUGE_VAL) {
                 break;
             }
@@ -192,6 +199,77 @@ static void pipeline_reverse_4d(PJ_COORD &point, PJ *P) {
     }
 }
 
+/* Apply a step to an array of coordinates, with its batch method if it has
+ * one, and otherwise coordinate by coordinate. Coordinates that failed in a
+ * previous step are left alone, and keep their error code. */
+static void pipeline_step_array(PJ *Q, bool forward, PJ_COORD *coo, size_t n,
+                                int *errnos) {
+    constexpr size_t BLOCK_SIZE = 64;
+    const PJ_ARRAY_OPERATOR array_op =
+        forward ? Q->trans_fwd4d_array : Q->trans_inv4d_array;
+    if (array_op) {
+        bool failed[BLOCK_SIZE];
+        int stepErrnos[BLOCK_SIZE];
+        for (size_t start = 0; start < n; start += BLOCK_SIZE) {
+            const size_t count = std::min(BLOCK_SIZE, n - start);
+            for (size_t i = 0; i < count; i++) {
+                failed[i] = coo[start + i].xyzt.x == HUGE_VAL;
+                stepErrnos[i] = 0;
+            }
+            array_op(coo + start, count, Q, stepErrnos);
+            for (size_t i = 0; i < count; i++) {
+                if (!failed[i] && stepErrnos[i])
+                    errnos[start + i] = stepErrnos[i];
+            }
+        }
+        return;
+    }
+
+    const PJ_OPERATOR op = forward ? Q->trans_fwd4d : Q->trans_inv4d;
+    const int last_errno = Q->ctx->last_errno;
+    for (size_t i = 0; i < n; i++) {
+        if (coo[i].xyzt.x == HUGE_VAL)
+            continue;
+        Q->ctx->last_errno = 0;
+        op(coo[i], Q);
+        if (Q->ctx->last_errno)
+            errnos[i] = Q->ctx->last_errno;
+    }
+    Q->ctx->last_errno = last_errno;
+}
+
+/* Batch equivalents of pipeline_forward_4d() and pipeline_reverse_4d(): the
+ * coordinates go through the pipeline step by step, rather than one by one.
+ * Only used when no step is a push or pop. */
+static void pipeline_forward_4d_array(PJ_COORD *coo, size_t n, PJ *P,
+                                      int *errnos) {
+    auto pipeline = static_cast<struct Pipeline *>(P->opaque);
+    for (size_t i = 0; i < n; i++) {
+        if (coo[i].xyzt.x == HUGE_VAL)
+            coo[i] = proj_coord_error();
+    }
+    for (auto &step : pipeline->steps) {
+        if (!step.omit_fwd)
+            pipeline_step_array(step.pj, !step.pj->inverted, coo, n, errnos);
+    }
+}
+
+static void pipeline_reverse_4d_array(PJ_COORD *coo, size_t n, PJ *P,
+                                      int *errnos) {
+    auto pipeline = static_cast<struct Pipeline *>(P->opaque);
+    for (size_t i = 0; i < n; i++) {
+        if (coo[i].xyzt.x == HUGE_VAL)
+            coo[i] = proj_coord_error();
+    }
+    for (auto iterStep = pipeline->steps.rbegin();
+         iterStep != pipeline->steps.rend(); ++iterStep) {
+        const auto &step = *iterStep;
+        if (!step.omit_inv)
+            pipeline_step_array(step.pj, step.pj->inverted != 0, coo, n,
+                                errnos);
+    }
+}
+
 static PJ_XYZ pipeline_forward_3d(PJ_LPZ lpz, PJ *P) {
     PJ_COORD point = {{0, 0, 0, 0}};
     point.lpz = lpz;
@@ -269,9 +347,6 @@ static PJ *destructor(PJ *P, int errlev) {
 
     auto pipeline = static_cast<struct Pipeline *>(P->opaque);
 
-    free(pipeline->argv);
-    free(pipeline->current_argv);
-
     delete pipeline;
     P->opaque = nullptr;
 
@@ -291,11 +366,11 @@ static size_t argc_params(paralist *params) {
 /* Sentinel for argument list */
 static const char *argv_sentinel = "step";
 
-/* turn paralist into argc/argv style argument list */
-static char **argv_params(paralist *params, size_t argc) {
+/* turn paralist into argc/argv style argument list, allocated from <arena> */
+static char **argv_params(pj_arena *arena, paralist *params, size_t argc) {
     char **argv;
     size_t i = 0;
-    argv = static_cast<char **>(calloc(argc, sizeof(char *)));
+    argv = static_cast<char **>(pj_arena_alloc(arena, argc * sizeof(char *)));
     if (nullptr == argv)
         return nullptr;
     for (; params != nullptr; params = params->next)
@@ -404,12 +479,12 @@ PJ *OPERATION(pipeline, 0) {
 
     argc = (int)argc_params(P->params);
     auto pipeline = static_cast<struct Pipeline *>(P->opaque);
-    pipeline->argv = argv = argv_params(P->params, argc);
+    pipeline->argv = argv = argv_params(P->arena, P->params, argc);
     if (nullptr == argv)
         return destructor(P, PROJ_ERR_INVALID_OP /* ENOMEM */);
 
-    pipeline->current_argv = current_argv =
-        static_cast<char **>(calloc(argc, sizeof(char *)));
+    pipeline->current_argv = current_argv = static_cast<char **>(
+        pj_arena_alloc(P->arena, argc * sizeof(char *)));
     if (nullptr == current_argv)
         return destructor(P, PROJ_ERR_OTHER /*ENOMEM*/);
 
@@ -629,6 +704,33 @@ PJ *OPERATION(pipeline, 0) {
     proj_log_trace(
         P, "Pipeline: %d steps built. Determining i/o characteristics", nsteps);
 
+    /* The units of the steps may have changed above, so select their batch
+     * methods again. The pipeline itself can go through the steps with whole
+     * arrays of coordinates if some of them have a batch method, unless push
+     * and pop steps need the coordinates to go through it one at a time. */
+    bool fwd_array = false;
+    bool inv_array = false;
+    bool has_push_pop = false;
+    for (auto &step : pipeline->steps) {
+        PJ *Q = step.pj;
+        Q->trans_fwd4d_array = pj_fwd4d_array_function(Q);
+        Q->trans_inv4d_array = pj_inv4d_array_function(Q);
+        if (Q->fwd4d == push || Q->fwd4d == pop)
+            has_push_pop = true;
+        if (!step.omit_fwd && (Q->inverted ? Q->trans_inv4d_array
+                                           : Q->trans_fwd4d_array))
+            fwd_array = true;
+        if (!step.omit_inv && (Q->inverted ? Q->trans_fwd4d_array
+                                           : Q->trans_inv4d_array))
+            inv_array = true;
+    }
+    if (!has_push_pop) {
+        if (fwd_array)
+            P->fwd4d_array = pipeline_forward_4d_array;
+        if (inv_array && P->inv4d)
+            P->inv4d_array = pipeline_reverse_4d_array;
+    }
+
     /* Determine forward input (= reverse output) data type */
     P->left = pj_left(pipeline->steps.front().pj);
 
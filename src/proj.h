@@ -578,6 +578,11 @@ void PROJ_DLL proj_grid_cache_set_ttl(PJ_CONTEXT *ctx, int ttl_seconds);
 
 void PROJ_DLL proj_grid_cache_clear(PJ_CONTEXT *ctx);
 
+void PROJ_DLL proj_grid_availability_cache_set_ttl(PJ_CONTEXT *ctx,
+                                                   int ttl_seconds);
+
+void PROJ_DLL proj_grid_availability_cache_clear(void);
+
 int PROJ_DLL proj_is_download_needed(PJ_CONTEXT *ctx,
                                      const char *url_or_filename,
                                      int ignore_ttl_setting);
@@ -587,6 +592,11 @@ int PROJ_DLL proj_download_file(PJ_CONTEXT *ctx, const char *url_or_filename,
                                                     void *user_data),
                                 void *user_data);
 
+int PROJ_DLL proj_grid_extract_subset(PJ_CONTEXT *ctx, const char *grid_name,
+                                      double west, double south, double east,
+                                      double north,
+                                      const char *output_filename);
+
 /*! @cond Doxygen_Suppress */
 
 /* Manage the transformation definition object PJ */
@@ -598,6 +608,10 @@ PJ PROJ_DLL *proj_create_crs_to_crs_from_pj(PJ_CONTEXT *ctx,
                                             const PJ *source_crs,
                                             const PJ *target_crs, PJ_AREA *area,
                                             const char *const *options);
+int PROJ_DLL proj_create_crs_to_crs_from_pj_array(
+    PJ_CONTEXT *ctx, int count, const PJ *const *source_crs,
+    const PJ *const *target_crs, PJ_AREA *area, const char *const *options,
+    PJ **out_transformations);
 /*! @endcond */
 PJ PROJ_DLL *proj_normalize_for_visualization(PJ_CONTEXT *ctx, const PJ *obj);
 /*! @cond Doxygen_Suppress */
@@ -640,6 +654,26 @@ int PROJ_DLL proj_trans_bounds(PJ_CONTEXT *context, PJ *P,
                                double xmax, double ymax, double *out_xmin,
                                double *out_ymin, double *out_xmax,
                                double *out_ymax, int densify_pts);
+int PROJ_DLL proj_trans_bounds_adaptive(PJ_CONTEXT *context, PJ *P,
+                                        PJ_DIRECTION direction, double xmin,
+                                        double ymin, double xmax, double ymax,
+                                        double *out_xmin, double *out_ymin,
+                                        double *out_xmax, double *out_ymax,
+                                        double tolerance);
+int PROJ_DLL proj_trans_bounds_grid(PJ_CONTEXT *context, PJ *P,
+                                    PJ_DIRECTION direction, double xmin,
+                                    double ymin, double cell_width,
+                                    double cell_height, int count_x,
+                                    int count_y, double *out_xmin,
+                                    double *out_ymin, double *out_xmax,
+                                    double *out_ymax, int densify_pts,
+                                    const char *const *options);
+int PROJ_DLL proj_trans_warp_grid(PJ_CONTEXT *context, PJ *P,
+                                  PJ_DIRECTION direction,
+                                  const double geotransform[6], int width,
+                                  int height, double error_threshold,
+                                  double *out_x, double *out_y,
+                                  const char *const *options);
 /*! @cond Doxygen_Suppress */
 
 /* Initializers */
@@ -253,6 +253,7 @@ struct PJconsts;
 union PJ_COORD;
 struct geod_geodesic;
 struct ARG_list;
+struct pj_arena;
 struct PJ_REGION_S;
 typedef struct PJ_REGION_S PJ_Region;
 typedef struct ARG_list paralist; /* parameter list */
@@ -302,12 +303,25 @@ PJ_OPERATOR:
     A function taking a reference to a PJ_COORD and a pointer-to-PJ as args,
 applying the PJ to the PJ_COORD, and modifying in-place the passed PJ_COORD.
 
+PJ_ARRAY_OPERATOR:
+
+    The PJ_OPERATOR of a PJ applied to an array of PJ_COORD at once. The
+coordinates that fail to transform are set to proj_coord_error(), and the
+error code, if any, is stored in the corresponding element of the int array,
+which is left untouched for the other coordinates.
+
 *****************************************************************************/
 typedef PJ *(*PJ_CONSTRUCTOR)(PJ *);
 typedef PJ *(*PJ_DESTRUCTOR)(PJ *, int);
 typedef void (*PJ_OPERATOR)(PJ_COORD &, PJ *);
+typedef void (*PJ_ARRAY_OPERATOR)(PJ_COORD *, size_t, PJ *, int *);
 /****************************************************************************/
 
+PJ_OPERATOR pj_fwd4d_function(const PJ *P);
+PJ_OPERATOR pj_inv4d_function(const PJ *P);
+PJ_ARRAY_OPERATOR pj_fwd4d_array_function(const PJ *P);
+PJ_ARRAY_OPERATOR pj_inv4d_array_function(const PJ *P);
+
 /* datum_type values */
 #define PJD_UNKNOWN 0
 #define PJD_3PARAM 1
@@ -315,6 +329,12 @@ typedef void (*PJ_OPERATOR)(PJ_COORD &, PJ *);
 #define PJD_GRIDSHIFT 3
 #define PJD_WGS84 4 /* WGS84 (or anything considered equivalent) */
 
+PJ *pj_clone_not_instantiated(PJ_CONTEXT *ctx, const PJ *obj);
+
+NS_PROJ_START
+class GridCoverageMask;
+NS_PROJ_END
+
 struct PJCoordOperation {
   public:
     int idxInOriginalList;
@@ -339,7 +359,11 @@ struct PJCoordOperation {
     double maxxDst = 0.0;
     double maxyDst = 0.0;
 
+    // pj may be only an ISO-19111 object, not yet instantiated as a PROJ
+    // pipeline (cf isPJInstantiated). Use instantiatedPJ() to transform
+    // coordinates with it.
     PJ *pj = nullptr;
+    bool isPJInstantiated = true;
     std::string name{};
     double accuracy = -1.0;
     double pseudoArea = 0.0;
@@ -377,7 +401,10 @@ struct PJCoordOperation {
           minySrc(other.minySrc), maxxSrc(other.maxxSrc),
           maxySrc(other.maxySrc), minxDst(other.minxDst),
           minyDst(other.minyDst), maxxDst(other.maxxDst),
-          maxyDst(other.maxyDst), pj(proj_clone(ctx, other.pj)),
+          maxyDst(other.maxyDst),
+          pj(other.isPJInstantiated ? proj_clone(ctx, other.pj)
+                                    : pj_clone_not_instantiated(ctx, other.pj)),
+          isPJInstantiated(other.isPJInstantiated),
           name(std::move(other.name)), accuracy(other.accuracy),
           pseudoArea(other.pseudoArea), areaName(other.areaName),
           isOffshore(other.isOffshore),
@@ -394,22 +421,27 @@ struct PJCoordOperation {
           pjDstGeocentricToLonLat(
               other.pjDstGeocentricToLonLat
                   ? proj_clone(ctx, other.pjDstGeocentricToLonLat)
-                  : nullptr) {}
+                  : nullptr),
+          gridCoverageMaskComputed(other.gridCoverageMaskComputed),
+          gridCoverageMask(other.gridCoverageMask) {}
 
     PJCoordOperation(PJCoordOperation &&other)
         : idxInOriginalList(other.idxInOriginalList), minxSrc(other.minxSrc),
           minySrc(other.minySrc), maxxSrc(other.maxxSrc),
           maxySrc(other.maxySrc), minxDst(other.minxDst),
           minyDst(other.minyDst), maxxDst(other.maxxDst),
-          maxyDst(other.maxyDst), name(std::move(other.name)),
-          accuracy(other.accuracy), pseudoArea(other.pseudoArea),
+          maxyDst(other.maxyDst), isPJInstantiated(other.isPJInstantiated),
+          name(std::move(other.name)), accuracy(other.accuracy),
+          pseudoArea(other.pseudoArea),
           areaName(std::move(other.areaName)), isOffshore(other.isOffshore),
           isUnknownAreaName(other.isUnknownAreaName),
           isPriorityOp(other.isPriorityOp),
           srcIsLonLatDegree(other.srcIsLonLatDegree),
           srcIsLatLonDegree(other.srcIsLatLonDegree),
           dstIsLonLatDegree(other.dstIsLonLatDegree),
-          dstIsLatLonDegree(other.dstIsLatLonDegree) {
+          dstIsLatLonDegree(other.dstIsLatLonDegree),
+          gridCoverageMaskComputed(other.gridCoverageMaskComputed),
+          gridCoverageMask(std::move(other.gridCoverageMask)) {
         pj = other.pj;
         other.pj = nullptr;
         pjSrcGeocentricToLonLat = other.pjSrcGeocentricToLonLat;
@@ -439,10 +471,23 @@ struct PJCoordOperation {
 
     bool isInstantiable() const;
 
+    // Returns false if coord is known to be outside of the grids used by the
+    // operation, in which case it would fail to transform it.
+    bool mayBeCoveredByGrids(PJ_DIRECTION direction,
+                             const PJ_COORD &coord) const;
+
+    PJ *instantiatedPJ();
+
   private:
     static constexpr int INSTANTIABLE_STATUS_UNKNOWN =
         -1; // must be different from 0(=false) and 1(=true)
     mutable int isInstantiableCached = INSTANTIABLE_STATUS_UNKNOWN;
+
+    // Coverage of the grids, lazily computed by mayBeCoveredByGrids().
+    // Shared between copies of the operation.
+    mutable bool gridCoverageMaskComputed = false;
+    mutable std::shared_ptr<const NS_PROJ::GridCoverageMask>
+        gridCoverageMask{};
 };
 
 enum class TMercAlgo {
@@ -470,6 +515,8 @@ struct PJconsts {
     const char *short_name = nullptr; /* From pj_list.h */
     const char *descr = nullptr; /* From pj_list.h or individual PJ_*.c file */
     paralist *params = nullptr;  /* Parameter list */
+    struct pj_arena *arena =
+        nullptr; /* Storage of params and other allocations freed with P */
     char *def_full =
         nullptr; /* Full textual definition (usually 0 - set by proj_pj_info) */
     PJconsts *parent = nullptr; /* Parent PJ of pipeline steps - nullptr if not
@@ -509,6 +556,26 @@ struct PJconsts {
     PJ_OPERATOR fwd4d = nullptr;
     PJ_OPERATOR inv4d = nullptr;
 
+    /* Optional batch equivalents of fwd4d and inv4d, which also reject the */
+    /* input coordinates that pj_fwd4d() and pj_inv4d() would              */
+    PJ_ARRAY_OPERATOR fwd4d_array = nullptr;
+    PJ_ARRAY_OPERATOR inv4d_array = nullptr;
+
+    /* Equivalents of pj_fwd4d() and pj_inv4d() for this object, selected */
+    /* once the operation is set up by pj_fwd4d_function() and             */
+    /* pj_inv4d_function(). When set, proj_trans() calls them directly,    */
+    /* so they must be reset if the object later gets alternative          */
+    /* operations or a coordinate epoch.                                   */
+    PJ_OPERATOR trans_fwd4d = nullptr;
+    PJ_OPERATOR trans_inv4d = nullptr;
+
+    /* Batch equivalents of trans_fwd4d and trans_inv4d, selected by       */
+    /* pj_fwd4d_array_function() and pj_inv4d_array_function(), or nullptr */
+    /* if the operation has no usable batch method. Only used when         */
+    /* trans_fwd4d is set.                                                 */
+    PJ_ARRAY_OPERATOR trans_fwd4d_array = nullptr;
+    PJ_ARRAY_OPERATOR trans_inv4d_array = nullptr;
+
     PJ_DESTRUCTOR destructor = nullptr;
     void (*reassign_context)(PJ *, PJ_CONTEXT *) = nullptr;
 
@@ -665,6 +732,14 @@ struct PJconsts {
     // cache pj_get_type() result to help for repeated calls to proj_factors()
     mutable PJ_TYPE type = PJ_TYPE_UNKNOWN;
 
+    // cache of the axis order of the target CRS (-1 if unknown), and of the
+    // position of the poles, used by proj_trans_bounds(). Indexed by 0 for
+    // the forward direction and 1 for the inverse one.
+    int boundsLonLatOrder[2] = {-1, -1};
+    bool boundsPolesComputed[2] = {false, false};
+    PJ_XY boundsNorthPole[2] = {};
+    PJ_XY boundsSouthPole[2] = {};
+
     /*************************************************************************************
      proj_create_crs_to_crs() alternative coordinate operations
     **************************************************************************************/
@@ -690,6 +765,7 @@ struct PJconsts {
 struct ARG_list {
     paralist *next;
     char used;
+    char in_arena; /* allocated from a pj_arena, and not freed on its own */
 #if (defined(__GNUC__) && __GNUC__ >= 8) ||                                    \
     (defined(__clang__) && __clang_major__ >= 9)
     char param[]; /* variable-length member */
@@ -805,6 +881,15 @@ struct pj_ctx {
 
     bool defer_grid_opening = false; // set transiently by pj_obj_create()
 
+    // PJ instantiated by PROJStringParser::createFromPROJString() to validate
+    // a PROJ string, and that string. pj_obj_create() reuses it instead of
+    // instantiating the same string again, as done by proj_create().
+    // They are only kept while keepValidatedPJ is set, that is during a
+    // single proj_create() call.
+    bool keepValidatedPJ = false;
+    std::string validatedPROJString{};
+    PJ *validatedPJ = nullptr;
+
     projFileApiCallbackAndData fileApi{};
     std::string custom_sqlite3_vfs_name{};
     std::string user_writable_directory{};
@@ -815,6 +900,8 @@ struct pj_ctx {
     projNetworkCallbacksAndData networking{};
     std::string ca_bundle_path{};
     projGridChunkCache gridChunkCache{};
+    int gridAvailabilityCacheTTL =
+        0; // in seconds. 0 = disabled, negative value = no expiration
     TMercAlgo defaultTmercAlgo =
         TMercAlgo::PODER_ENGSAGER; // can be overridden by content of proj.ini
     // END ini file settings
@@ -889,6 +976,7 @@ PROJVALUE PROJ_DLL pj_param(PJ_CONTEXT *ctx, paralist *, const char *);
 paralist PROJ_DLL *pj_param_exists(paralist *list, const char *parameter);
 paralist PROJ_DLL *pj_mkparam(const char *);
 paralist *pj_mkparam_ws(const char *str, const char **next_str);
+paralist *pj_mkparam_arena(struct pj_arena *arena, const char *str);
 
 int PROJ_DLL pj_ell_set(PJ_CONTEXT *ctx, paralist *, double *, double *);
 int pj_datum_set(PJ_CONTEXT *, paralist *, PJ *);
@@ -901,6 +989,10 @@ paralist *pj_expand_init(PJ_CONTEXT *ctx, paralist *init);
 
 void *free_params(PJ_CONTEXT *ctx, paralist *start, int errlev);
 
+struct pj_arena *pj_arena_create(size_t initial_size);
+void *pj_arena_alloc(struct pj_arena *arena, size_t size);
+void pj_arena_destroy(struct pj_arena *arena);
+
 double *pj_enfn(double);
 double pj_mlfn(double, double, double, const double *);
 double pj_inv_mlfn(double, const double *);
@@ -959,7 +1051,8 @@ pj_create_prepared_operations(PJ_CONTEXT *ctx, const PJ *source_crs,
 int pj_get_suggested_operation(PJ_CONTEXT *ctx,
                                const std::vector<PJCoordOperation> &opList,
                                const int iExcluded[2], bool skipNonInstantiable,
-                               PJ_DIRECTION direction, PJ_COORD coord);
+                               bool skipOutsideGrids, PJ_DIRECTION direction,
+                               PJ_COORD coord);
 
 const PJ_UNITS *pj_list_linear_units();
 const PJ_UNITS *pj_list_angular_units();
@@ -969,12 +1062,19 @@ void pj_clear_vgridshift_knowngrids_cache();
 void pj_clear_gridshift_knowngrids_cache();
 
 void pj_clear_sqlite_cache();
+void pj_clear_grid_availability_cache();
 
 PJ_LP pj_generic_inverse_2d(PJ_XY xy, PJ *P, PJ_LP lpInitial,
                             double deltaXYTolerance);
 
 PJ *pj_obj_create(PJ_CONTEXT *ctx, const NS_PROJ::util::BaseObjectNNPtr &objIn);
 
+PJ *pj_obj_create_not_instantiated(
+    PJ_CONTEXT *ctx, const NS_PROJ::util::BaseObjectNNPtr &objIn);
+
+PJ *pj_list_get_not_instantiated(PJ_CONTEXT *ctx, const PJ_OBJ_LIST *result,
+                                 int index);
+
 /*****************************************************************************/
 /*                                                                           */
 /*                              proj_api.h                                   */
@@ -240,6 +240,8 @@
     internal_proj_create_conversion_wagner_vii
 #define proj_create_crs_to_crs internal_proj_create_crs_to_crs
 #define proj_create_crs_to_crs_from_pj internal_proj_create_crs_to_crs_from_pj
+#define proj_create_crs_to_crs_from_pj_array                                   \
+    internal_proj_create_crs_to_crs_from_pj_array
 #define proj_create_cs internal_proj_create_cs
 #define proj_create_derived_geographic_crs                                     \
     internal_proj_create_derived_geographic_crs
@@ -343,11 +345,16 @@
 #define proj_get_target_crs internal_proj_get_target_crs
 #define proj_get_type internal_proj_get_type
 #define proj_get_units_from_database internal_proj_get_units_from_database
+#define proj_grid_availability_cache_clear                                     \
+    internal_proj_grid_availability_cache_clear
+#define proj_grid_availability_cache_set_ttl                                   \
+    internal_proj_grid_availability_cache_set_ttl
 #define proj_grid_cache_clear internal_proj_grid_cache_clear
 #define proj_grid_cache_set_enable internal_proj_grid_cache_set_enable
 #define proj_grid_cache_set_filename internal_proj_grid_cache_set_filename
 #define proj_grid_cache_set_max_size internal_proj_grid_cache_set_max_size
 #define proj_grid_cache_set_ttl internal_proj_grid_cache_set_ttl
+#define proj_grid_extract_subset internal_proj_grid_extract_subset
 #define proj_grid_get_info_from_database                                       \
     internal_proj_grid_get_info_from_database
 #define proj_grid_info internal_proj_grid_info
@@ -419,9 +426,12 @@
 #define proj_trans internal_proj_trans
 #define proj_trans_array internal_proj_trans_array
 #define proj_trans_bounds internal_proj_trans_bounds
+#define proj_trans_bounds_adaptive internal_proj_trans_bounds_adaptive
+#define proj_trans_bounds_grid internal_proj_trans_bounds_grid
 #define proj_trans_generic internal_proj_trans_generic
 #define proj_trans_get_last_used_operation                                     \
     internal_proj_trans_get_last_used_operation
+#define proj_trans_warp_grid internal_proj_trans_warp_grid
 #define proj_unit_list_destroy internal_proj_unit_list_destroy
 #define proj_uom_get_info_from_database internal_proj_uom_get_info_from_database
 #define proj_xy_dist internal_proj_xy_dist
@@ -10,6 +10,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <limits>
 
 #include "proj.h"
@@ -46,6 +48,9 @@
 #define ISEA_STD_LAT 1.01722196792335072101
 #define ISEA_STD_LONG .19634954084936207740
 
+/* 2^53, largest sequence number exactly representable as a double */
+#define ISEA_MAX_SEQNUM 9007199254740992.0
+
 namespace { // anonymous namespace
 struct hex {
     int iso;
@@ -162,7 +167,7 @@ struct isea_dgg {
     int output;    /* an isea_address_form */
     int triangle;  /* triangle of last transformed point */
     int quad;      /* quad of last transformed point */
-    unsigned long serial;
+    int64_t serial;
 };
 } // anonymous namespace
 
@@ -281,15 +286,61 @@ static struct isea_pt isea_triangle_xy(int triangle) {
     return c;
 }
 
-/* snyder eq 14 */
-static double sph_azimuth(double f_lon, double f_lat, double t_lon,
-                          double t_lat) {
-    double az;
+namespace { // anonymous namespace
+/* constants depending only on the triangle */
+struct isea_triangle_constants {
+    double sin_lon, cos_lon, sin_lat, cos_lat; /* center of the triangle */
+    double az_offset;                          /* az_adjustment() */
+};
+} // anonymous namespace
+
+namespace { // anonymous namespace
+/*
+ * constants of isea_snyder_forward() and isea_snyder_inverse(), computed
+ * once by isea_get_constants()
+ */
+struct isea_constants {
+    double theta, g, G;
+    double cot_theta, tan_g, sin_G, cos_G, cos_g;
+    double cos_g_max; /* cos(g + tolerance) to reject a triangle */
+    double Rprime;
+    struct isea_triangle_constants tri[21];
+};
+} // anonymous namespace
+
+static struct isea_constants isea_compute_constants() {
+    struct isea_constants k;
+    const struct snyder_constants c = constants[SNYDER_POLY_ICOSAHEDRON];
+
+    k.theta = PJ_TORAD(c.theta);
+    k.g = PJ_TORAD(c.g);
+    k.G = PJ_TORAD(c.G);
+    k.cot_theta = 1.0 / tan(k.theta);
+    k.tan_g = tan(k.g);
+    k.sin_G = sin(k.G);
+    k.cos_G = cos(k.G);
+    k.cos_g = cos(k.g);
+    k.cos_g_max = cos(k.g + 0.000005); /* TODO DBL_EPSILON */
+
+    /* eq 5 */
+    /* Rprime = 0.9449322893 * R; */
+    /* R' in the paper is for the truncated */
+    k.Rprime = 0.91038328153090290025;
+
+    for (int i = 0; i <= 20; i++) {
+        const struct isea_geo center = icostriangles[i];
+        k.tri[i].sin_lon = sin(center.longitude);
+        k.tri[i].cos_lon = cos(center.longitude);
+        k.tri[i].sin_lat = sin(center.lat);
+        k.tri[i].cos_lat = cos(center.lat);
+        k.tri[i].az_offset = i == 0 ? 0.0 : az_adjustment(i);
+    }
+    return k;
+}
 
-    az = atan2(cos(t_lat) * sin(t_lon - f_lon),
-               cos(f_lat) * sin(t_lat) -
-                   sin(f_lat) * cos(t_lat) * cos(t_lon - f_lon));
-    return az;
+static const struct isea_constants &isea_get_constants() {
+    static const struct isea_constants k = isea_compute_constants();
+    return k;
 }
 
 #ifdef _MSC_VER
@@ -300,71 +351,65 @@ static double sph_azimuth(double f_lon, double f_lat, double t_lon,
 
 /* coord needs to be in radians */
 static int isea_snyder_forward(struct isea_geo *ll, struct isea_pt *out) {
-    int i;
-
     /*
-     * spherical distance from center of polygon face to any of its
+     * g: spherical distance from center of polygon face to any of its
      * vertices on the globe
-     */
-    double g;
-
-    /*
-     * spherical angle between radius vector to center and adjacent edge
+     *
+     * G: spherical angle between radius vector to center and adjacent edge
      * of spherical polygon on the globe
+     *
+     * theta: plane angle between radius vector to center and adjacent edge
+     * of plane polygon
      */
-    double G;
-
-    /*
-     * plane angle between radius vector to center and adjacent edge of
-     * plane polygon
-     */
-    double theta;
+    const struct isea_constants &k = isea_get_constants();
 
     /* additional variables from snyder */
-    double q, H, Ag, Azprime, Az, dprime, f, rho, x, y;
-
-    /* variables used to store intermediate results */
-    double cot_theta, tan_g, az_offset;
+    double z, q, H, Ag, Azprime, Az, dprime, f, rho, x, y;
 
     /* how many multiples of 60 degrees we adjust the azimuth */
     int Az_adjust_multiples;
 
-    struct snyder_constants c;
+    const double sin_lat = sin(ll->lat);
+    const double cos_lat = cos(ll->lat);
+    const double sin_lon = sin(ll->longitude);
+    const double cos_lon = cos(ll->longitude);
+
+    /*
+     * step 1, for all the triangles at once: cosine of the spherical
+     * distance from the center of the triangle. This loop has no branches,
+     * so that it can be vectorized, and most triangles are then rejected
+     * without any further computation.
+     */
+    double sin_dlon[21], cos_dlon[21], cos_z[21];
+    for (int i = 1; i <= 20; i++) {
+        const struct isea_triangle_constants &t = k.tri[i];
+        sin_dlon[i] = sin_lon * t.cos_lon - cos_lon * t.sin_lon;
+        cos_dlon[i] = cos_lon * t.cos_lon + sin_lon * t.sin_lon;
+        cos_z[i] = t.sin_lat * sin_lat + t.cos_lat * cos_lat * cos_dlon[i];
+    }
 
     /*
      * TODO by locality of reference, start by trying the same triangle
      * as last time
      */
 
-    /* TODO put these constants in as radians to begin with */
-    c = constants[SNYDER_POLY_ICOSAHEDRON];
-    theta = PJ_TORAD(c.theta);
-    g = PJ_TORAD(c.g);
-    G = PJ_TORAD(c.G);
-
-    for (i = 1; i <= 20; i++) {
-        double z;
-        struct isea_geo center;
+    for (int i = 1; i <= 20; i++) {
+        const struct isea_triangle_constants &t = k.tri[i];
 
-        center = icostriangles[i];
-
-        /* step 1 */
-        z = acos(sin(center.lat) * sin(ll->lat) +
-                 cos(center.lat) * cos(ll->lat) *
-                     cos(ll->longitude - center.longitude));
         /* not on this triangle */
-        if (z > g + 0.000005) { /* TODO DBL_EPSILON */
+        if (!(cos_z[i] >= k.cos_g_max)) {
             continue;
         }
+        z = acos(std::min(cos_z[i], 1.0));
 
-        Az = sph_azimuth(center.longitude, center.lat, ll->longitude, ll->lat);
+        /* snyder eq 14 */
+        Az = atan2(cos_lat * sin_dlon[i],
+                   t.cos_lat * sin_lat - t.sin_lat * cos_lat * cos_dlon[i]);
 
         /* step 2 */
 
         /* This calculates "some" vertex coordinate */
-        az_offset = az_adjustment(i);
-
-        Az -= az_offset;
+        Az -= t.az_offset;
 
         /* TODO I don't know why we do this.  It's not in snyder */
         /* maybe because we should have picked a better vertex */
@@ -391,12 +436,10 @@ static int isea_snyder_forward(struct isea_geo *ll, struct isea_pt *out) {
         }
 
         /* step 3 */
-        cot_theta = 1.0 / tan(theta);
-        tan_g = tan(g); /* TODO this is a constant */
 
         /* Calculate q from eq 9. */
         /* TODO cot_theta is cot(30) */
-        q = atan2(tan_g, cos(Az) + sin(Az) * cot_theta);
+        q = atan2(k.tan_g, cos(Az) + sin(Az) * k.cot_theta);
 
         /* not in this triangle */
         if (z > q + 0.000005) {
@@ -406,31 +449,27 @@ static int isea_snyder_forward(struct isea_geo *ll, struct isea_pt *out) {
 
         /* Apply equations 5-8 and 10-12 in order */
 
-        /* eq 5 */
-        /* Rprime = 0.9449322893 * R; */
-        /* R' in the paper is for the truncated */
-        const double Rprime = 0.91038328153090290025;
-
         /* eq 6 */
-        H = acos(sin(Az) * sin(G) * cos(g) - cos(Az) * cos(G));
+        H = acos(sin(Az) * k.sin_G * k.cos_g - cos(Az) * k.cos_G);
 
         /* eq 7 */
         /* Ag = (Az + G + H - DEG180) * M_PI * R * R / DEG180; */
-        Ag = Az + G + H - DEG180;
+        Ag = Az + k.G + H - DEG180;
 
         /* eq 8 */
-        Azprime = atan2(2.0 * Ag,
-                        Rprime * Rprime * tan_g * tan_g - 2.0 * Ag * cot_theta);
+        Azprime = atan2(2.0 * Ag, k.Rprime * k.Rprime * k.tan_g * k.tan_g -
+                                      2.0 * Ag * k.cot_theta);
 
         /* eq 10 */
         /* cot(theta) = 1.73205080756887729355 */
-        dprime = Rprime * tan_g / (cos(Azprime) + sin(Azprime) * cot_theta);
+        dprime =
+            k.Rprime * k.tan_g / (cos(Azprime) + sin(Azprime) * k.cot_theta);
 
         /* eq 11 */
-        f = dprime / (2.0 * Rprime * sin(q / 2.0));
+        f = dprime / (2.0 * k.Rprime * sin(q / 2.0));
 
         /* eq 12 */
-        rho = 2.0 * Rprime * f * sin(z / 2.0);
+        rho = 2.0 * k.Rprime * f * sin(z / 2.0);
 
         /*
          * add back the same 60 degree multiple adjustment from step
@@ -471,6 +510,99 @@ static int isea_snyder_forward(struct isea_geo *ll, struct isea_pt *out) {
 #pragma warning(pop)
 #endif
 
+/*
+ * inverse of isea_snyder_forward(): pt is in the output coordinates of
+ * isea_snyder_forward() for triangle tri
+ */
+static struct isea_geo isea_snyder_inverse(int tri, const struct isea_pt *pt) {
+    const struct isea_constants &k = isea_get_constants();
+    const struct isea_triangle_constants &t = k.tri[tri];
+    struct isea_geo ll;
+
+    const double rho = sqrt(pt->x * pt->x + pt->y * pt->y);
+    double Azprime = atan2(pt->x, pt->y);
+    if (Azprime < 0.0) {
+        Azprime += 2.0 * M_PI;
+    }
+
+    /* reduce Azprime to the range of 0 to 120 degrees, as in the forward */
+    int Az_adjust_multiples = 0;
+    while (Azprime > DEG120 + DBL_EPSILON) {
+        Azprime -= DEG120;
+        Az_adjust_multiples++;
+    }
+
+    /* eq 8, solved for Ag */
+    const double Ag = k.Rprime * k.Rprime * k.tan_g * k.tan_g * sin(Azprime) /
+                      (2.0 * (cos(Azprime) + sin(Azprime) * k.cot_theta));
+
+    /*
+     * eq 6 and 7 cannot be solved for Az directly, so use Newton's method,
+     * starting from Azprime, which is close
+     */
+    double Az = Azprime;
+    for (int iter = 0; iter < 20; iter++) {
+        const double u = sin(Az) * k.sin_G * k.cos_g - cos(Az) * k.cos_G;
+        const double H = acos(u);
+        const double F = Az + k.G + H - DEG180 - Ag;
+        const double dH = -(cos(Az) * k.sin_G * k.cos_g + sin(Az) * k.cos_G) /
+                          sqrt(std::max(1.0 - u * u, 1e-30));
+        const double delta = F / (1.0 + dH);
+        Az -= delta;
+        if (fabs(delta) < 1e-15) {
+            break;
+        }
+    }
+
+    /* eq 9 */
+    const double q = atan2(k.tan_g, cos(Az) + sin(Az) * k.cot_theta);
+
+    /* eq 10 and 11 */
+    const double dprime =
+        k.Rprime * k.tan_g / (cos(Azprime) + sin(Azprime) * k.cot_theta);
+    const double f = dprime / (2.0 * k.Rprime * sin(q / 2.0));
+
+    /* eq 12, solved for z */
+    const double z =
+        2.0 * asin(std::min(rho / (2.0 * k.Rprime * f), 1.0));
+
+    /* undo the adjustments of step 2 */
+    Az += DEG120 * Az_adjust_multiples + t.az_offset;
+
+    /* point at distance z and azimuth Az from the center of the triangle */
+    const double sin_z = sin(z);
+    const double cos_z = cos(z);
+    const double sin_lat = t.sin_lat * cos_z + t.cos_lat * sin_z * cos(Az);
+    ll.lat = asin(std::max(-1.0, std::min(sin_lat, 1.0)));
+    ll.longitude =
+        icostriangles[tri].longitude +
+        atan2(sin(Az) * sin_z * t.cos_lat, cos_z - t.sin_lat * sin_lat);
+    while (ll.longitude > M_PI)
+        ll.longitude -= 2 * M_PI;
+    while (ll.longitude < -M_PI)
+        ll.longitude += 2 * M_PI;
+
+    return ll;
+}
+
+/*
+ * how far a point, in the output coordinates of isea_snyder_forward(), is
+ * outside of its triangle, or a negative value if it is inside
+ */
+static double isea_snyder_outside(const struct isea_pt *pt) {
+    const struct isea_constants &k = isea_get_constants();
+
+    /*
+     * the vertices of the triangle are in the directions of azimuths 0, 120
+     * and 240 degrees, and its edges at distance R' tan(g) / 2 of its center
+     */
+    const double cos30 = .86602540378443864672;
+    const double d0 = cos30 * pt->x + 0.5 * pt->y;
+    const double d1 = -pt->y;
+    const double d2 = -cos30 * pt->x + 0.5 * pt->y;
+    return std::max(d0, std::max(d1, d2)) - k.Rprime * k.tan_g / 2.0;
+}
+
 /*
  * return the new coordinates of any point in original coordinate system.
  * Define a point (newNPold) in original coordinate system as the North Pole in
@@ -607,6 +739,42 @@ static int isea_transform(struct isea_dgg *g, struct isea_geo *in,
     return tri;
 }
 
+/*
+ * isea_ctran() is a rotation of the sphere. Compute its matrix, whose
+ * columns are the images of the unit vectors, so that isea_ctran_inverse()
+ * can apply its transpose.
+ */
+static void isea_ctran_matrix(struct isea_dgg *g, double m[3][3]) {
+    struct isea_geo pole;
+    pole.lat = g->o_lat;
+    pole.longitude = g->o_lon;
+
+    const struct isea_geo axes[3] = {{0.0, 0.0}, {DEG90, 0.0}, {0.0, DEG90}};
+    for (int j = 0; j < 3; j++) {
+        struct isea_geo in = axes[j];
+        const struct isea_geo out = isea_ctran(&pole, &in, g->o_az);
+        m[0][j] = cos(out.lat) * cos(out.longitude);
+        m[1][j] = cos(out.lat) * sin(out.longitude);
+        m[2][j] = sin(out.lat);
+    }
+}
+
+/* inverse of isea_ctran(), m being computed by isea_ctran_matrix() */
+static struct isea_geo isea_ctran_inverse(const double m[3][3],
+                                          const struct isea_geo *in) {
+    const double v[3] = {cos(in->lat) * cos(in->longitude),
+                         cos(in->lat) * sin(in->longitude), sin(in->lat)};
+    double w[3];
+    for (int j = 0; j < 3; j++) {
+        w[j] = m[0][j] * v[0] + m[1][j] * v[1] + m[2][j] * v[2];
+    }
+
+    struct isea_geo out;
+    out.longitude = atan2(w[1], w[0]);
+    out.lat = asin(std::max(-1.0, std::min(w[2], 1.0)));
+    return out;
+}
+
 #define DOWNTRI(tri) (((tri - 1) / 5) % 2 == 1)
 
 static void isea_rotate(struct isea_pt *pt, double degrees) {
@@ -795,12 +963,12 @@ static int isea_dddi(struct isea_dgg *g, int quadz, struct isea_pt *pt,
             h.y = 0;
             h.z = 0;
         } else if (h.x == sidelength) {
+            /* lower right in next quad, like in isea_dddi_ap3odd() */
             quadz = quadz + 1;
             if (quadz == 11)
                 quadz = 6;
-            h.x = h.y + sidelength;
-            h.y = 0;
-            h.z = -h.x;
+            h.x = -h.y;
+            h.z = 0;
         } else if (h.y == -sidelength) {
             quadz -= 4;
             h.y = 0;
@@ -827,31 +995,31 @@ static int isea_ptdi(struct isea_dgg *g, int tri, struct isea_pt *pt,
 
 /* q2di to seqnum */
 
-static long isea_disn(struct isea_dgg *g, int quadz, struct isea_pt *di) {
-    long sidelength;
-    long sn, height;
-    long hexes;
+static int64_t isea_disn(struct isea_dgg *g, int quadz, struct isea_pt *di) {
+    int64_t sidelength;
+    int64_t sn, height;
+    int64_t hexes;
 
     if (quadz == 0) {
         g->serial = 1;
         return g->serial;
     }
     /* hexes in a quad */
-    hexes = lround(pow(static_cast<double>(g->aperture),
-                       static_cast<double>(g->resolution)));
+    hexes = llround(pow(static_cast<double>(g->aperture),
+                        static_cast<double>(g->resolution)));
     if (quadz == 11) {
         g->serial = 1 + 10 * hexes + 1;
         return g->serial;
     }
     if (g->aperture == 3 && g->resolution % 2 == 1) {
-        height = lround(floor((pow(g->aperture, (g->resolution - 1) / 2.0))));
-        sn = ((long)di->x) * height;
-        sn += ((long)di->y) / height;
+        height = llround(floor((pow(g->aperture, (g->resolution - 1) / 2.0))));
+        sn = ((int64_t)di->x) * height;
+        sn += ((int64_t)di->y) / height;
         sn += (quadz - 1) * hexes;
         sn += 2;
     } else {
-        sidelength = lround((pow(g->aperture, g->resolution / 2.0)));
-        sn = lround(
+        sidelength = llround((pow(g->aperture, g->resolution / 2.0)));
+        sn = llround(
             floor(((quadz - 1) * hexes + sidelength * di->x + di->y + 2)));
     }
 
@@ -977,6 +1145,111 @@ static struct isea_pt isea_forward(struct isea_dgg *g, struct isea_geo *in) {
     return out;
 }
 
+/*
+ * inverse of isea_transform() followed by isea_tri_plane(): point of the
+ * icosahedron frame whose plane coordinates are pt. Returns 0 if pt is not
+ * in any of the triangles of the icosahedron net.
+ */
+static int isea_plane_inverse(struct isea_dgg *g, const struct isea_pt *pt,
+                              struct isea_geo *geo) {
+    int best_tri = 1;
+    double best_outside = HUGE_VAL;
+    struct isea_pt best_local = {0.0, 0.0};
+
+    /* find the triangle containing the point */
+    for (int tri = 1; tri <= 20; tri++) {
+        const struct isea_pt tc = isea_triangle_xy(tri);
+        struct isea_pt local;
+        local.x = pt->x / g->radius - tc.x;
+        local.y = pt->y / g->radius - tc.y;
+        if (DOWNTRI(tri)) {
+            local.x = -local.x;
+            local.y = -local.y;
+        }
+        const double outside = isea_snyder_outside(&local);
+        if (outside < best_outside) {
+            best_tri = tri;
+            best_outside = outside;
+            best_local = local;
+        }
+    }
+    /*
+     * tolerate points on the edges of the triangles, up to the accuracy of
+     * isea_snyder_forward() which may put them slightly outside
+     */
+    if (!(best_outside <= 1e-5)) {
+        return 0;
+    }
+    g->triangle = best_tri;
+
+    *geo = isea_snyder_inverse(best_tri, &best_local);
+    return 1;
+}
+
+/*
+ * inverse of isea_forward() for the ISEA_SEQNUM output: center, in the
+ * icosahedron frame, of the cell of sequence number sn. Aperture 3 odd
+ * resolutions are not supported. Returns 0 if sn is not a valid cell.
+ */
+static int isea_sn_center(struct isea_dgg *g, int64_t sn,
+                          struct isea_geo *center) {
+    const int64_t hexes = llround(pow(static_cast<double>(g->aperture),
+                                      static_cast<double>(g->resolution)));
+    const int64_t sidelength = llround(pow(g->aperture, g->resolution / 2.0));
+    if (sn < 1 || sn > 10 * hexes + 2 || sidelength == 0) {
+        return 0;
+    }
+    if (sn == 1) {
+        *center = vertex[0];
+        return 1;
+    }
+    if (sn == 10 * hexes + 2) {
+        *center = vertex[11];
+        return 1;
+    }
+
+    /* inverse of isea_disn() */
+    const int quadz = static_cast<int>((sn - 2) / hexes) + 1;
+    const int64_t d = ((sn - 2) % hexes) / sidelength;
+    const int64_t i = ((sn - 2) % hexes) % sidelength;
+
+    /*
+     * inverse of isea_dddi(): the cell center has the iso coordinates
+     * (d, i - d, -i) in the hexagonal grid of hexbin2()
+     */
+    const double hexwidth = 1.0 / sidelength;
+    struct isea_pt v;
+    v.x = d * hexwidth * .86602540378443864672;
+    v.y = (i - d) * hexwidth + d * hexwidth / 2.0;
+    isea_rotate(&v, 30.0);
+
+    /*
+     * inverse of isea_ptdd(): the quad is made of an up triangle and a down
+     * triangle, so use the one the point is in
+     */
+    const int uptri = quadz <= 5 ? quadz : quadz + 5;
+    const int downtri = uptri + 5;
+    struct isea_pt up = v;
+    isea_rotate(&up, -60.0);
+    struct isea_pt down;
+    down.x = v.x - 0.5;
+    down.y = v.y - .86602540378443864672;
+    isea_rotate(&down, -240.0);
+
+    /* convert from isea standard triangle size */
+    up.x = (up.x - 0.5) / ISEA_SCALE;
+    up.y = (up.y - 2.0 * .14433756729740644112) / ISEA_SCALE;
+    down.x = (down.x - 0.5) / ISEA_SCALE;
+    down.y = (down.y - 2.0 * .14433756729740644112) / ISEA_SCALE;
+
+    if (isea_snyder_outside(&up) <= isea_snyder_outside(&down)) {
+        *center = isea_snyder_inverse(uptri, &up);
+    } else {
+        *center = isea_snyder_inverse(downtri, &down);
+    }
+    return 1;
+}
+
 /*
  * Proj 4 integration code follows
  */
@@ -986,6 +1259,7 @@ PROJ_HEAD(isea, "Icosahedral Snyder Equal Area") "\n\tSph";
 namespace { // anonymous namespace
 struct pj_isea_data {
     struct isea_dgg dgg;
+    double ctran[3][3]; /* matrix of isea_ctran(), see isea_ctran_matrix() */
 };
 } // anonymous namespace
 
@@ -1005,12 +1279,46 @@ static PJ_XY isea_s_forward(PJ_LP lp, PJ *P) { /* Spheroidal, forward */
         return proj_coord_error().xy;
     }
 
+    if (Q->dgg.output == ISEA_SEQNUM) {
+        xy.x = static_cast<double>(Q->dgg.serial);
+        xy.y = 0.0;
+        return xy;
+    }
+
     xy.x = out.x;
     xy.y = out.y;
 
     return xy;
 }
 
+static PJ_LP isea_s_inverse(PJ_XY xy, PJ *P) { /* Spheroidal, inverse */
+    PJ_LP lp = {0.0, 0.0};
+    struct pj_isea_data *Q = static_cast<struct pj_isea_data *>(P->opaque);
+    struct isea_geo out;
+
+    if (Q->dgg.output == ISEA_SEQNUM) {
+        if (!(xy.x >= 1 && xy.x <= ISEA_MAX_SEQNUM) || xy.x != floor(xy.x) ||
+            !isea_sn_center(&Q->dgg, static_cast<int64_t>(xy.x), &out)) {
+            proj_errno_set(P, PROJ_ERR_COORD_TRANSFM_OUTSIDE_PROJECTION_DOMAIN);
+            return proj_coord_error().lp;
+        }
+    } else {
+        struct isea_pt in;
+        in.x = xy.x;
+        in.y = xy.y;
+        if (!isea_plane_inverse(&Q->dgg, &in, &out)) {
+            proj_errno_set(P, PROJ_ERR_COORD_TRANSFM_OUTSIDE_PROJECTION_DOMAIN);
+            return proj_coord_error().lp;
+        }
+    }
+
+    out = isea_ctran_inverse(Q->ctran, &out);
+    lp.lam = out.longitude;
+    lp.phi = out.lat;
+
+    return lp;
+}
+
 PJ *PJ_PROJECTION(isea) {
     char *opt;
     struct pj_isea_data *Q = static_cast<struct pj_isea_data *>(
@@ -1019,8 +1327,6 @@ PJ *PJ_PROJECTION(isea) {
         return pj_default_destructor(P, PROJ_ERR_OTHER /*ENOMEM*/);
     P->opaque = Q;
 
-    // NOTE: if a inverse was needed, there is some material at
-    // https://brsr.github.io/2021/08/31/snyder-equal-area.html
     P->fwd = isea_s_forward;
     isea_grid_init(&Q->dgg);
 
@@ -1065,9 +1371,13 @@ PJ *PJ_PROJECTION(isea) {
             Q->dgg.output = ISEA_Q2DD;
         } else if (!strcmp(opt, "hex")) {
             Q->dgg.output = ISEA_HEX;
+        } else if (!strcmp(opt, "seqnum")) {
+            Q->dgg.output = ISEA_SEQNUM;
+            /* cell sequence numbers are not scaled nor offset */
+            P->right = PJ_IO_UNITS_WHATEVER;
         } else {
-            proj_log_error(P, _("Invalid value for mode: only plane, di, dd or "
-                                "hex are supported"));
+            proj_log_error(P, _("Invalid value for mode: only plane, di, dd, "
+                                "hex or seqnum are supported"));
             return pj_default_destructor(P,
                                          PROJ_ERR_INVALID_OP_ILLEGAL_ARG_VALUE);
         }
@@ -1089,6 +1399,30 @@ PJ *PJ_PROJECTION(isea) {
         Q->dgg.aperture = 3;
     }
 
+    /*
+     * the sequence numbers go up to 10 * aperture ^ resolution + 2, and are
+     * returned as doubles, so they must be exactly representable. The other
+     * modes do not output them.
+     */
+    const double hexes = pow(static_cast<double>(Q->dgg.aperture),
+                             static_cast<double>(Q->dgg.resolution));
+    if (Q->dgg.output == ISEA_SEQNUM && !(10 * hexes + 2 <= ISEA_MAX_SEQNUM)) {
+        proj_log_error(P, _("Invalid value for aperture and resolution: too "
+                            "many cells"));
+        return pj_default_destructor(P, PROJ_ERR_INVALID_OP_ILLEGAL_ARG_VALUE);
+    }
+
+    /*
+     * the inverse is available for the plane output, and for the sequence
+     * numbers, except for aperture 3 odd resolutions
+     */
+    if (Q->dgg.output == ISEA_PLANE ||
+        (Q->dgg.output == ISEA_SEQNUM &&
+         !(Q->dgg.aperture == 3 && Q->dgg.resolution % 2 != 0))) {
+        isea_ctran_matrix(&Q->dgg, Q->ctran);
+        P->inv = isea_s_inverse;
+    }
+
     return P;
 }
 
@@ -1107,3 +1441,4 @@ PJ *PJ_PROJECTION(isea) {
 #undef TABLE_H
 #undef ISEA_STD_LAT
 #undef ISEA_STD_LONG
+#undef ISEA_MAX_SEQNUM
@@ -0,0 +1,66 @@
+/******************************************************************************
+ * Project:  PROJ
+ * Purpose:  SHA-256 message digest
+ ******************************************************************************
+ * Copyright (c) 2026, PROJ contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+#ifndef SHA256_HPP_INCLUDED
+#define SHA256_HPP_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "proj/util.hpp"
+
+NS_PROJ_START
+
+//! @cond Doxygen_Suppress
+
+// ---------------------------------------------------------------------------
+
+/** Incremental computation of the SHA-256 digest (FIPS 180-4) of a stream
+ * of bytes, used to check the integrity of downloaded files. */
+class SHA256 {
+  public:
+    SHA256();
+
+    void update(const void *data, size_t size);
+
+    // Returns the digest as a lowercase hexadecimal string. No further
+    // call to update() is allowed afterwards.
+    std::string hexDigest();
+
+  private:
+    uint32_t state_[8];
+    uint64_t length_ = 0;
+    unsigned char buffer_[64];
+    size_t bufferSize_ = 0;
+
+    void transform(const unsigned char *block);
+};
+
+//! @endcond Doxygen_Suppress
+
+NS_PROJ_END
+
+#endif // SHA256_HPP_INCLUDED
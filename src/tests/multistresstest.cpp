@@ -1,7 +1,8 @@
 /******************************************************************************
  *
  * Project:  PROJ.4
- * Purpose:  Mainline program to stress test multithreaded PROJ.4 processing.
+ * Purpose:  Mainline program to stress test multithreaded PROJ processing,
+ *           and to benchmark its scalability with the number of threads.
  * Author:   Frank Warmerdam, warmerdam@pobox.com
  *
  ******************************************************************************
@@ -30,350 +31,515 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "proj.h"
 
-#ifdef _WIN32
-#include <windows.h>
-#else
-#include <pthread.h>
-#include <unistd.h>
+#ifdef __linux__
+#include <sys/resource.h>
 #endif
 
-#define num_threads 10
-static int num_iterations = 1000000;
-static int reinit_every_iteration = 0;
-
 typedef struct {
     const char *src_def;
     const char *dst_def;
-
     PJ_COORD src;
-    PJ_COORD dst;
+} TestDefinition;
 
-    int dst_error;
-    int skip;
-} TestItem;
-
-static TestItem test_list[] = {
+/* Transformations between PROJ strings, without any grid */
+static const TestDefinition proj_list[] = {
     {"+proj=utm +zone=11 +datum=WGS84", "+proj=latlong +datum=WGS84",
-     proj_coord(150000.0, 3000000.0, 0.0, 0), proj_coord(0.0, 0.0, 0.0, 0.0), 0,
-     0},
+     proj_coord(150000.0, 3000000.0, 0.0, 0)},
     {"+proj=utm +zone=11 +datum=NAD83", "+proj=latlong +datum=NAD27",
-     proj_coord(150000.0, 3000000.0, 0.0, 0.0), proj_coord(0.0, 0.0, 0.0, 0.0),
-     0, 0},
+     proj_coord(150000.0, 3000000.0, 0.0, 0.0)},
     {"+proj=utm +zone=11 +datum=NAD83",
      "+proj=latlong +nadgrids=@null +ellps=WGS84",
-     proj_coord(150000.0, 3000000.0, 0.0, 0.0), proj_coord(0.0, 0.0, 0.0, 0.0),
-     0, 0},
+     proj_coord(150000.0, 3000000.0, 0.0, 0.0)},
     {"+proj=utm +zone=11 +datum=WGS84", "+proj=merc +datum=potsdam",
-     proj_coord(150000.0, 3000000.0, 0.0, 0.0), proj_coord(0.0, 0.0, 0.0, 0.0),
-     0, 0},
+     proj_coord(150000.0, 3000000.0, 0.0, 0.0)},
     {"+proj=latlong +nadgrids=nzgd2kgrid0005.gsb", "+proj=latlong +datum=WGS84",
-     proj_coord(150000.0, 3000000.0, 0.0, 0.0), proj_coord(0.0, 0.0, 0.0, 0.0),
-     0, 0},
+     proj_coord(150000.0, 3000000.0, 0.0, 0.0)},
     {"+proj=latlong +nadgrids=nzgd2kgrid0005.gsb", "+proj=latlong +datum=WGS84",
-     proj_coord(170, -40, 0.0, 0.0), proj_coord(0.0, 0.0, 0.0, 0.0), 0, 0},
+     proj_coord(170, -40, 0.0, 0.0)},
     {"+proj=latlong +ellps=GRS80 +towgs84=2,3,5",
      "+proj=latlong +ellps=intl +towgs84=10,12,15",
-     proj_coord(170, -40, 0.0, 0.0), proj_coord(0.0, 0.0, 0.0, 0.0), 0, 0},
+     proj_coord(170, -40, 0.0, 0.0)},
     {"+proj=eqc +lat_0=11 +lon_0=12 +x_0=100000 +y_0=200000 +datum=WGS84 ",
      "+proj=stere +lat_0=11 +lon_0=12 +x_0=100000 +y_0=200000 +datum=WGS84 ",
-     proj_coord(150000.0, 250000.0, 0.0, 0.0), proj_coord(0.0, 0.0, 0.0, 0.0),
-     0, 0},
+     proj_coord(150000.0, 250000.0, 0.0, 0.0)},
     {"+proj=cea +lat_ts=11 +lon_0=12 +y_0=200000 +datum=WGS84 ",
      "+proj=merc +lon_0=12 +k=0.999 +x_0=100000 +y_0=200000 +datum=WGS84 ",
-     proj_coord(150000.0, 250000.0, 0.0, 0.0), proj_coord(0.0, 0.0, 0.0, 0.0),
-     0, 0},
+     proj_coord(150000.0, 250000.0, 0.0, 0.0)},
     {"+proj=bonne +lat_1=11 +lon_0=12 +y_0=200000 +datum=WGS84 ",
      "+proj=cass +lat_0=11 +lon_0=12 +x_0=100000 +y_0=200000 +datum=WGS84 ",
-     proj_coord(150000.0, 250000.0, 0.0, 0.0), proj_coord(0.0, 0.0, 0.0, 0.0),
-     0, 0},
+     proj_coord(150000.0, 250000.0, 0.0, 0.0)},
     {"+proj=nzmg +lat_0=11 +lon_0=12 +y_0=200000 +datum=WGS84 ",
      "+proj=gnom +lat_0=11 +lon_0=12 +x_0=100000 +y_0=200000 +datum=WGS84 ",
-     proj_coord(150000.0, 250000.0, 0.0, 0.0), proj_coord(0.0, 0.0, 0.0, 0.0),
-     0, 0},
+     proj_coord(150000.0, 250000.0, 0.0, 0.0)},
     {"+proj=ortho +lat_0=11 +lon_0=12 +y_0=200000 +datum=WGS84 ",
      "+proj=laea +lat_0=11 +lon_0=12 +x_0=100000 +y_0=200000 +datum=WGS84 ",
-     proj_coord(150000.0, 250000.0, 0.0, 0.0), proj_coord(0.0, 0.0, 0.0, 0.0),
-     0, 0},
+     proj_coord(150000.0, 250000.0, 0.0, 0.0)},
     {"+proj=aeqd +lat_0=11 +lon_0=12 +y_0=200000 +datum=WGS84 ",
      "+proj=eqdc +lat_1=20 +lat_2=5 +lat_0=11 +lon_0=12 +x_0=100000 "
      "+y_0=200000 +datum=WGS84 ",
-     proj_coord(150000.0, 250000.0, 0.0, 0.0), proj_coord(0.0, 0.0, 0.0, 0.0),
-     0, 0},
+     proj_coord(150000.0, 250000.0, 0.0, 0.0)},
     {"+proj=mill +lat_0=11 +lon_0=12 +y_0=200000 +datum=WGS84 ",
      "+proj=moll +lon_0=12 +x_0=100000 +y_0=200000 +datum=WGS84 ",
-     proj_coord(150000.0, 250000.0, 0.0, 0.0), proj_coord(0.0, 0.0, 0.0, 0.0),
-     0, 0},
+     proj_coord(150000.0, 250000.0, 0.0, 0.0)},
     {"+init=epsg:3309", "+init=epsg:4326",
-     proj_coord(150000.0, 30000.0, 0.0, 0.0), proj_coord(0.0, 0.0, 0.0, 0.0), 0,
-     0},
+     proj_coord(150000.0, 30000.0, 0.0, 0.0)},
     {/* Bad projection (invalid ellipsoid parameter +R_A=0) */
      "+proj=utm +zone=11 +datum=WGS84", "+proj=merc +datum=potsdam +R_A=0",
-     proj_coord(150000.0, 3000000.0, 0.0, 0.0), proj_coord(0.0, 0.0, 0.0, 0.0),
-     0, 0}};
+     proj_coord(150000.0, 3000000.0, 0.0, 0.0)}};
+
+/* Transformations dominated by grid lookups */
+static const TestDefinition grid_list[] = {
+    {"+proj=latlong +ellps=clrk66 +nadgrids=conus",
+     "+proj=latlong +datum=WGS84", proj_coord(-100, 40, 0.0, 0.0)},
+    {"+proj=latlong +ellps=clrk66 +nadgrids=alaska",
+     "+proj=latlong +datum=WGS84", proj_coord(-150, 60, 0.0, 0.0)},
+    {"+proj=latlong +ellps=clrk66 +nadgrids=ntv1_can.dat",
+     "+proj=latlong +datum=WGS84", proj_coord(-80, 45, 0.0, 0.0)},
+    {"+proj=latlong +ellps=clrk80ign +nadgrids=ntf_r93.gsb",
+     "+proj=latlong +datum=WGS84", proj_coord(2, 48, 0.0, 0.0)},
+    {"+proj=latlong +datum=WGS84 +geoidgrids=egm96_15.gtx",
+     "+proj=latlong +datum=WGS84", proj_coord(10, 50, 100.0, 0.0)}};
+
+/* Transformations looked up in the database, which are re-created at each */
+/* iteration */
+static const TestDefinition database_list[] = {
+    {"EPSG:4326", "EPSG:32631", proj_coord(49, 3, 0.0, 0.0)},
+    {"EPSG:4267", "EPSG:4326", proj_coord(40, -100, 0.0, 0.0)},
+    {"EPSG:4258", "EPSG:25832", proj_coord(50, 9, 0.0, 0.0)},
+    {"EPSG:27700", "EPSG:4326", proj_coord(400000, 300000, 0.0, 0.0)},
+    {"EPSG:2193", "EPSG:4326", proj_coord(5000000, 1700000, 0.0, 0.0)},
+    {"EPSG:3857", "EPSG:4326", proj_coord(1000000, 6000000, 0.0, 0.0)}};
+
+struct TestItem {
+    const TestDefinition *def = nullptr;
+    PJ *ref = nullptr;           /* created by the main thread */
+    std::vector<PJ_COORD> src{}; /* input points */
+    std::vector<PJ_COORD> dst{}; /* expected output points */
+};
+
+typedef struct {
+    long long coords;
+    long long creations;
+    long long mismatches;
+    long long voluntary_switches; /* -1 if unknown */
+} ThreadResult;
+
+static std::vector<TestItem> test_items;
+static int num_iterations = 1000;
+static int num_points = 1;
+static int num_contexts = 1;
+static int reinit_every_iteration = 0;
+static int clone_operations = 0;
+
+static std::atomic<int> ready_thread_count(0);
+static std::atomic<bool> start_flag(false);
+
+/************************************************************************/
+/*                     GetVoluntaryContextSwitches()                    */
+/*                                                                      */
+/*      Number of times the calling thread gave up the CPU before the   */
+/*      end of its time slice, mostly because it was waiting for a      */
+/*      mutex held by another thread. This is our measure of lock       */
+/*      contention, as the locks inside PROJ are not instrumented.      */
+/************************************************************************/
+
+static long long GetVoluntaryContextSwitches()
 
-static volatile int active_thread_count = 0;
+{
+#if defined(__linux__) && defined(RUSAGE_THREAD)
+    struct rusage usage;
+    if (getrusage(RUSAGE_THREAD, &usage) == 0)
+        return usage.ru_nvcsw;
+#endif
+    return -1;
+}
+
+/************************************************************************/
+/*                            CreateItemPJ()                            */
+/*                                                                      */
+/*      With --clone, copy is the copy of item.ref that the main thread */
+/*      made for the calling thread, as item.ref itself must not be     */
+/*      used by several threads at once.                                */
+/************************************************************************/
+
+static PJ *CreateItemPJ(PJ_CONTEXT *ctx, const TestItem &item, PJ *copy)
+
+{
+    if (clone_operations)
+        return copy ? proj_clone(ctx, copy) : nullptr;
+    return proj_create_crs_to_crs(ctx, item.def->src_def, item.def->dst_def,
+                                  nullptr);
+}
+
+/************************************************************************/
+/*                             SameCoord()                              */
+/************************************************************************/
+
+static bool SameCoord(const PJ_COORD &a, const PJ_COORD &b)
+
+{
+    for (int i = 0; i < 3; i++) {
+        if (a.v[i] != b.v[i] && !(std::isnan(a.v[i]) && std::isnan(b.v[i])))
+            return false;
+    }
+    return true;
+}
 
 /************************************************************************/
 /*                             TestThread()                             */
 /************************************************************************/
 
-static void TestThread()
+static void TestThread(ThreadResult *result, const std::vector<PJ *> *copies)
 
 {
-    int i, test_count = sizeof(test_list) / sizeof(TestItem);
-    int repeat_count = num_iterations;
-    int i_iter;
+    const size_t test_count = test_items.size();
+    std::vector<PJ_CONTEXT *> contexts;
+    std::vector<PJ *> pj_list(test_count, nullptr);
+    std::vector<PJ_COORD> coords;
+
+    memset(result, 0, sizeof(*result));
 
     /* -------------------------------------------------------------------- */
-    /*      Initialize coordinate system definitions.                       */
+    /*      Initialize contexts and coordinate operations.                  */
     /* -------------------------------------------------------------------- */
-    PJ **pj_list;
-    PJ_CONTEXT *ctx = proj_context_create();
-
-    pj_list = (PJ **)calloc(test_count, sizeof(PJ *));
+    for (int i = 0; i < num_contexts; i++) {
+        PJ_CONTEXT *ctx = proj_context_create();
+        proj_context_use_proj4_init_rules(ctx, true);
+        contexts.push_back(ctx);
+    }
 
     if (!reinit_every_iteration) {
-        for (i = 0; i < test_count; i++) {
-            TestItem *test = test_list + i;
-
-            pj_list[i] = proj_create_crs_to_crs(ctx, test->src_def,
-                                                test->dst_def, nullptr);
+        for (size_t i = 0; i < test_count; i++) {
+            pj_list[i] = CreateItemPJ(contexts[i % num_contexts], test_items[i],
+                                      copies ? (*copies)[i] : nullptr);
+            if (pj_list[i] == nullptr) {
+                fprintf(stderr,
+                        "Threaded projection initialization does not match "
+                        "unthreaded initialization\n");
+                result->mismatches++;
+            }
         }
     }
 
+    ready_thread_count++;
+    while (!start_flag)
+        std::this_thread::yield();
+
+    const long long switches_before = GetVoluntaryContextSwitches();
+
     /* -------------------------------------------------------------------- */
     /*      Perform tests - over and over.                                  */
     /* -------------------------------------------------------------------- */
-
-    for (i_iter = 0; i_iter < repeat_count; i_iter++) {
-        for (i = 0; i < test_count; i++) {
-            TestItem *test = test_list + i;
+    for (int i_iter = 0; i_iter < num_iterations; i_iter++) {
+        for (size_t i = 0; i < test_count; i++) {
+            const TestItem &test = test_items[i];
 
             if (reinit_every_iteration) {
-                proj_context_use_proj4_init_rules(nullptr, true);
-                pj_list[i] = proj_create_crs_to_crs(ctx, test->src_def,
-                                                    test->dst_def, nullptr);
-
-                {
-                    int skipTest = (pj_list[i] == nullptr);
-
-                    if (skipTest != test->skip)
-                        fprintf(
-                            stderr,
+                pj_list[i] =
+                    CreateItemPJ(contexts[(i + i_iter) % num_contexts], test,
+                                 copies ? (*copies)[i] : nullptr);
+                result->creations++;
+                if (pj_list[i] == nullptr) {
+                    fprintf(stderr,
                             "Threaded projection initialization does not match "
                             "unthreaded initialization\n");
-
-                    if (skipTest) {
-                        proj_destroy(pj_list[i]);
-                        continue;
-                    }
+                    result->mismatches++;
+                    continue;
                 }
-            }
-
-            if (test->skip)
+            } else if (pj_list[i] == nullptr) {
+                /* Already counted at initialization */
                 continue;
-
-            PJ_COORD out = proj_trans(pj_list[i], PJ_FWD, test->src);
-
-            int error = proj_errno(pj_list[i]);
-
-            if (error != test->dst_error) {
-                fprintf(stderr, "Got error %d, expected %d\n", error,
-                        test->dst_error);
             }
-            proj_errno_reset(pj_list[i]);
 
-            if (out.xyz.x != test->dst.xyz.x || out.xyz.y != test->dst.xyz.y ||
-                out.xyz.z != test->dst.xyz.z)
-            // if( x != test->dst_x || y != test->dst_y || z != test->dst_z )
-            {
+            coords = test.src;
+            proj_trans_array(pj_list[i], PJ_FWD, coords.size(), coords.data());
+            result->coords += coords.size();
+
+            for (size_t j = 0; j < coords.size(); j++) {
+                if (SameCoord(coords[j], test.dst[j]))
+                    continue;
+                const PJ_COORD &out = coords[j];
+                const PJ_COORD &dst = test.dst[j];
                 fprintf(stderr,
                         "Got %.15g,%.15g,%.15g\n"
                         "Expected %.15g,%.15g,%.15g\n"
                         "Diff %.15g,%.15g,%.15g\n",
-                        out.xyz.x, out.xyz.y, out.xyz.z, test->dst.xyz.x,
-                        test->dst.xyz.y, test->dst.xyz.z,
-                        out.xyz.x - test->dst.xyz.x,
-                        out.xyz.y - test->dst.xyz.y,
-                        out.xyz.z - test->dst.xyz.z);
+                        out.xyz.x, out.xyz.y, out.xyz.z, dst.xyz.x, dst.xyz.y,
+                        dst.xyz.z, out.xyz.x - dst.xyz.x,
+                        out.xyz.y - dst.xyz.y, out.xyz.z - dst.xyz.z);
+                result->mismatches++;
             }
 
             if (reinit_every_iteration) {
                 proj_destroy(pj_list[i]);
+                pj_list[i] = nullptr;
             }
         }
     }
 
+    const long long switches_after = GetVoluntaryContextSwitches();
+    result->voluntary_switches =
+        switches_before < 0 ? -1 : switches_after - switches_before;
+
     /* -------------------------------------------------------------------- */
     /*      Cleanup                                                         */
     /* -------------------------------------------------------------------- */
-    if (!reinit_every_iteration) {
-        for (i = 0; i < test_count; i++) {
-            proj_destroy(pj_list[i]);
-        }
-    }
-
-    free(pj_list);
-
-    proj_context_destroy(ctx);
+    for (size_t i = 0; i < test_count; i++)
+        proj_destroy(pj_list[i]);
 
-    printf("%d iterations of the %d tests complete in thread X\n", repeat_count,
-           test_count);
-
-    active_thread_count--;
+    for (PJ_CONTEXT *ctx : contexts)
+        proj_context_destroy(ctx);
 }
 
-#ifdef _WIN32
 /************************************************************************/
-/*                             WinTestThread()                        */
+/*                              RunTests()                              */
+/*                                                                      */
+/*      Run the tests on num_threads threads at once, and report the    */
+/*      throughput. Returns the throughput in coordinates per second.   */
 /************************************************************************/
 
-static DWORD WINAPI WinTestThread(LPVOID lpParameter)
+static double RunTests(int num_threads, double reference_throughput,
+                       long long *mismatches)
 
 {
-    TestThread();
+    std::vector<ThreadResult> results(num_threads);
+    std::vector<std::thread> threads;
+
+    /* With --clone, give each thread its own copy of the reference */
+    /* operations, made here as they must not be cloned concurrently */
+    std::vector<PJ_CONTEXT *> copy_contexts;
+    std::vector<std::vector<PJ *>> copies(num_threads);
+    if (clone_operations) {
+        for (auto &thread_copies : copies) {
+            PJ_CONTEXT *ctx = proj_context_create();
+            proj_context_use_proj4_init_rules(ctx, true);
+            copy_contexts.push_back(ctx);
+            for (const auto &test : test_items)
+                thread_copies.push_back(proj_clone(ctx, test.ref));
+        }
+    }
 
-    return 0;
+    ready_thread_count = 0;
+    start_flag = false;
+    for (int i = 0; i < num_threads; i++)
+        threads.emplace_back(TestThread, &results[i],
+                             clone_operations ? &copies[i] : nullptr);
+
+    /* Do not time the set up of the threads */
+    while (ready_thread_count < num_threads)
+        std::this_thread::yield();
+    const auto start = std::chrono::steady_clock::now();
+    start_flag = true;
+    for (auto &thread : threads)
+        thread.join();
+    const auto end = std::chrono::steady_clock::now();
+
+    for (const auto &thread_copies : copies) {
+        for (PJ *copy : thread_copies)
+            proj_destroy(copy);
+    }
+    for (PJ_CONTEXT *ctx : copy_contexts)
+        proj_context_destroy(ctx);
+
+    const double elapsed = std::chrono::duration<double>(end - start).count();
+    ThreadResult total;
+    memset(&total, 0, sizeof(total));
+    for (const auto &result : results) {
+        total.coords += result.coords;
+        total.creations += result.creations;
+        total.mismatches += result.mismatches;
+        if (result.voluntary_switches < 0 || total.voluntary_switches < 0)
+            total.voluntary_switches = -1;
+        else
+            total.voluntary_switches += result.voluntary_switches;
+    }
+    *mismatches += total.mismatches;
+
+    const double throughput = elapsed > 0 ? total.coords / elapsed : 0;
+    printf("%7d %10.1f %14.0f %13.0f", num_threads, 1000 * elapsed,
+           throughput, elapsed > 0 ? total.creations / elapsed : 0.0);
+    if (reference_throughput > 0)
+        printf(" %8.2f %10.0f%%", throughput / reference_throughput,
+               100 * throughput / reference_throughput / num_threads);
+    else
+        printf(" %8s %11s", "-", "-");
+    if (total.voluntary_switches >= 0)
+        printf(" %15.1f\n",
+               elapsed > 0 ? total.voluntary_switches / elapsed : 0.0);
+    else
+        printf(" %15s\n", "-");
+    if (total.mismatches)
+        printf("%lld results did not match the unthreaded ones!\n",
+               total.mismatches);
+
+    return throughput;
 }
 
-#else
 /************************************************************************/
-/*                             PosixTestThread()                        */
+/*                               Usage()                                */
 /************************************************************************/
 
-static void *PosixTestThread(void *pData)
+static void Usage()
 
 {
-    (void)pData;
-    TestThread();
-    return nullptr;
+    printf(
+        "Usage: multistresstest [--workload proj|grid|database]\n"
+        "                       [--threads number] [--contexts number]\n"
+        "                       [--iterations number] [--points number]\n"
+        "                       [--reinit] [--clone]\n"
+        "\n"
+        "Runs the transformations of the selected workload over and over on\n"
+        "1, 2, 4, ... up to --threads threads at once, checks that the\n"
+        "results match the unthreaded ones, and reports the throughput and\n"
+        "its scaling with the number of threads.\n"
+        "\n"
+        "  --workload    proj: transformations between PROJ strings (default)\n"
+        "                grid: transformations using the grids of the test\n"
+        "                      data\n"
+        "                database: transformations between EPSG CRS, which\n"
+        "                      are re-created at each iteration\n"
+        "  --threads     Maximum number of threads (default 10)\n"
+        "  --contexts    Number of contexts per thread (default 1)\n"
+        "  --iterations  Number of iterations per thread (default 1000)\n"
+        "  --points      Number of points per transformation (default 1)\n"
+        "  --reinit      Re-create the transformations at each iteration\n"
+        "  --clone       Create the transformations once in the main thread,\n"
+        "                and give each thread its own clone of them, instead\n"
+        "                of creating them from their definition\n"
+        "\n"
+        "Voluntary context switches, when they can be measured, are mostly\n"
+        "caused by threads waiting for a lock held by another one, and are\n"
+        "reported as an indicator of lock contention.\n");
+    exit(1);
 }
-#endif
 
 /************************************************************************/
 /*                                main()                                */
 /************************************************************************/
-#ifdef _WIN32
-static DWORD WINAPI do_main(LPVOID unused)
-#else
-static int do_main(void)
-#endif
+
+int main(int argc, char **argv)
+
 {
+    std::string workload("proj");
+    int num_threads = 10;
+
+    for (int i = 1; i < argc; i++) {
+        const bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--workload") == 0 && has_value)
+            workload = argv[++i];
+        else if (strcmp(argv[i], "--threads") == 0 && has_value)
+            num_threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--contexts") == 0 && has_value)
+            num_contexts = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "--iterations") == 0 ||
+                  strcmp(argv[i], "-num_iterations") == 0) &&
+                 has_value)
+            num_iterations = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--points") == 0 && has_value)
+            num_points = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--reinit") == 0 ||
+                 strcmp(argv[i], "-reinit") == 0)
+            reinit_every_iteration = 1;
+        else if (strcmp(argv[i], "--clone") == 0)
+            clone_operations = 1;
+        else
+            Usage();
+    }
+    if (num_threads <= 0 || num_contexts <= 0 || num_iterations <= 0 ||
+        num_points <= 0)
+        Usage();
+
+    const TestDefinition *defs;
+    size_t def_count;
+    if (workload == "proj") {
+        defs = proj_list;
+        def_count = sizeof(proj_list) / sizeof(proj_list[0]);
+    } else if (workload == "grid") {
+        defs = grid_list;
+        def_count = sizeof(grid_list) / sizeof(grid_list[0]);
+    } else if (workload == "database") {
+        defs = database_list;
+        def_count = sizeof(database_list) / sizeof(database_list[0]);
+        reinit_every_iteration = 1;
+    } else {
+        Usage();
+        return 1;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Our first pass is to establish the correct answers for all      */
     /*      the tests.                                                      */
     /* -------------------------------------------------------------------- */
-    int i, test_count = sizeof(test_list) / sizeof(TestItem);
-
-    for (i = 0; i < test_count; i++) {
-        TestItem *test = test_list + i;
-
-        PJ *pj;
-
-        proj_context_use_proj4_init_rules(nullptr, true);
-        pj = proj_create_crs_to_crs(nullptr, test->src_def, test->dst_def,
-                                    nullptr);
-
-        if (pj == nullptr) {
-            printf("Unable to translate:\n%s\n  or\n%s\n", test->src_def,
-                   test->dst_def);
-            test->skip = 1;
-            proj_destroy(pj);
+    PJ_CONTEXT *main_ctx = proj_context_create();
+    proj_context_use_proj4_init_rules(main_ctx, true);
+
+    for (size_t i = 0; i < def_count; i++) {
+        const TestDefinition *def = defs + i;
+        TestItem test;
+
+        test.def = def;
+        test.ref = proj_create_crs_to_crs(main_ctx, def->src_def,
+                                          def->dst_def, nullptr);
+        if (test.ref == nullptr) {
+            printf("Unable to translate:\n%s\n  or\n%s\n", def->src_def,
+                   def->dst_def);
             continue;
         }
 
-        PJ_COORD out = proj_trans(pj, PJ_FWD, test->src);
-        test->dst = out;
-        test->dst_error = proj_errno(pj);
-
-        proj_destroy(pj);
-
-        test->skip = 0;
-
-#ifdef nodef
-        printf("Test %d - output %.14g,%.14g,%g\n", i, test->dst.xyz.x,
-               test->dst.xyz.y, test->dst.xyz.z);
-#endif
-    }
-
-    printf("%d tests initialized.\n", test_count);
-
-/* -------------------------------------------------------------------- */
-/*      Now launch a bunch of threads to repeat the tests.              */
-/* -------------------------------------------------------------------- */
-#ifdef _WIN32
-
-    { // Scoped to workaround lack of c99 support in VS
-        HANDLE ahThread[num_threads];
-
-        for (i = 0; i < num_threads; i++) {
-            active_thread_count++;
-
-            ahThread[i] = CreateThread(NULL, 0, WinTestThread, NULL, 0, NULL);
-
-            if (ahThread[i] == 0) {
-                printf("Thread creation failed.");
-                return 1;
-            }
+        /* A regular grid of points, spaced by 0.01 unit, around src */
+        for (int j = 0; j < num_points; j++) {
+            PJ_COORD c = def->src;
+            c.xyz.x += 0.01 * (j % 16);
+            c.xyz.y += 0.01 * ((j / 16) % 16);
+            test.src.push_back(c);
         }
+        test.dst = test.src;
+        proj_trans_array(test.ref, PJ_FWD, test.dst.size(), test.dst.data());
 
-        printf("%d test threads launched.\n", num_threads);
-
-        WaitForMultipleObjects(num_threads, ahThread, TRUE, INFINITE);
+        test_items.push_back(test);
     }
 
-#else
-    {
-        pthread_t ahThread[num_threads];
-        pthread_attr_t hThreadAttr;
-
-        pthread_attr_init(&hThreadAttr);
-        pthread_attr_setdetachstate(&hThreadAttr, PTHREAD_CREATE_DETACHED);
-
-        for (i = 0; i < num_threads; i++) {
-            active_thread_count++;
-
-            pthread_create(&(ahThread[i]), &hThreadAttr, PosixTestThread,
-                           nullptr);
-        }
-
-        printf("%d test threads launched.\n", num_threads);
+    printf("%d tests initialized, %d usable.\n", static_cast<int>(def_count),
+           static_cast<int>(test_items.size()));
+    printf("Workload: %s, %d iteration(s) of %d point(s), %d context(s) per "
+           "thread%s%s\n",
+           workload.c_str(), num_iterations, num_points, num_contexts,
+           reinit_every_iteration ? ", re-initialized at each iteration" : "",
+           clone_operations ? ", cloned" : "");
+    if (test_items.empty())
+        return 1;
 
-        while (active_thread_count > 0)
-            sleep(1);
+    /* -------------------------------------------------------------------- */
+    /*      Now launch a bunch of threads to repeat the tests.              */
+    /* -------------------------------------------------------------------- */
+    printf("Threads  Time (ms)  Coordinates/s  Operations/s  Speedup  "
+           "Efficiency  Vol. switches/s\n");
+    long long mismatches = 0;
+    double reference_throughput = 0;
+    for (int n = 1;; n = std::min(2 * n, num_threads)) {
+        const double throughput =
+            RunTests(n, reference_throughput, &mismatches);
+        if (n == 1)
+            reference_throughput = throughput;
+        if (n == num_threads)
+            break;
     }
-#endif
 
-    printf("all tests complete.\n");
-
-    return 0;
-}
+    for (auto &test : test_items)
+        proj_destroy(test.ref);
+    proj_context_destroy(main_ctx);
 
-int main(int argc, char **argv) {
-    int i;
-    for (i = 0; i < argc; i++) {
-        if (strcmp(argv[i], "-reinit") == 0)
-            reinit_every_iteration = 1;
-        else if (strcmp(argv[i], "-num_iterations") == 0 && i + 1 < argc) {
-            num_iterations = atoi(argv[i + 1]);
-            i++;
-        }
-    }
+    printf("all tests complete.\n");
 
-#ifdef _WIN32
-    /* This is an incredible weirdness but with mingw cross-compiler */
-    /* 1. - b/a; where double a = 6378206.4; and double b = 6356583.8; */
-    /* does not evaluate the same in the main thread or in a thread forked */
-    /* by CreateThread(), so run the main in a thread... */
-    {
-        HANDLE thread = CreateThread(NULL, 0, do_main, NULL, 0, NULL);
-        WaitForSingleObject(thread, INFINITE);
-        CloseHandle(thread);
-    }
-#else
-    do_main();
-#endif
-    return 0;
+    return mismatches ? 1 : 0;
 }
@@ -243,6 +243,94 @@ inline static PJ_UV complex_horner_eval(uint32_t order, const double *c,
     return {E, N};
 }
 
+/* Number of points evaluated together by the batch code paths below. The
+ * loops over the points of a block are the innermost ones and have a constant
+ * trip count, so that the compiler can vectorize them, each coefficient being
+ * broadcast to all lanes. The operations are done in the same order as in
+ * the functions above, so the results are identical. */
+constexpr size_t HORNER_BLOCK_SIZE = 16;
+
+/* double_real_horner_eval() for a block of points */
+static void double_real_horner_eval_block(uint32_t order, const double *cx,
+                                          const double *cy, const double *e,
+                                          const double *n, double *E,
+                                          double *N,
+                                          uint32_t order_offset = 0) {
+    const uint32_t sz = horner_number_of_real_coefficients(order);
+    cx += sz;
+    cy += sz;
+    const double cN = *--cy;
+    const double cE = *--cx;
+    for (size_t i = 0; i < HORNER_BLOCK_SIZE; i++) {
+        N[i] = cN;
+        E[i] = cE;
+    }
+    for (uint32_t r = order; r > order_offset; r--) {
+        double u[HORNER_BLOCK_SIZE];
+        double v[HORNER_BLOCK_SIZE];
+        const double cu = *--cy;
+        const double cv = *--cx;
+        for (size_t i = 0; i < HORNER_BLOCK_SIZE; i++) {
+            u[i] = cu;
+            v[i] = cv;
+        }
+        for (uint32_t c = order; c >= r; c--) {
+            const double cuc = *--cy;
+            const double cvc = *--cx;
+            for (size_t i = 0; i < HORNER_BLOCK_SIZE; i++) {
+                u[i] = n[i] * u[i] + cuc;
+                v[i] = e[i] * v[i] + cvc;
+            }
+        }
+        for (size_t i = 0; i < HORNER_BLOCK_SIZE; i++) {
+            N[i] = e[i] * N[i] + u[i];
+            E[i] = n[i] * E[i] + v[i];
+        }
+    }
+}
+
+/* single_real_horner_eval() for a block of points */
+static void single_real_horner_eval_block(uint32_t order, const double *cx,
+                                          const double *x, double *out,
+                                          uint32_t order_offset = 0) {
+    const uint32_t sz = order + 1;
+    cx += sz;
+    const double c0 = *--cx;
+    for (size_t i = 0; i < HORNER_BLOCK_SIZE; i++)
+        out[i] = c0;
+    for (uint32_t r = order; r > order_offset; r--) {
+        const double c = *--cx;
+        for (size_t i = 0; i < HORNER_BLOCK_SIZE; i++)
+            out[i] = x[i] * out[i] + c;
+    }
+}
+
+/* complex_horner_eval() for a block of points */
+static void complex_horner_eval_block(uint32_t order, const double *c,
+                                      const double *e, const double *n,
+                                      double *E, double *N,
+                                      uint32_t order_offset = 0) {
+    const uint32_t sz = horner_number_of_complex_coefficients(order);
+    const double *cbeg = c + order_offset * 2;
+    c += sz;
+
+    const double cE = *--c;
+    const double cN = *--c;
+    for (size_t i = 0; i < HORNER_BLOCK_SIZE; i++) {
+        E[i] = cE;
+        N[i] = cN;
+    }
+    while (c > cbeg) {
+        const double cw = *--c;
+        const double cn = *--c;
+        for (size_t i = 0; i < HORNER_BLOCK_SIZE; i++) {
+            const double w = n[i] * E[i] + e[i] * N[i] + cw;
+            N[i] = n[i] * N[i] - e[i] * E[i] + cn;
+            E[i] = w;
+        }
+    }
+}
+
 inline static PJ_UV generate_error_coords() {
     PJ_UV uv_error;
     uv_error.u = uv_error.v = HUGE_VAL;
@@ -504,6 +592,264 @@ static void complex_horner_iterative_inverse_4d(PJ_COORD &point, PJ *P) {
     point.uv = complex_iterative_inverse_impl(P, transformation, point.uv);
 }
 
+/*********************************************************************/
+/* Batch code paths, used by proj_trans_array() and pipelines        */
+/*********************************************************************/
+
+/* Apply one of the kernels below to an array of coordinates, by blocks of
+ * HORNER_BLOCK_SIZE points. The kernel gets the (e, n) coordinates relative
+ * to origin, negated as requested by uneg/vneg if negate is set, and returns
+ * the resulting (E, N) coordinates, or an error code for the points where the
+ * iterative inverse does not converge. As pj_fwd4d() and pj_inv4d() would
+ * do, input coordinates with a HUGE_VAL component fail, with error code
+ * huge_val_errno. */
+template <class Kernel>
+static void horner_array(PJ_COORD *coo, size_t n, PJ *P, int *errnos,
+                         const PJ_UV *origin, bool negate, int huge_val_errno,
+                         Kernel kernel) {
+    const HORNER *Q = reinterpret_cast<const HORNER *>(P->opaque);
+    double e[HORNER_BLOCK_SIZE];
+    double nn[HORNER_BLOCK_SIZE];
+    double E[HORNER_BLOCK_SIZE];
+    double N[HORNER_BLOCK_SIZE];
+    int err[HORNER_BLOCK_SIZE];
+    size_t idx[HORNER_BLOCK_SIZE];
+
+    size_t i = 0;
+    while (i < n) {
+        size_t lanes = 0;
+        for (; i < n && lanes < HORNER_BLOCK_SIZE; i++) {
+            PJ_COORD &point = coo[i];
+            if (point.v[0] == HUGE_VAL || point.v[1] == HUGE_VAL ||
+                point.v[2] == HUGE_VAL) {
+                if (huge_val_errno)
+                    errnos[i] = huge_val_errno;
+                point = proj_coord_error();
+                continue;
+            }
+            double pe = point.uv.u;
+            double pn = point.uv.v;
+            if (origin) {
+                pe -= origin->u;
+                pn -= origin->v;
+            }
+            if (negate && Q->uneg)
+                pe = -pe;
+            if (negate && Q->vneg)
+                pn = -pn;
+            if ((fabs(pn) > Q->range) || (fabs(pe) > Q->range)) {
+                errnos[i] = PROJ_ERR_COORD_TRANSFM_OUTSIDE_PROJECTION_DOMAIN;
+                point = proj_coord_error();
+                continue;
+            }
+            idx[lanes] = i;
+            e[lanes] = pe;
+            nn[lanes] = pn;
+            err[lanes] = 0;
+            lanes++;
+        }
+        if (lanes == 0)
+            continue;
+        // Pad the block with copies of the first point, which will not make
+        // the iterative inverse loop longer than needed
+        for (size_t l = lanes; l < HORNER_BLOCK_SIZE; l++) {
+            e[l] = e[0];
+            nn[l] = nn[0];
+            err[l] = 0;
+        }
+
+        kernel(Q, e, nn, E, N, err);
+
+        for (size_t l = 0; l < lanes; l++) {
+            PJ_COORD &point = coo[idx[l]];
+            if (err[l]) {
+                errnos[idx[l]] = err[l];
+                point = proj_coord_error();
+            } else {
+                point.uv.u = E[l];
+                point.uv.v = N[l];
+            }
+        }
+    }
+}
+
+static void real_fwd_kernel(const HORNER *Q, const double *e, const double *n,
+                            double *E, double *N, int *) {
+    double_real_horner_eval_block(Q->order, Q->fwd_u, Q->fwd_v, e, n, E, N);
+}
+
+static void real_inv_kernel(const HORNER *Q, const double *e, const double *n,
+                            double *E, double *N, int *) {
+    double_real_horner_eval_block(Q->order, Q->inv_u, Q->inv_v, e, n, E, N);
+}
+
+/* real_iterative_inverse_impl() for a block of points. All points are
+ * iterated together, and a point that has converged keeps the value of the
+ * iteration where it did, so that the results match the per-point code. */
+static void real_iterative_inv_kernel(const HORNER *Q, const double *e,
+                                      const double *n, double *E, double *N,
+                                      int *err) {
+    const uint32_t order = Q->order;
+    const double tol = Q->inverse_tolerance;
+    double de[HORNER_BLOCK_SIZE];
+    double dn[HORNER_BLOCK_SIZE];
+    double x0[HORNER_BLOCK_SIZE];
+    double y0[HORNER_BLOCK_SIZE];
+    bool converged[HORNER_BLOCK_SIZE];
+    for (size_t i = 0; i < HORNER_BLOCK_SIZE; i++) {
+        de[i] = e[i] - Q->fwd_u[0];
+        dn[i] = n[i] - Q->fwd_v[0];
+        x0[i] = 0.0;
+        y0[i] = 0.0;
+        converged[i] = false;
+    }
+
+    for (int loops = 32; loops > 0; loops--) {
+        double Ma[HORNER_BLOCK_SIZE];
+        double Mb[HORNER_BLOCK_SIZE];
+        double Mc[HORNER_BLOCK_SIZE];
+        double Md[HORNER_BLOCK_SIZE];
+        // sum the i > 0 coefficients
+        double_real_horner_eval_block(order, Q->fwd_u, Q->fwd_v, x0, y0, Mb,
+                                      Mc, 1);
+        // sum the i = 0, j > 0 coefficients
+        single_real_horner_eval_block(order, Q->fwd_u, x0, Ma, 1);
+        single_real_horner_eval_block(order, Q->fwd_v, y0, Md, 1);
+
+        bool all_converged = true;
+        for (size_t i = 0; i < HORNER_BLOCK_SIZE; i++) {
+            const double idet = 1.0 / (Ma[i] * Md[i] - Mb[i] * Mc[i]);
+            const double x = idet * (Md[i] * de[i] - Mb[i] * dn[i]);
+            const double y = idet * (Ma[i] * dn[i] - Mc[i] * de[i]);
+            if (!converged[i]) {
+                converged[i] =
+                    (fabs(x - x0[i]) < tol) && (fabs(y - y0[i]) < tol);
+                x0[i] = x;
+                y0[i] = y;
+            }
+            all_converged &= converged[i];
+        }
+        if (all_converged)
+            break;
+    }
+
+    for (size_t i = 0; i < HORNER_BLOCK_SIZE; i++) {
+        if (!converged[i])
+            err[i] = PROJ_ERR_COORD_TRANSFM;
+        E[i] = x0[i] + Q->fwd_origin->u;
+        N[i] = y0[i] + Q->fwd_origin->v;
+    }
+}
+
+static void complex_fwd_kernel(const HORNER *Q, const double *e,
+                               const double *n, double *E, double *N, int *) {
+    complex_horner_eval_block(Q->order, Q->fwd_c, e, n, E, N);
+}
+
+static void complex_inv_kernel(const HORNER *Q, const double *e,
+                               const double *n, double *E, double *N, int *) {
+    complex_horner_eval_block(Q->order, Q->inv_c, e, n, E, N);
+}
+
+/* complex_iterative_inverse_impl() for a block of points, iterated together
+ * as in real_iterative_inv_kernel() */
+static void complex_iterative_inv_kernel(const HORNER *Q, const double *e,
+                                         const double *n, double *E, double *N,
+                                         int *err) {
+    // complex real part corresponds to Northing, imag part to Easting
+    const double tol = Q->inverse_tolerance;
+    double dZr[HORNER_BLOCK_SIZE];
+    double dZi[HORNER_BLOCK_SIZE];
+    double w0r[HORNER_BLOCK_SIZE];
+    double w0i[HORNER_BLOCK_SIZE];
+    bool converged[HORNER_BLOCK_SIZE];
+    for (size_t i = 0; i < HORNER_BLOCK_SIZE; i++) {
+        dZr[i] = n[i] - Q->fwd_c[0];
+        dZi[i] = e[i] - Q->fwd_c[1];
+        w0r[i] = 0.0;
+        w0i[i] = 0.0;
+        converged[i] = false;
+    }
+
+    for (int loops = 32; loops > 0; loops--) {
+        double detE[HORNER_BLOCK_SIZE];
+        double detN[HORNER_BLOCK_SIZE];
+        complex_horner_eval_block(Q->order, Q->fwd_c, w0i, w0r, detE, detN, 1);
+
+        bool all_converged = true;
+        for (size_t i = 0; i < HORNER_BLOCK_SIZE; i++) {
+            if (!converged[i]) {
+                const std::complex<double> w1 =
+                    std::complex<double>(dZr[i], dZi[i]) /
+                    std::complex<double>(detN[i], detE[i]);
+                converged[i] = (fabs(w1.real() - w0r[i]) < tol) &&
+                               (fabs(w1.imag() - w0i[i]) < tol);
+                w0r[i] = w1.real();
+                w0i[i] = w1.imag();
+            }
+            all_converged &= converged[i];
+        }
+        if (all_converged)
+            break;
+    }
+
+    for (size_t i = 0; i < HORNER_BLOCK_SIZE; i++) {
+        if (!converged[i])
+            err[i] = PROJ_ERR_COORD_TRANSFM;
+        double pE = w0i[i];
+        double pN = w0r[i];
+        if (Q->uneg)
+            pE = -pE;
+        if (Q->vneg)
+            pN = -pN;
+        E[i] = pE + Q->fwd_origin->u;
+        N[i] = pN + Q->fwd_origin->v;
+    }
+}
+
+static void horner_forward_4d_array(PJ_COORD *coo, size_t n, PJ *P,
+                                    int *errnos) {
+    const HORNER *Q = reinterpret_cast<const HORNER *>(P->opaque);
+    horner_array(coo, n, P, errnos, Q->fwd_origin, false, 0, real_fwd_kernel);
+}
+
+static void horner_inverse_4d_array(PJ_COORD *coo, size_t n, PJ *P,
+                                    int *errnos) {
+    const HORNER *Q = reinterpret_cast<const HORNER *>(P->opaque);
+    horner_array(coo, n, P, errnos, Q->inv_origin, false,
+                 PROJ_ERR_COORD_TRANSFM_OUTSIDE_PROJECTION_DOMAIN,
+                 real_inv_kernel);
+}
+
+static void horner_iterative_inverse_4d_array(PJ_COORD *coo, size_t n, PJ *P,
+                                              int *errnos) {
+    horner_array(coo, n, P, errnos, nullptr, false,
+                 PROJ_ERR_COORD_TRANSFM_OUTSIDE_PROJECTION_DOMAIN,
+                 real_iterative_inv_kernel);
+}
+
+static void complex_horner_forward_4d_array(PJ_COORD *coo, size_t n, PJ *P,
+                                            int *errnos) {
+    const HORNER *Q = reinterpret_cast<const HORNER *>(P->opaque);
+    horner_array(coo, n, P, errnos, Q->fwd_origin, true, 0,
+                 complex_fwd_kernel);
+}
+
+static void complex_horner_inverse_4d_array(PJ_COORD *coo, size_t n, PJ *P,
+                                            int *errnos) {
+    const HORNER *Q = reinterpret_cast<const HORNER *>(P->opaque);
+    horner_array(coo, n, P, errnos, Q->inv_origin, true,
+                 PROJ_ERR_COORD_TRANSFM_OUTSIDE_PROJECTION_DOMAIN,
+                 complex_inv_kernel);
+}
+
+static void complex_horner_iterative_inverse_4d_array(PJ_COORD *coo, size_t n,
+                                                      PJ *P, int *errnos) {
+    horner_array(coo, n, P, errnos, nullptr, false,
+                 PROJ_ERR_COORD_TRANSFM_OUTSIDE_PROJECTION_DOMAIN,
+                 complex_iterative_inv_kernel);
+}
+
 static PJ *horner_freeup(PJ *P, int errlev) { /* Destructor */
     if (nullptr == P)
         return nullptr;
@@ -599,9 +945,15 @@ PJ *PJ_PROJECTION(horner) {
         P->fwd4d = complex_horner_forward_4d;
         P->inv4d = has_inv ? complex_horner_inverse_4d
                            : complex_horner_iterative_inverse_4d;
+        P->fwd4d_array = complex_horner_forward_4d_array;
+        P->inv4d_array = has_inv ? complex_horner_inverse_4d_array
+                                 : complex_horner_iterative_inverse_4d_array;
     } else {
         P->fwd4d = horner_forward_4d;
         P->inv4d = has_inv ? horner_inverse_4d : horner_iterative_inverse_4d;
+        P->fwd4d_array = horner_forward_4d_array;
+        P->inv4d_array = has_inv ? horner_inverse_4d_array
+                                 : horner_iterative_inverse_4d_array;
     }
 
     if (complex_polynomia) {
@@ -0,0 +1,145 @@
+/******************************************************************************
+ * Project:  PROJ
+ * Purpose:  Benchmark of the instantiation of objects from the database
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, PROJ contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+#include "proj.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+static void usage() {
+    printf("Usage: bench_create_from_database [--auth-name name]\n");
+    printf("                                  [--type crs|transformation]\n");
+    printf("                                  [--limit number]\n");
+    printf("\n");
+    printf("Instantiates (and keeps alive) all objects of the specified type "
+           "of an\nauthority, and reports the duration and the increase of "
+           "resident memory.\n");
+    printf("\n");
+    printf("Example: bench_create_from_database --auth-name EPSG --type "
+           "crs\n");
+    exit(1);
+}
+
+// Returns the resident set size in bytes, or -1 if unknown.
+static long long getResidentMemory() {
+#ifdef __linux__
+    FILE *f = fopen("/proc/self/statm", "rb");
+    if (f) {
+        long long size = 0;
+        long long resident = 0;
+        const bool ok = fscanf(f, "%lld %lld", &size, &resident) == 2;
+        fclose(f);
+        if (ok)
+            return resident * sysconf(_SC_PAGESIZE);
+    }
+#endif
+    return -1;
+}
+
+int main(int argc, char *argv[]) {
+    std::string authName("EPSG");
+    PJ_TYPE type = PJ_TYPE_CRS;
+    PJ_CATEGORY category = PJ_CATEGORY_CRS;
+    int limit = -1;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--auth-name") == 0) {
+            if (i + 1 >= argc)
+                usage();
+            authName = argv[i + 1];
+            ++i;
+        } else if (strcmp(argv[i], "--type") == 0) {
+            if (i + 1 >= argc)
+                usage();
+            if (strcmp(argv[i + 1], "crs") == 0) {
+                type = PJ_TYPE_CRS;
+                category = PJ_CATEGORY_CRS;
+            } else if (strcmp(argv[i + 1], "transformation") == 0) {
+                type = PJ_TYPE_TRANSFORMATION;
+                category = PJ_CATEGORY_COORDINATE_OPERATION;
+            } else {
+                usage();
+            }
+            ++i;
+        } else if (strcmp(argv[i], "--limit") == 0) {
+            if (i + 1 >= argc)
+                usage();
+            limit = atoi(argv[i + 1]);
+            ++i;
+        } else {
+            usage();
+        }
+    }
+
+    PJ_CONTEXT *ctxt = proj_context_create();
+    proj_log_level(ctxt, PJ_LOG_NONE);
+    PROJ_STRING_LIST codes =
+        proj_get_codes_from_database(ctxt, authName.c_str(), type, true);
+    if (codes == nullptr) {
+        fprintf(stderr, "Cannot retrieve codes\n");
+        exit(1);
+    }
+
+    const long long rssBefore = getResidentMemory();
+    std::vector<PJ *> objects;
+    auto start = std::chrono::system_clock::now();
+    for (int i = 0; codes[i] != nullptr && (limit < 0 || i < limit); ++i) {
+        PJ *obj = proj_create_from_database(ctxt, authName.c_str(), codes[i],
+                                            category, false, nullptr);
+        if (obj)
+            objects.push_back(obj);
+    }
+    auto end = std::chrono::system_clock::now();
+    const long long rssAfter = getResidentMemory();
+
+    auto elapsed_ms =
+        std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+    printf("Objects instantiated: %d\n", static_cast<int>(objects.size()));
+    printf("Duration: %d ms\n", static_cast<int>(elapsed_ms.count()));
+    if (rssBefore >= 0 && rssAfter >= 0) {
+        printf("Resident memory increase: %.1f MB\n",
+               static_cast<double>(rssAfter - rssBefore) / (1024 * 1024));
+        if (!objects.empty()) {
+            printf("Resident memory per object: %.1f kB\n",
+                   static_cast<double>(rssAfter - rssBefore) / 1024 /
+                       static_cast<double>(objects.size()));
+        }
+    }
+
+    for (PJ *obj : objects)
+        proj_destroy(obj);
+    proj_string_list_destroy(codes);
+    proj_context_destroy(ctxt);
+
+    return 0;
+}
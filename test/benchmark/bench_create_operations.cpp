@@ -0,0 +1,158 @@
+/******************************************************************************
+ * Project:  PROJ
+ * Purpose:  Benchmark of the search of coordinate operations
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, PROJ contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+#include "proj.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+
+// Count the allocations done through operator new, which is what the C++
+// code of PROJ uses. As replacing operator new affects the whole program,
+// this also accounts for the allocations done inside libproj.
+static std::atomic<long long> gAllocCount(0);
+
+void *operator new(size_t size) {
+    ++gAllocCount;
+    void *ptr = malloc(size ? size : 1);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept { free(ptr); }
+
+static void usage() {
+    printf("Usage: bench_create_operations (--source-crs|-s) string\n");
+    printf("                               (--target-crs|-t) string\n");
+    printf("                               [(--loops|-l) number]\n");
+    printf("                               [--crs-to-crs]\n");
+    printf("\n");
+    printf("Times proj_create_operations(), or proj_create_crs_to_crs() if "
+           "--crs-to-crs\nis specified, and reports the number of memory "
+           "allocations per iteration.\n");
+    printf("\n");
+    printf("Example: bench_create_operations -s EPSG:4326 -t EPSG:2193\n");
+    exit(1);
+}
+
+int main(int argc, char *argv[]) {
+    std::string sourceCRS;
+    std::string targetCRS;
+    int loops = 100;
+    bool crsToCrs = false;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--source-crs") == 0 ||
+            strcmp(argv[i], "-s") == 0) {
+            if (i + 1 >= argc)
+                usage();
+            sourceCRS = argv[i + 1];
+            ++i;
+        } else if (strcmp(argv[i], "--target-crs") == 0 ||
+                   strcmp(argv[i], "-t") == 0) {
+            if (i + 1 >= argc)
+                usage();
+            targetCRS = argv[i + 1];
+            ++i;
+        } else if (strcmp(argv[i], "--loops") == 0 ||
+                   strcmp(argv[i], "-l") == 0) {
+            if (i + 1 >= argc)
+                usage();
+            loops = atoi(argv[i + 1]);
+            ++i;
+        } else if (strcmp(argv[i], "--crs-to-crs") == 0) {
+            crsToCrs = true;
+        } else {
+            usage();
+        }
+    }
+    if (sourceCRS.empty() || targetCRS.empty() || loops <= 0)
+        usage();
+
+    PJ_CONTEXT *ctxt = proj_context_create();
+    PJ *src = proj_create(ctxt, sourceCRS.c_str());
+    PJ *dst = proj_create(ctxt, targetCRS.c_str());
+    if (src == nullptr || dst == nullptr) {
+        exit(1);
+    }
+    PJ_OPERATION_FACTORY_CONTEXT *opCtxt =
+        proj_create_operation_factory_context(ctxt, nullptr);
+    proj_operation_factory_context_set_spatial_criterion(
+        ctxt, opCtxt, PROJ_SPATIAL_CRITERION_PARTIAL_INTERSECTION);
+    proj_operation_factory_context_set_grid_availability_use(
+        ctxt, opCtxt, PROJ_GRID_AVAILABILITY_IGNORED);
+
+    const auto runOnce = [&]() {
+        int count = 0;
+        if (crsToCrs) {
+            PJ *P = proj_create_crs_to_crs_from_pj(ctxt, src, dst, nullptr,
+                                                   nullptr);
+            if (P) {
+                count = 1;
+                proj_destroy(P);
+            }
+        } else {
+            PJ_OBJ_LIST *ops = proj_create_operations(ctxt, src, dst, opCtxt);
+            if (ops) {
+                count = proj_list_get_count(ops);
+                proj_list_destroy(ops);
+            }
+        }
+        return count;
+    };
+
+    // Warm-up, so that database caches are populated
+    const int count = runOnce();
+    if (crsToCrs)
+        printf("Transformation created: %s\n", count ? "yes" : "no");
+    else
+        printf("Operations found: %d\n", count);
+
+    const long long allocCountBefore = gAllocCount;
+    auto start = std::chrono::system_clock::now();
+    for (int i = 0; i < loops; ++i) {
+        runOnce();
+    }
+    auto end = std::chrono::system_clock::now();
+    const long long allocCount = gAllocCount - allocCountBefore;
+
+    proj_operation_factory_context_destroy(opCtxt);
+    proj_destroy(src);
+    proj_destroy(dst);
+    proj_context_destroy(ctxt);
+
+    auto elapsed_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    printf("Duration per iteration: %.1f ms\n",
+           1e-3 * static_cast<double>(elapsed_us.count()) / loops);
+    printf("Allocations per iteration: %lld\n", allocCount / loops);
+
+    return 0;
+}
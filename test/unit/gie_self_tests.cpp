@@ -35,8 +35,11 @@
 #include "proj_internal.h"
 // clang-format on
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <string>
+#include <vector>
 
 namespace {
 
@@ -769,6 +772,97 @@ TEST(gie, unitconvert_selftest) {
     test_time(args5, 1e-6, in5, in5);
 }
 
+TEST(gie, unitconvert_trans_array) {
+    // proj_trans_array() converts time by batch, once per run of identical
+    // epochs: check that it gives the same results as proj_trans()
+    const struct {
+        const char *def;
+        double t0;
+    } cases[] = {
+        {"+proj=unitconvert +xy_in=km +t_in=decimalyear +t_out=yyyymmdd",
+         2004.25},
+        {"+proj=unitconvert +z_in=cm +t_in=gps_week +t_out=decimalyear",
+         1782.0},
+        {"+proj=pipeline +step +proj=unitconvert +t_in=decimalyear +t_out=mjd "
+         "+step +proj=affine +xoff=1 +step +proj=unitconvert +t_in=mjd "
+         "+t_out=gps_week",
+         2004.25}};
+    for (const auto &testCase : cases) {
+        const char *def = testCase.def;
+        PJ *P = proj_create(PJ_DEFAULT_CTX, def);
+        ASSERT_TRUE(P != nullptr) << def;
+        for (const PJ_DIRECTION direction : {PJ_FWD, PJ_INV}) {
+            std::vector<PJ_COORD> coords;
+            for (int i = 0; i < 40; i++) {
+                // Runs of 1 to 4 identical epochs
+                const double t = testCase.t0 + (i - i % (1 + i % 4)) * 0.7;
+                coords.push_back(proj_coord(i, 2 * i, 3 * i, t));
+            }
+            coords[5].xyzt.x = HUGE_VAL;
+            coords[9].xyzt.t = std::numeric_limits<double>::quiet_NaN();
+            if (direction == PJ_INV)
+                proj_trans_array(P, PJ_FWD, coords.size(), coords.data());
+
+            std::vector<PJ_COORD> expected(coords);
+            for (auto &c : expected)
+                c = proj_trans(P, direction, c);
+
+            EXPECT_EQ(proj_trans_array(P, direction, coords.size(),
+                                       coords.data()),
+                      0);
+            for (size_t i = 0; i < coords.size(); i++) {
+                for (int j = 0; j < 4; j++) {
+                    if (std::isnan(expected[i].v[j]))
+                        EXPECT_TRUE(std::isnan(coords[i].v[j]));
+                    else
+                        EXPECT_EQ(coords[i].v[j], expected[i].v[j])
+                            << def << " " << i << " " << j;
+                }
+            }
+        }
+        proj_destroy(P);
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+TEST(gie, unitconvert_decimalyear_to_mjd_year_by_year) {
+    // The leap days are counted directly, and not anymore year by year after
+    // the fraction of the year has been added: check that the result does not
+    // drift away from the year by year computation before 2200
+    const auto is_leap_year = [](long year) {
+        return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    };
+    const auto year_by_year = [&is_leap_year](double decimalyear) {
+        long year = lround(floor(decimalyear));
+        const double fractional_year = decimalyear - year;
+        double mjd = (year - 1859) * 365 + 14 + 31;
+        mjd += fractional_year * (is_leap_year(year) ? 366 : 365);
+        for (year--; year > 1858; year--)
+            if (is_leap_year(year))
+                mjd++;
+        return mjd;
+    };
+
+    PJ *P = proj_create(PJ_DEFAULT_CTX,
+                        "+proj=unitconvert +t_in=decimalyear +t_out=mjd");
+    ASSERT_TRUE(P != nullptr);
+    double maxDiff = 0;
+    for (int year = 1800; year < 2200; year++) {
+        for (int i = 0; i < 16; i++) {
+            const double decimalyear = year + i / 16.0 + i * 1e-5;
+            const double mjd =
+                proj_trans(P, PJ_FWD, proj_coord(0, 0, 0, decimalyear)).xyzt.t;
+            maxDiff = std::max(maxDiff, fabs(mjd - year_by_year(decimalyear)));
+        }
+    }
+    // A few ulps of an MJD around 1e5
+    EXPECT_LE(maxDiff, 1e-10);
+    proj_destroy(P);
+}
+
+// ---------------------------------------------------------------------------
+
 static void test_date(const char *args, double tol, double t_in, double t_exp) {
     PJ_COORD in, out;
     PJ *P = proj_create(PJ_DEFAULT_CTX, args);
@@ -1008,6 +1102,125 @@ TEST(gie, horner_only_fwd_selftest) {
 
 // ---------------------------------------------------------------------------
 
+TEST(gie, horner_trans_array) {
+    // proj_trans_array() evaluates horner by blocks of points, alone or in a
+    // pipeline: check that it gives the same results as proj_trans()
+    const std::string pipeline_tc32 =
+        std::string("+proj=pipeline +step +proj=affine +xoff=1 +step") +
+        tc32_utm32_fwd_only;
+    const char *defs[] = {tc32_utm32,          sb_utm32,
+                          tc32_utm32_fwd_only, sb_utm32_fwd_only,
+                          hatt_to_ggrs,        pipeline_tc32.c_str()};
+    for (const char *def : defs) {
+        PJ *P = proj_create(PJ_DEFAULT_CTX, def);
+        ASSERT_TRUE(P != nullptr) << def;
+        for (const PJ_DIRECTION direction : {PJ_FWD, PJ_INV}) {
+            std::vector<PJ_COORD> coords;
+            for (int i = 0; i < 50; i++) {
+                PJ_COORD c = proj_coord(0, 0, 0, 0);
+                if (def == hatt_to_ggrs) {
+                    c.xy.x = -10157.950 + 100 * i;
+                    c.xy.y = -21121.093 - 70 * i;
+                } else {
+                    c.xy.x = 495136.8544 + 1000 * i;
+                    c.xy.y = 6130821.2945 - 700 * i;
+                }
+                if (direction == PJ_INV)
+                    c = proj_trans(P, PJ_FWD, c);
+                coords.push_back(c);
+            }
+            coords[3].xy.x = 1e9; // out of range
+            coords[7].xy.y = HUGE_VAL;
+            coords[11].xy.x = std::numeric_limits<double>::quiet_NaN();
+
+            std::vector<PJ_COORD> expected(coords);
+            int expected_errno = 0;
+            for (auto &c : expected) {
+                proj_errno_reset(P);
+                c = proj_trans(P, direction, c);
+                if (proj_errno(P)) {
+                    if (expected_errno == 0)
+                        expected_errno = proj_errno(P);
+                    else if (expected_errno != proj_errno(P))
+                        expected_errno = PROJ_ERR_COORD_TRANSFM;
+                }
+            }
+
+            EXPECT_EQ(proj_trans_array(P, direction, coords.size(),
+                                       coords.data()),
+                      expected_errno)
+                << def;
+            for (size_t i = 0; i < coords.size(); i++) {
+                for (int j = 0; j < 4; j++) {
+                    if (std::isnan(expected[i].v[j]))
+                        EXPECT_TRUE(std::isnan(coords[i].v[j]));
+                    else
+                        EXPECT_EQ(coords[i].v[j], expected[i].v[j])
+                            << def << " " << i << " " << j;
+                }
+            }
+        }
+        proj_destroy(P);
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+TEST(gie, proj_create_argv_pipeline_parameters) {
+    // Parameters and pipeline step arguments are stored in a per-PJ arena.
+    // Check that they survive the initialization of the steps and that
+    // (un)successful creations release everything properly.
+    const char *args[] = {"+proj=pipeline",  "+step",       "+proj=cart",
+                          "+ellps=GRS80",    "+step",       "+proj=helmert",
+                          "+x=1",            "+y=2",        "+z=3",
+                          "+step",           "+inv",        "+proj=cart",
+                          "+ellps=GRS80"};
+    const int argc = static_cast<int>(sizeof(args) / sizeof(args[0]));
+    for (int iter = 0; iter < 2; ++iter) {
+        PJ *P = proj_create_argv(PJ_DEFAULT_CTX, argc,
+                                 const_cast<char **>(args));
+        ASSERT_TRUE(P != nullptr);
+        EXPECT_EQ(std::string(proj_pj_info(P).definition),
+                  "proj=pipeline step proj=cart ellps=GRS80 step "
+                  "proj=helmert x=1 y=2 z=3 step inv proj=cart ellps=GRS80");
+        PJ_COORD c = proj_coord(0, 0, 0, 0);
+        c = proj_trans(P, PJ_FWD, c);
+        EXPECT_NEAR(c.lpz.z, 1, 1e-5);
+        proj_destroy(P);
+    }
+
+    const char *invalid_args[] = {"+proj=pipeline", "+step",
+                                  "+proj=unknown_projection"};
+    EXPECT_EQ(proj_create_argv(PJ_DEFAULT_CTX, 3,
+                               const_cast<char **>(invalid_args)),
+              nullptr);
+}
+
+// ---------------------------------------------------------------------------
+
+TEST(gie, proj_create_does_not_keep_validated_pj) {
+    // proj_create() reuses the PJ instantiated to validate the PROJ string,
+    // and must not leave it in the context once it returns.
+    PJ_CONTEXT *ctx = proj_context_create();
+    const char *pipeline = "+proj=pipeline +step +proj=axisswap +order=2,1 "
+                           "+step +proj=utm +zone=31 +ellps=GRS80";
+    for (int iter = 0; iter < 2; ++iter) {
+        PJ *P = proj_create(ctx, pipeline);
+        ASSERT_TRUE(P != nullptr);
+        EXPECT_FALSE(ctx->keepValidatedPJ);
+        EXPECT_TRUE(ctx->validatedPJ == nullptr);
+        EXPECT_TRUE(ctx->validatedPROJString.empty());
+        proj_destroy(P);
+    }
+
+    // Nor after a failed creation
+    EXPECT_TRUE(proj_create(ctx, "+proj=unknown_projection") == nullptr);
+    EXPECT_TRUE(ctx->validatedPJ == nullptr);
+    proj_context_destroy(ctx);
+}
+
+// ---------------------------------------------------------------------------
+
 TEST(gie, proj_create_crs_to_crs_PULKOVO42_ETRS89) {
     auto P = proj_create_crs_to_crs(PJ_DEFAULT_CTX, "EPSG:4179", "EPSG:4258",
                                     nullptr);
@@ -1090,6 +1303,47 @@ TEST(gie, proj_create_crs_to_crs_PULKOVO42_ETRS89) {
 
 // ---------------------------------------------------------------------------
 
+TEST(gie, proj_create_crs_to_crs_alternatives_instantiated_on_demand) {
+    auto P = proj_create_crs_to_crs(PJ_DEFAULT_CTX, "EPSG:4179", "EPSG:4258",
+                                    nullptr);
+    ASSERT_TRUE(P != nullptr);
+    ASSERT_GT(P->alternativeCoordinateOperations.size(), 1U);
+    for (const auto &op : P->alternativeCoordinateOperations) {
+        EXPECT_FALSE(op.isPJInstantiated);
+    }
+
+    const auto countInstantiated = [](const PJ *obj) {
+        int count = 0;
+        for (const auto &op : obj->alternativeCoordinateOperations) {
+            if (op.isPJInstantiated)
+                ++count;
+        }
+        return count;
+    };
+
+    // Romania
+    PJ_COORD c;
+    c.xyzt.x = 45; // Lat
+    c.xyzt.y = 25; // Long
+    c.xyzt.z = 0;
+    c.xyzt.t = HUGE_VAL;
+    c = proj_trans(P, PJ_FWD, c);
+    EXPECT_NEAR(c.xy.x, 44.999701238, 1e-9);
+    EXPECT_NEAR(c.xy.y, 24.998474948, 1e-9);
+    EXPECT_EQ(countInstantiated(P), 1);
+
+    // Cloning does not instantiate the other operations
+    auto P2 = proj_clone(PJ_DEFAULT_CTX, P);
+    ASSERT_TRUE(P2 != nullptr);
+    EXPECT_EQ(countInstantiated(P2), 1);
+    EXPECT_TRUE(proj_is_equivalent_to(P, P2, PJ_COMP_STRICT));
+
+    proj_destroy(P2);
+    proj_destroy(P);
+}
+
+// ---------------------------------------------------------------------------
+
 TEST(gie, proj_create_crs_to_crs_WGS84_EGM08_to_WGS84) {
     auto P = proj_create_crs_to_crs(PJ_DEFAULT_CTX, "EPSG:4326+3855",
                                     "EPSG:4979", nullptr);
@@ -1494,4 +1748,49 @@ TEST(gie, proj_create_crs_to_crs_from_pj_force_over) {
     proj_context_destroy(ctx);
 }
 
+// ---------------------------------------------------------------------------
+
+TEST(gie, proj_context_set_database_path_shared_cache) {
+    const char *const options[] = {"SHARED_CACHE=YES", nullptr};
+    PJ_CONTEXT *ctx1 = proj_context_create();
+    ASSERT_TRUE(
+        proj_context_set_database_path(ctx1, nullptr, nullptr, options));
+    PJ_CONTEXT *ctx2 = proj_context_create();
+    ASSERT_TRUE(
+        proj_context_set_database_path(ctx2, nullptr, nullptr, options));
+    PJ_CONTEXT *ctx3 = proj_context_clone(ctx2);
+    PJ_CONTEXT *ctxNotShared = proj_context_create();
+
+    PJ *crs1 = proj_create_from_database(ctx1, "EPSG", "32631",
+                                         PJ_CATEGORY_CRS, false, nullptr);
+    ASSERT_TRUE(crs1 != nullptr);
+    ASSERT_TRUE(crs1->iso_obj != nullptr);
+
+    // Contexts with a shared cache, including cloned ones, get the very
+    // object cached by the first one
+    PJ *crs2 = proj_create_from_database(ctx2, "EPSG", "32631",
+                                         PJ_CATEGORY_CRS, false, nullptr);
+    ASSERT_TRUE(crs2 != nullptr);
+    EXPECT_EQ(crs2->iso_obj.get(), crs1->iso_obj.get());
+    PJ *crs3 = proj_create_from_database(ctx3, "EPSG", "32631",
+                                         PJ_CATEGORY_CRS, false, nullptr);
+    ASSERT_TRUE(crs3 != nullptr);
+    EXPECT_EQ(crs3->iso_obj.get(), crs1->iso_obj.get());
+
+    // while the other ones build their own
+    PJ *crsNotShared = proj_create_from_database(
+        ctxNotShared, "EPSG", "32631", PJ_CATEGORY_CRS, false, nullptr);
+    ASSERT_TRUE(crsNotShared != nullptr);
+    EXPECT_NE(crsNotShared->iso_obj.get(), crs1->iso_obj.get());
+
+    proj_destroy(crsNotShared);
+    proj_destroy(crs3);
+    proj_destroy(crs2);
+    proj_destroy(crs1);
+    proj_context_destroy(ctxNotShared);
+    proj_context_destroy(ctx3);
+    proj_context_destroy(ctx2);
+    proj_context_destroy(ctx1);
+}
+
 } // namespace
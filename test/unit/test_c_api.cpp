@@ -250,6 +250,52 @@ TEST_F(CApi, proj_create) {
 
 // ---------------------------------------------------------------------------
 
+TEST_F(CApi, proj_create_pipeline_several_times) {
+    // proj_create() reuses the PJ instantiated to validate the PROJ string.
+    // Check that each call still returns an independent object.
+    const char *pipeline =
+        "+proj=pipeline +step +proj=axisswap +order=2,1 "
+        "+step +proj=unitconvert +xy_in=deg +xy_out=rad "
+        "+step +proj=utm +zone=31 +ellps=GRS80";
+
+    // The validation of the PROJ string is done with a temporary logger,
+    // so the pipeline is never instantiated with the logger of the context
+    // when the validated PJ is reused.
+    auto ctx = proj_context_create();
+    PjContextKeeper keeper_ctx(ctx);
+    int countPipelineInstantiations = 0;
+    const auto logger = [](void *user_data, int, const char *msg) {
+        if (strstr(msg, "steps built"))
+            ++*static_cast<int *>(user_data);
+    };
+    proj_log_func(ctx, &countPipelineInstantiations, logger);
+    proj_log_level(ctx, PJ_LOG_TRACE);
+
+    auto P1 = proj_create(ctx, pipeline);
+    ASSERT_NE(P1, nullptr);
+    auto P2 = proj_create(ctx, pipeline);
+    ASSERT_NE(P2, nullptr);
+    EXPECT_NE(P1, P2);
+    EXPECT_EQ(countPipelineInstantiations, 0);
+
+    auto P3 = proj_create(ctx, "+proj=utm +zone=32 +ellps=GRS80");
+    ObjectKeeper keeper_P3(P3);
+    ASSERT_NE(P3, nullptr);
+    proj_destroy(P1);
+
+    PJ_COORD c;
+    c.xyzt.x = 49;
+    c.xyzt.y = 3;
+    c.xyzt.z = 0;
+    c.xyzt.t = 0;
+    c = proj_trans(P2, PJ_FWD, c);
+    EXPECT_NEAR(c.xyzt.x, 500000.0, 1e-3);
+    EXPECT_NEAR(c.xyzt.y, 5427455.78, 1e-2);
+    proj_destroy(P2);
+}
+
+// ---------------------------------------------------------------------------
+
 TEST_F(CApi, proj_create_from_wkt) {
 
     {
@@ -326,6 +372,38 @@ TEST_F(CApi, proj_create_from_wkt) {
         EXPECT_NE(errorList, nullptr);
         proj_string_list_destroy(errorList);
     }
+    {
+        PROJ_STRING_LIST warningList = nullptr;
+        PROJ_STRING_LIST errorList = nullptr;
+        const char *const options[] = {"GRAMMAR_VALIDATION=NO", nullptr};
+        auto obj = proj_create_from_wkt(
+            m_ctxt,
+            "GEOGCS[\"WGS 84\",\n"
+            "    DATUM[\"WGS_1984\",\n"
+            "        SPHEROID[\"WGS 84\",6378137,298.257223563,\"unused\"]],\n"
+            "    PRIMEM[\"Greenwich\",0],\n"
+            "    UNIT[\"degree\",0.0174532925199433]]",
+            options, &warningList, &errorList);
+        ObjectKeeper keeper(obj);
+        EXPECT_NE(obj, nullptr);
+        EXPECT_EQ(warningList, nullptr);
+        proj_string_list_destroy(warningList);
+        EXPECT_EQ(errorList, nullptr);
+        proj_string_list_destroy(errorList);
+    }
+    {
+        const char *const options[] = {"STRICT=YES", nullptr};
+        auto obj = proj_create_from_wkt(
+            m_ctxt,
+            "GEOGCS[\"WGS 84\",\n"
+            "    DATUM[\"WGS_1984\",\n"
+            "        SPHEROID[\"WGS 84\",6378137,298.257223563,\"unused\"]],\n"
+            "    PRIMEM[\"Greenwich\",0],\n"
+            "    UNIT[\"degree\",0.0174532925199433]]",
+            options, nullptr, nullptr);
+        ObjectKeeper keeper(obj);
+        EXPECT_EQ(obj, nullptr);
+    }
     {
         PROJ_STRING_LIST warningList = nullptr;
         PROJ_STRING_LIST errorList = nullptr;
@@ -1756,6 +1834,64 @@ TEST_F(CApi, proj_coordoperation_get_grid_used_fullname_caching) {
 
 // ---------------------------------------------------------------------------
 
+TEST_F(CApi, proj_grid_availability_cache) {
+    const char *proj_data = getenv("PROJ_DATA");
+    if (!proj_data) {
+        return;
+    }
+    const char *tempdir = getenv("TEMP");
+    if (!tempdir) {
+        tempdir = getenv("TMP");
+    }
+    if (!tempdir) {
+        tempdir = "/tmp";
+    }
+    const std::string gridFilename(std::string(tempdir) +
+                                   "/nz_linz_nzgd2kgrid0005.tif");
+    std::remove(gridFilename.c_str());
+
+    const auto isGridAvailable = [tempdir, proj_data]() {
+        auto ctx = proj_context_create();
+        PjContextKeeper keeper_ctx(ctx);
+        proj_grid_availability_cache_set_ttl(ctx, -1);
+        const char *const paths[] = {tempdir, proj_data};
+        proj_context_set_search_paths(ctx, 2, paths);
+        auto op = proj_create_from_database(ctx, "EPSG", "1568",
+                                            PJ_CATEGORY_COORDINATE_OPERATION,
+                                            true, nullptr);
+        ObjectKeeper keeper(op);
+        EXPECT_NE(op, nullptr);
+        int available = 0;
+        EXPECT_EQ(proj_coordoperation_get_grid_used(ctx, op, 0, nullptr,
+                                                    nullptr, nullptr, nullptr,
+                                                    nullptr, nullptr,
+                                                    &available),
+                  1);
+        return available != 0;
+    };
+
+    proj_grid_availability_cache_clear();
+    EXPECT_FALSE(isGridAvailable());
+
+    FILE *f = fopen(gridFilename.c_str(), "wb");
+    if (!f) {
+        std::cerr << "Cannot create " << gridFilename << std::endl;
+        return;
+    }
+    fclose(f);
+
+    // Result retrieved from the process-wide cache
+    EXPECT_FALSE(isGridAvailable());
+
+    proj_grid_availability_cache_clear();
+    EXPECT_TRUE(isGridAvailable());
+
+    std::remove(gridFilename.c_str());
+    proj_grid_availability_cache_clear();
+}
+
+// ---------------------------------------------------------------------------
+
 TEST_F(CApi, proj_coordoperation_is_instantiable) {
     auto op = proj_create_from_database(m_ctxt, "EPSG", "1671",
                                         PJ_CATEGORY_COORDINATE_OPERATION, true,
@@ -1830,6 +1966,84 @@ TEST_F(CApi, proj_create_operations) {
 
 // ---------------------------------------------------------------------------
 
+TEST_F(CApi, proj_trans_skip_operation_whose_grids_do_not_cover_point) {
+    // NAD27 to NAD83. The point at long=-140 lat=40 falls into the area of
+    // use of the operation using the Canadian ntv2_0.gsb grid, but not in
+    // any of its subgrids. It is covered by the ntv1_can.dat grid.
+    PJ_COORD coord;
+    coord.xyzt.x = 40;
+    coord.xyzt.y = -140;
+    coord.xyzt.z = 0;
+    coord.xyzt.t = HUGE_VAL;
+
+    // proj_trans() directly selects an operation whose grids cover the point,
+    // instead of failing with the ntv2_0.gsb one and retrying.
+    {
+        auto ctx = proj_context_create();
+        PjContextKeeper keeper_ctx(ctx);
+        std::vector<std::string> messages;
+        const auto logger = [](void *user_data, int, const char *msg) {
+            static_cast<std::vector<std::string> *>(user_data)->push_back(msg);
+        };
+        proj_log_func(ctx, &messages, logger);
+
+        auto P = proj_create_crs_to_crs(ctx, "EPSG:4267", "EPSG:4269", nullptr);
+        ObjectKeeper keeper_P(P);
+        ASSERT_NE(P, nullptr);
+
+        proj_log_level(ctx, PJ_LOG_DEBUG);
+        const PJ_COORD res = proj_trans(P, PJ_FWD, coord);
+
+        EXPECT_NEAR(res.xy.x, 40, 1e-2);
+        EXPECT_NEAR(res.xy.y, -140, 1e-2);
+        auto lastOp = proj_trans_get_last_used_operation(P);
+        ObjectKeeper keeper_lastOp(lastOp);
+        ASSERT_NE(lastOp, nullptr);
+        EXPECT_EQ(proj_get_name(lastOp), std::string("NAD27 to NAD83 (3)"));
+        for (const auto &msg : messages) {
+            EXPECT_EQ(msg.find("Did not result in valid result"),
+                      std::string::npos)
+                << msg;
+        }
+    }
+
+    // proj_get_suggested_operation() does not open grids, and still only
+    // considers the area of use and accuracy of the operations, so it
+    // returns the ntv2_0.gsb based one.
+    {
+        auto ctxt = proj_create_operation_factory_context(m_ctxt, nullptr);
+        ASSERT_NE(ctxt, nullptr);
+        ContextKeeper keeper_ctxt(ctxt);
+
+        auto source_crs = proj_create(m_ctxt, "EPSG:4267");
+        ASSERT_NE(source_crs, nullptr);
+        ObjectKeeper keeper_source_crs(source_crs);
+
+        auto target_crs = proj_create(m_ctxt, "EPSG:4269");
+        ASSERT_NE(target_crs, nullptr);
+        ObjectKeeper keeper_target_crs(target_crs);
+
+        proj_operation_factory_context_set_spatial_criterion(
+            m_ctxt, ctxt, PROJ_SPATIAL_CRITERION_PARTIAL_INTERSECTION);
+        proj_operation_factory_context_set_grid_availability_use(
+            m_ctxt, ctxt,
+            PROJ_GRID_AVAILABILITY_DISCARD_OPERATION_IF_MISSING_GRID);
+
+        auto res = proj_create_operations(m_ctxt, source_crs, target_crs, ctxt);
+        ASSERT_NE(res, nullptr);
+        ObjListKeeper keeper_res(res);
+
+        int idx = proj_get_suggested_operation(m_ctxt, res, PJ_FWD, coord);
+        ASSERT_GE(idx, 0);
+        auto op = proj_list_get(m_ctxt, res, idx);
+        ASSERT_NE(op, nullptr);
+        ObjectKeeper keeper_op(op);
+        EXPECT_EQ(proj_get_name(op), std::string("NAD27 to NAD83 (4)"));
+    }
+}
+
+// ---------------------------------------------------------------------------
+
 TEST_F(CApi, proj_get_suggested_operation_for_NAD83_to_NAD83_HARN) {
     auto ctxt = proj_create_operation_factory_context(m_ctxt, nullptr);
     ASSERT_NE(ctxt, nullptr);
@@ -2280,6 +2494,41 @@ TEST_F(CApi, proj_context_set_database_path_error_2) {
 
 // ---------------------------------------------------------------------------
 
+TEST_F(CApi, proj_context_set_database_path_shared_cache) {
+
+    // Sharing of the cache itself is checked in gie_self_tests
+    const char *const options[] = {"SHARED_CACHE=YES", nullptr};
+    EXPECT_TRUE(
+        proj_context_set_database_path(m_ctxt, nullptr, nullptr, options));
+
+    auto ctxt2 = proj_context_create();
+    PjContextKeeper keeper_ctxt2(ctxt2);
+    EXPECT_TRUE(
+        proj_context_set_database_path(ctxt2, nullptr, nullptr, options));
+
+    auto crs = proj_create_from_database(m_ctxt, "EPSG", "32631",
+                                         PJ_CATEGORY_CRS, false, nullptr);
+    ASSERT_NE(crs, nullptr);
+    ObjectKeeper keeper_crs(crs);
+
+    auto crs2 = proj_create_from_database(ctxt2, "EPSG", "32631",
+                                          PJ_CATEGORY_CRS, false, nullptr);
+    ASSERT_NE(crs2, nullptr);
+    ObjectKeeper keeper_crs2(crs2);
+    EXPECT_TRUE(proj_is_equivalent_to(crs, crs2, PJ_COMP_STRICT));
+}
+
+// ---------------------------------------------------------------------------
+
+TEST_F(CApi, proj_context_set_database_path_unknown_option) {
+
+    const char *const options[] = {"UNKNOWN=YES", nullptr};
+    EXPECT_FALSE(
+        proj_context_set_database_path(m_ctxt, nullptr, nullptr, options));
+}
+
+// ---------------------------------------------------------------------------
+
 TEST_F(CApi, proj_context_guess_wkt_dialect) {
 
     EXPECT_EQ(proj_context_guess_wkt_dialect(nullptr, "LOCAL_CS[\"foo\"]"),
@@ -3270,6 +3519,29 @@ TEST_F(CApi, proj_clone) {
 
 // ---------------------------------------------------------------------------
 
+TEST_F(CApi, proj_clone_of_coordinate_operation_repeated) {
+    // Cloning the same operation several times reuses the PROJ string
+    // exported the first time.
+    for (const char *code : {"1671", "16031"}) {
+        auto op = proj_create_from_database(m_ctxt, "EPSG", code,
+                                            PJ_CATEGORY_COORDINATE_OPERATION,
+                                            false, nullptr);
+        ObjectKeeper keeper(op);
+        ASSERT_NE(op, nullptr);
+        const std::string def(proj_pj_info(op).definition);
+
+        for (int i = 0; i < 3; ++i) {
+            auto clone = proj_clone(m_ctxt, op);
+            ObjectKeeper keeperClone(clone);
+            ASSERT_NE(clone, nullptr);
+            EXPECT_EQ(std::string(proj_pj_info(clone).definition), def);
+            EXPECT_TRUE(proj_is_equivalent_to(op, clone, PJ_COMP_STRICT));
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+
 TEST_F(CApi, proj_clone_of_obj_with_alternative_operations) {
     // NAD27 to NAD83
     auto obj =
@@ -4772,6 +5044,107 @@ TEST_F(CApi, proj_create_crs_to_crs_from_pj) {
 
 // ---------------------------------------------------------------------------
 
+TEST_F(CApi, proj_create_crs_to_crs_from_pj_array) {
+
+    auto wgs84 = proj_create(m_ctxt, "EPSG:4326");
+    ObjectKeeper keeper_wgs84(wgs84);
+    ASSERT_NE(wgs84, nullptr);
+
+    auto wgs84_bis = proj_create(m_ctxt, "EPSG:4326");
+    ObjectKeeper keeper_wgs84_bis(wgs84_bis);
+    ASSERT_NE(wgs84_bis, nullptr);
+
+    auto utm31 = proj_create(m_ctxt, "EPSG:32631");
+    ObjectKeeper keeper_utm31(utm31);
+    ASSERT_NE(utm31, nullptr);
+
+    auto nad27 = proj_create(m_ctxt, "EPSG:4267");
+    ObjectKeeper keeper_nad27(nad27);
+    ASSERT_NE(nad27, nullptr);
+
+    auto nad83 = proj_create(m_ctxt, "EPSG:4269");
+    ObjectKeeper keeper_nad83(nad83);
+    ASSERT_NE(nad83, nullptr);
+
+    const PJ *const sources[] = {wgs84, nad27, wgs84_bis, nad27};
+    const PJ *const targets[] = {utm31, nad83, utm31, nullptr};
+    constexpr int N = 4;
+
+    for (const char *threads : {"THREADS=1", "THREADS=2"}) {
+        const char *const options[] = {threads, nullptr};
+        PJ *out[N];
+        EXPECT_EQ(proj_create_crs_to_crs_from_pj_array(
+                      m_ctxt, N, sources, targets, nullptr, options, out),
+                  3);
+        ObjectKeeper keeper_out0(out[0]);
+        ObjectKeeper keeper_out1(out[1]);
+        ObjectKeeper keeper_out2(out[2]);
+        ASSERT_NE(out[0], nullptr);
+        ASSERT_NE(out[1], nullptr);
+        ASSERT_NE(out[2], nullptr);
+        EXPECT_EQ(out[3], nullptr);
+        EXPECT_NE(out[0], out[2]);
+
+        for (int i = 0; i < 2; i++) {
+            auto P = proj_create_crs_to_crs_from_pj(m_ctxt, sources[i],
+                                                    targets[i], nullptr,
+                                                    nullptr);
+            ObjectKeeper keeper_P(P);
+            ASSERT_NE(P, nullptr);
+            PJ_COORD c;
+            c.xyzt.x = i == 0 ? 49 : 40; // lat
+            c.xyzt.y = i == 0 ? 2 : -100; // long
+            c.xyzt.z = 0;
+            c.xyzt.t = HUGE_VAL;
+            const PJ_COORD expected = proj_trans(P, PJ_FWD, c);
+            const PJ_COORD got = proj_trans(out[i], PJ_FWD, c);
+            EXPECT_EQ(got.xy.x, expected.xy.x);
+            EXPECT_EQ(got.xy.y, expected.xy.y);
+            if (i == 0) {
+                const PJ_COORD got2 = proj_trans(out[2], PJ_FWD, c);
+                EXPECT_EQ(got2.xy.x, expected.xy.x);
+                EXPECT_EQ(got2.xy.y, expected.xy.y);
+            }
+        }
+    }
+
+    {
+        const char *const options[] = {"UNKNOWN=YES", nullptr};
+        PJ *out[1];
+        EXPECT_EQ(proj_create_crs_to_crs_from_pj_array(
+                      m_ctxt, 1, sources, targets, nullptr, options, out),
+                  0);
+        EXPECT_EQ(out[0], nullptr);
+    }
+
+    // Errors raised in worker threads are reported in the context
+    {
+        auto conv = proj_create(m_ctxt, "+proj=utm +zone=31 +ellps=WGS84");
+        ObjectKeeper keeper_conv(conv);
+        ASSERT_NE(conv, nullptr);
+
+        const PJ *const sourcesErr[] = {wgs84, conv};
+        const PJ *const targetsErr[] = {utm31, utm31};
+        for (const char *threads : {"THREADS=1", "THREADS=2"}) {
+            const char *const options[] = {threads, "SHARED_CACHE=YES",
+                                           nullptr};
+            auto ctx = proj_context_create();
+            PjContextKeeper keeper_ctx(ctx);
+            PJ *out[2];
+            EXPECT_EQ(proj_create_crs_to_crs_from_pj_array(
+                          ctx, 2, sourcesErr, targetsErr, nullptr, options,
+                          out),
+                      1);
+            ObjectKeeper keeper_out0(out[0]);
+            EXPECT_NE(out[0], nullptr);
+            EXPECT_EQ(out[1], nullptr);
+            EXPECT_NE(proj_context_errno(ctx), 0) << threads;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+
 TEST_F(CApi, proj_create_crs_to_crs_from_pj_accuracy_filter) {
 
     auto src = proj_create(m_ctxt, "EPSG:4326"); // WGS 84
@@ -6513,6 +6886,254 @@ TEST_F(CApi, proj_trans_bounds__south_pole) {
 
 // ---------------------------------------------------------------------------
 
+TEST_F(CApi, proj_trans_bounds_adaptive) {
+    auto P = proj_create_crs_to_crs(
+        m_ctxt, "EPSG:4326",
+        "+proj=laea +lat_0=45 +lon_0=-100 +x_0=0 +y_0=0 "
+        "+a=6370997 +b=6370997 +units=m +no_defs",
+        nullptr);
+    ObjectKeeper keeper_P(P);
+    ASSERT_NE(P, nullptr);
+    double out_left;
+    double out_bottom;
+    double out_right;
+    double out_top;
+    int success = proj_trans_bounds_adaptive(
+        m_ctxt, P, PJ_FWD, 40, -120, 64, -80, &out_left, &out_bottom,
+        &out_right, &out_top, 0.01);
+    EXPECT_TRUE(success == 1);
+    // The fixed densification of proj_trans_bounds() with 21 points
+    // underestimates the bottom bound by about 20 m
+    EXPECT_NEAR(out_left, -1684649.41338, 1);
+    EXPECT_NEAR(out_bottom, -555797.97003, 1);
+    EXPECT_NEAR(out_right, 1684649.41338, 1);
+    EXPECT_NEAR(out_top, 2234551.18559, 1);
+
+    // Invalid tolerance
+    EXPECT_FALSE(proj_trans_bounds_adaptive(m_ctxt, P, PJ_FWD, 40, -120, 64,
+                                            -80, &out_left, &out_bottom,
+                                            &out_right, &out_top, 0));
+}
+
+// ---------------------------------------------------------------------------
+
+TEST_F(CApi, proj_trans_bounds_adaptive_antimeridian) {
+    auto P = proj_create_crs_to_crs(m_ctxt, "EPSG:4167", "EPSG:3851", nullptr);
+    ObjectKeeper keeper_P(P);
+    ASSERT_NE(P, nullptr);
+    auto normalized_p = proj_normalize_for_visualization(m_ctxt, P);
+    ObjectKeeper normal_keeper_P(normalized_p);
+    ASSERT_NE(normalized_p, nullptr);
+    double out_left;
+    double out_bottom;
+    double out_right;
+    double out_top;
+    int success = proj_trans_bounds_adaptive(
+        m_ctxt, normalized_p, PJ_FWD, 160.6, -55.95, -171.2, -25.88, &out_left,
+        &out_bottom, &out_right, &out_top, 0.01);
+    EXPECT_TRUE(success == 1);
+    EXPECT_NEAR(out_left, 1722483.900174921, 1);
+    EXPECT_NEAR(out_bottom, 5228058.6143420935, 1);
+    EXPECT_NEAR(out_right, 4624385.494808555, 1);
+    EXPECT_NEAR(out_top, 8692678.10639, 1);
+    double out_left_inv;
+    double out_bottom_inv;
+    double out_right_inv;
+    double out_top_inv;
+    int success_inv = proj_trans_bounds_adaptive(
+        m_ctxt, normalized_p, PJ_INV, 1722483.900174921, 5228058.6143420935,
+        4624385.494808555, 8692574.544944234, &out_left_inv, &out_bottom_inv,
+        &out_right_inv, &out_top_inv, 1e-7);
+    EXPECT_TRUE(success_inv == 1);
+    EXPECT_NEAR(out_left_inv, 153.2799922, 1);
+    EXPECT_NEAR(out_bottom_inv, -56.7484638, 1);
+    EXPECT_NEAR(out_right_inv, -162.1813873, 1);
+    EXPECT_NEAR(out_top_inv, -24.6148194, 1);
+}
+
+// ---------------------------------------------------------------------------
+
+TEST_F(CApi, proj_trans_bounds_adaptive_north_pole) {
+    auto P = proj_create_crs_to_crs(m_ctxt, "EPSG:32661", "EPSG:4326", nullptr);
+    ObjectKeeper keeper_P(P);
+    ASSERT_NE(P, nullptr);
+    auto normalized_p = proj_normalize_for_visualization(m_ctxt, P);
+    ObjectKeeper normal_keeper_P(normalized_p);
+    ASSERT_NE(normalized_p, nullptr);
+    double out_left;
+    double out_bottom;
+    double out_right;
+    double out_top;
+    int success = proj_trans_bounds_adaptive(
+        m_ctxt, normalized_p, PJ_FWD, -1371213.7625429356, -1405880.71737131,
+        5371213.762542935, 5405880.71737131, &out_left, &out_bottom, &out_right,
+        &out_top, 1e-7);
+    EXPECT_TRUE(success == 1);
+    EXPECT_NEAR(out_left, -180.0, 1);
+    EXPECT_NEAR(out_bottom, 48.656, 1);
+    EXPECT_NEAR(out_right, 180.0, 1);
+    EXPECT_NEAR(out_top, 90.0, 1);
+}
+
+// ---------------------------------------------------------------------------
+
+TEST_F(CApi, proj_trans_bounds_grid) {
+    // Check that the result is the same as calling proj_trans_bounds() on
+    // each box. With 21 densification points, a row of 40 boxes has
+    // 40 * 22 * 2 points, so the 40 rows are processed in 2 bands of at
+    // most 65536 points, which are distributed between the threads.
+    const auto check = [this](PJ *P, double xmin, double ymin,
+                              double cell_width, double cell_height,
+                              const char *const *options) {
+        constexpr int count_x = 40;
+        constexpr int count_y = 40;
+        std::vector<double> out_xmin(count_x * count_y);
+        std::vector<double> out_ymin(count_x * count_y);
+        std::vector<double> out_xmax(count_x * count_y);
+        std::vector<double> out_ymax(count_x * count_y);
+        ASSERT_EQ(proj_trans_bounds_grid(m_ctxt, P, PJ_FWD, xmin, ymin,
+                                         cell_width, cell_height, count_x,
+                                         count_y, out_xmin.data(),
+                                         out_ymin.data(), out_xmax.data(),
+                                         out_ymax.data(), 21, options),
+                  1);
+        for (int j = 0; j < count_y; j++) {
+            for (int i = 0; i < count_x; i++) {
+                const double box_xmin = xmin + i * cell_width;
+                const double box_ymin = ymin + j * cell_height;
+                double ref_xmin;
+                double ref_ymin;
+                double ref_xmax;
+                double ref_ymax;
+                ASSERT_EQ(proj_trans_bounds(m_ctxt, P, PJ_FWD, box_xmin,
+                                            box_ymin, box_xmin + cell_width,
+                                            box_ymin + cell_height, &ref_xmin,
+                                            &ref_ymin, &ref_xmax, &ref_ymax,
+                                            21),
+                          1);
+                const int idx = j * count_x + i;
+                const double tol = 1e-8 * std::max(1.0, std::fabs(ref_xmax));
+                EXPECT_NEAR(out_xmin[idx], ref_xmin, tol) << i << " " << j;
+                EXPECT_NEAR(out_ymin[idx], ref_ymin, tol) << i << " " << j;
+                EXPECT_NEAR(out_xmax[idx], ref_xmax, tol) << i << " " << j;
+                EXPECT_NEAR(out_ymax[idx], ref_ymax, tol) << i << " " << j;
+            }
+        }
+    };
+
+    const char *const options_threads[] = {"THREADS=2", nullptr};
+    {
+        auto P = proj_create_crs_to_crs(
+            m_ctxt, "EPSG:4326",
+            "+proj=laea +lat_0=45 +lon_0=-100 +x_0=0 +y_0=0 "
+            "+a=6370997 +b=6370997 +units=m +no_defs",
+            nullptr);
+        ObjectKeeper keeper_P(P);
+        ASSERT_NE(P, nullptr);
+        check(P, 20, -140, 1, 1, nullptr);
+        check(P, 20, -140, 1, 1, options_threads);
+    }
+    {
+        // Geographic output, with one of the boxes containing the north pole
+        auto P =
+            proj_create_crs_to_crs(m_ctxt, "EPSG:32661", "EPSG:4326", nullptr);
+        ObjectKeeper keeper_P(P);
+        ASSERT_NE(P, nullptr);
+        auto normalized_p = proj_normalize_for_visualization(m_ctxt, P);
+        ObjectKeeper normal_keeper_P(normalized_p);
+        ASSERT_NE(normalized_p, nullptr);
+        check(normalized_p, 50000, 50000, 100000, 100000, nullptr);
+        check(normalized_p, 50000, 50000, 100000, 100000, options_threads);
+
+        // Invalid arguments
+        double out_xmin;
+        double out_ymin;
+        double out_xmax;
+        double out_ymax;
+        EXPECT_FALSE(proj_trans_bounds_grid(
+            m_ctxt, normalized_p, PJ_FWD, 0, 0, 0, 1, 1, 1, &out_xmin,
+            &out_ymin, &out_xmax, &out_ymax, 21, nullptr));
+        EXPECT_FALSE(proj_trans_bounds_grid(
+            m_ctxt, normalized_p, PJ_FWD, 0, 0, 1, 1, 1, 1, &out_xmin,
+            &out_ymin, &out_xmax, &out_ymax, 1, nullptr));
+        const char *const options_invalid[] = {"FOO=BAR", nullptr};
+        EXPECT_FALSE(proj_trans_bounds_grid(
+            m_ctxt, normalized_p, PJ_FWD, 0, 0, 1, 1, 1, 1, &out_xmin,
+            &out_ymin, &out_xmax, &out_ymax, 21, options_invalid));
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+TEST_F(CApi, proj_trans_warp_grid) {
+    auto P = proj_create_crs_to_crs(m_ctxt, "EPSG:3857", "EPSG:4326", nullptr);
+    ObjectKeeper keeper_P(P);
+    ASSERT_NE(P, nullptr);
+    auto normalized_p = proj_normalize_for_visualization(m_ctxt, P);
+    ObjectKeeper normal_keeper_P(normalized_p);
+    ASSERT_NE(normalized_p, nullptr);
+
+    // Raster of 150x1000 pixels of 10 km in EPSG:3857, rotated by a few
+    // degrees. Its rows are processed in 3 bands of at most 65536 pixels.
+    constexpr int width = 150;
+    constexpr int height = 1000;
+    const double geotransform[6] = {-500000, 9975, 700, 6000000, 700, -9975};
+    std::vector<double> exact_x(width * height);
+    std::vector<double> exact_y(width * height);
+    for (int row = 0; row < height; row++) {
+        for (int col = 0; col < width; col++) {
+            PJ_COORD c = proj_coord(
+                geotransform[0] + (col + 0.5) * geotransform[1] +
+                    (row + 0.5) * geotransform[2],
+                geotransform[3] + (col + 0.5) * geotransform[4] +
+                    (row + 0.5) * geotransform[5],
+                0, 0);
+            c = proj_trans(normalized_p, PJ_FWD, c);
+            exact_x[row * width + col] = c.xy.x;
+            exact_y[row * width + col] = c.xy.y;
+        }
+    }
+
+    const auto check = [&](double error_threshold,
+                           const char *const *options) {
+        std::vector<double> out_x(width * height);
+        std::vector<double> out_y(width * height);
+        ASSERT_EQ(proj_trans_warp_grid(m_ctxt, normalized_p, PJ_FWD,
+                                       geotransform, width, height,
+                                       error_threshold, out_x.data(),
+                                       out_y.data(), options),
+                  1);
+        // The error is only checked at the middle of the interpolated
+        // segments, so allow some margin. Without interpolation, the
+        // results must be exact.
+        const double tol = 2 * error_threshold;
+        for (int i = 0; i < width * height; i++) {
+            EXPECT_NEAR(out_x[i], exact_x[i], tol) << i;
+            EXPECT_NEAR(out_y[i], exact_y[i], tol) << i;
+        }
+    };
+    check(0, nullptr);
+    check(1e-4, nullptr);
+    const char *const options_threads[] = {"THREADS=3", nullptr};
+    check(1e-4, options_threads);
+
+    // Invalid arguments
+    double out_x;
+    double out_y;
+    EXPECT_FALSE(proj_trans_warp_grid(m_ctxt, normalized_p, PJ_FWD,
+                                      geotransform, 1, 1, -1, &out_x, &out_y,
+                                      nullptr));
+    EXPECT_FALSE(proj_trans_warp_grid(m_ctxt, normalized_p, PJ_FWD,
+                                      geotransform, 0, 1, 0, &out_x, &out_y,
+                                      nullptr));
+    const char *const options_invalid[] = {"FOO=BAR", nullptr};
+    EXPECT_FALSE(proj_trans_warp_grid(m_ctxt, normalized_p, PJ_FWD,
+                                      geotransform, 1, 1, 0, &out_x, &out_y,
+                                      options_invalid));
+}
+
+// ---------------------------------------------------------------------------
+
 TEST_F(CApi, proj_crs_has_point_motion_operation) {
     auto ctxt = proj_create_operation_factory_context(m_ctxt, nullptr);
     ASSERT_NE(ctxt, nullptr);
@@ -6611,6 +7232,42 @@ TEST_F(CApi, concurrent_context) {
     proj_cleanup();
 }
 
+// ---------------------------------------------------------------------------
+
+TEST_F(CApi, concurrent_context_shared_cache) {
+    // Test that concurrent access to shared database caches is thread safe.
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back(std::thread([] {
+            const char *const options[] = {"SHARED_CACHE=YES", nullptr};
+            for (int j = 0; j < 60; j++) {
+                PJ_CONTEXT *ctxt = proj_context_create();
+                EXPECT_TRUE(proj_context_set_database_path(ctxt, nullptr,
+                                                           nullptr, options));
+                {
+                    auto obj = proj_create(
+                        ctxt, ("EPSG:" + std::to_string(32600 + j)).c_str());
+                    ObjectKeeper keeper(obj);
+                    EXPECT_NE(obj, nullptr);
+                }
+                {
+                    auto P = proj_create_crs_to_crs(
+                        ctxt, "EPSG:4326",
+                        ("EPSG:" + std::to_string(32700 + j)).c_str(),
+                        nullptr);
+                    ObjectKeeper keeper(P);
+                    EXPECT_NE(P, nullptr);
+                }
+                proj_context_destroy(ctxt);
+            }
+        }));
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    proj_cleanup();
+}
+
 #endif // __MINGW32__
 
 } // namespace
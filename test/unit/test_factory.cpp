@@ -707,6 +707,35 @@ TEST(factory, AuthorityFactory_createConversion) {
 
 // ---------------------------------------------------------------------------
 
+TEST(factory, AuthorityFactory_shared_sub_objects) {
+    auto factory = AuthorityFactory::create(DatabaseContext::create(), "EPSG");
+    // Both use the same extent and scope
+    auto crs1 = factory->createProjectedCRS("2154");
+    auto crs2 = factory->createProjectedCRS("9793");
+    ASSERT_EQ(crs1->domains().size(), 1U);
+    ASSERT_EQ(crs2->domains().size(), 1U);
+    EXPECT_EQ(crs1->domains()[0].get(), crs2->domains()[0].get());
+
+    // Both use the Transverse Mercator method
+    auto conv1 = factory->createConversion("16031");
+    auto conv2 = factory->createConversion("16032");
+    const auto &values1 = conv1->parameterValues();
+    const auto &values2 = conv2->parameterValues();
+    ASSERT_EQ(values1.size(), values2.size());
+    for (size_t i = 0; i < values1.size(); ++i) {
+        const auto opParamvalue1 =
+            nn_dynamic_pointer_cast<OperationParameterValue>(values1[i]);
+        const auto opParamvalue2 =
+            nn_dynamic_pointer_cast<OperationParameterValue>(values2[i]);
+        ASSERT_TRUE(opParamvalue1);
+        ASSERT_TRUE(opParamvalue2);
+        EXPECT_EQ(opParamvalue1->parameter().get(),
+                  opParamvalue2->parameter().get());
+    }
+}
+
+// ---------------------------------------------------------------------------
+
 TEST(factory, AuthorityFactory_createConversion_from_other_transformation) {
     auto factory = AuthorityFactory::create(DatabaseContext::create(), "EPSG");
     auto op = factory->createCoordinateOperation("7984", false);
@@ -3334,6 +3363,26 @@ TEST(factory, attachExtraDatabases_auxiliary) {
 
         const auto dbStructure = ctxt->getDatabaseStructure();
         EXPECT_EQ(dbStructure, tableStructureBefore);
+
+        // Only tables with records in the auxiliary database are overlaid
+        auto hDB = static_cast<sqlite3 *>(ctxt->getSqliteHandle());
+        ASSERT_TRUE(hDB != nullptr);
+        sqlite3_stmt *stmt = nullptr;
+        ASSERT_EQ(sqlite3_prepare_v2(hDB,
+                                     "SELECT name FROM sqlite_temp_master "
+                                     "WHERE type = 'view' ORDER BY name",
+                                     -1, &stmt, nullptr),
+                  SQLITE_OK);
+        std::vector<std::string> overlaidNames;
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            overlaidNames.emplace_back(
+                reinterpret_cast<const char *>(sqlite3_column_text(stmt, 0)));
+        }
+        sqlite3_finalize(stmt);
+        EXPECT_TRUE(std::find(overlaidNames.begin(), overlaidNames.end(),
+                              "geodetic_crs") != overlaidNames.end());
+        EXPECT_TRUE(std::find(overlaidNames.begin(), overlaidNames.end(),
+                              "projected_crs") == overlaidNames.end());
     }
 
     {
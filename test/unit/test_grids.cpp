@@ -32,6 +32,9 @@
 
 #include "proj_internal.h" // M_PI
 
+#include <cmath>
+#include <cstdio>
+
 namespace {
 
 // ---------------------------------------------------------------------------
@@ -339,6 +342,99 @@ TEST_F(GridTest, GenericShiftGridSet_gtiff_projected) {
     EXPECT_EQ(grid->extentAndRes().resY, 1000);
 }
 
+// ---------------------------------------------------------------------------
+
+TEST_F(GridTest, pj_grid_extract_subset) {
+    const char *outputFilename = "./test_grids_subset.tif";
+    ASSERT_TRUE(NS_PROJ::pj_grid_extract_subset(
+        m_ctxt, "tests/test_hgrid_with_subgrid.tif", -115.6, 51.1, -115.5,
+        51.2, outputFilename));
+
+    auto gridSetRef = NS_PROJ::GenericShiftGridSet::open(
+        m_ctxt, "tests/test_hgrid_with_subgrid.tif");
+    ASSERT_NE(gridSetRef, nullptr);
+    auto gridSet = NS_PROJ::GenericShiftGridSet::open(m_ctxt, outputFilename);
+    ASSERT_NE(gridSet, nullptr);
+
+    const double x = -115.5416667 / 180 * M_PI;
+    const double y = 51.1666667 / 180 * M_PI;
+    auto gridRef = gridSetRef->gridAt(x, y);
+    ASSERT_NE(gridRef, nullptr);
+    auto grid = gridSet->gridAt(x, y);
+    ASSERT_NE(grid, nullptr);
+    EXPECT_EQ(grid->metadataItem("grid_name"), "ALbanff");
+    EXPECT_LE(grid->width(), gridRef->width());
+    EXPECT_LE(grid->height(), gridRef->height());
+
+    // Check that the subset is correctly georeferenced
+    const auto &extentRef = gridRef->extentAndRes();
+    const auto &extent = grid->extentAndRes();
+    EXPECT_EQ(extent.resX, extentRef.resX);
+    EXPECT_EQ(extent.resY, extentRef.resY);
+    const int xOff = static_cast<int>(
+        std::round((extent.west - extentRef.west) / extent.resX));
+    const int yOff = static_cast<int>(
+        std::round((extent.south - extentRef.south) / extent.resY));
+    for (int j = 0; j < grid->height(); ++j) {
+        for (int i = 0; i < grid->width(); ++i) {
+            float valRef = 0;
+            float val = 1;
+            EXPECT_TRUE(gridRef->valueAt(i + xOff, j + yOff, 0, valRef));
+            EXPECT_TRUE(grid->valueAt(i, j, 0, val));
+            EXPECT_EQ(val, valRef);
+        }
+    }
+
+    // Outside of the area of interest, but within the original grid
+    const double xOut = -115.0 / 180 * M_PI;
+    const double yOut = 50.9 / 180 * M_PI;
+    EXPECT_NE(gridSetRef->gridAt(xOut, yOut), nullptr);
+    EXPECT_EQ(gridSet->gridAt(xOut, yOut), nullptr);
+
+    gridSet.reset();
+    std::remove(outputFilename);
+}
+
 #endif // TIFF_ENABLED
 
+// ---------------------------------------------------------------------------
+
+TEST_F(GridTest, GridCoverageMask) {
+    {
+        NS_PROJ::GridCoverageMask mask;
+        EXPECT_TRUE(mask.empty());
+        EXPECT_TRUE(mask.mayContain(0, 0));
+        EXPECT_FALSE(mask.addGrids(m_ctxt, "foobar", false));
+        EXPECT_FALSE(mask.addGrids(m_ctxt, "@tests/ntv1_can.dat", false));
+        EXPECT_FALSE(mask.addGrids(m_ctxt, "null", false));
+    }
+    {
+        NS_PROJ::GridCoverageMask mask;
+        EXPECT_TRUE(mask.addGrids(m_ctxt, "tests/alaska,tests/conus", false));
+        EXPECT_FALSE(mask.empty());
+        // Anchorage
+        EXPECT_TRUE(mask.mayContain(-149.9 * DEG_TO_RAD, 61.2 * DEG_TO_RAD));
+        // Denver
+        EXPECT_TRUE(mask.mayContain(-105 * DEG_TO_RAD, 39.7 * DEG_TO_RAD));
+        // Paris
+        EXPECT_FALSE(mask.mayContain(2.35 * DEG_TO_RAD, 48.85 * DEG_TO_RAD));
+        // Pacific, between the extents of the two grids
+        EXPECT_FALSE(mask.mayContain(-140 * DEG_TO_RAD, 30 * DEG_TO_RAD));
+        // Longitude expressed in [0, 360]
+        EXPECT_TRUE(mask.mayContain(255 * DEG_TO_RAD, 39.7 * DEG_TO_RAD));
+
+        // Also require to be in the extent of a (European) vertical grid
+        EXPECT_TRUE(mask.addGrids(m_ctxt, "tests/test_nodata.gtx", true));
+        EXPECT_FALSE(mask.mayContain(-105 * DEG_TO_RAD, 39.7 * DEG_TO_RAD));
+    }
+    {
+        // World vertical grid, whose longitudes are in [0, 360]
+        NS_PROJ::GridCoverageMask mask;
+        EXPECT_TRUE(
+            mask.addGrids(m_ctxt, "tests/egm96_15_downsampled.gtx", true));
+        EXPECT_TRUE(mask.mayContain(-105 * DEG_TO_RAD, 39.7 * DEG_TO_RAD));
+        EXPECT_TRUE(mask.mayContain(179.9 * DEG_TO_RAD, -89.9 * DEG_TO_RAD));
+    }
+}
+
 } // namespace
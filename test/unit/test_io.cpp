@@ -8417,6 +8417,32 @@ TEST(wkt_parse, wkt1_pseudo_wkt1_gdal_pseudo_wkt1_esri) {
 
 // ---------------------------------------------------------------------------
 
+TEST(wkt_parse, grammar_validation) {
+    // Extra element in SPHEROID
+    const char *wkt = "GEOGCS[\"WGS 84\",\n"
+                      "    DATUM[\"WGS_1984\",\n"
+                      "        SPHEROID[\"WGS 84\",6378137,298.257223563,"
+                      "\"unused\"]],\n"
+                      "    PRIMEM[\"Greenwich\",0],\n"
+                      "    UNIT[\"degree\",0.0174532925199433]]";
+    {
+        WKTParser parser;
+        EXPECT_NO_THROW(parser.setStrict(false).createFromWKT(wkt));
+        EXPECT_EQ(parser.grammarErrorList().size(), 1U);
+    }
+    {
+        WKTParser parser;
+        EXPECT_NO_THROW(parser.setStrict(false)
+                            .setGrammarValidation(false)
+                            .createFromWKT(wkt));
+        EXPECT_TRUE(parser.grammarErrorList().empty());
+    }
+    EXPECT_THROW(WKTParser().createFromWKT(wkt), ParsingException);
+    EXPECT_NO_THROW(WKTParser().setGrammarValidation(false).createFromWKT(wkt));
+}
+
+// ---------------------------------------------------------------------------
+
 TEST(wkt_parse, invalid) {
     EXPECT_THROW(WKTParser().createFromWKT(""), ParsingException);
     EXPECT_THROW(WKTParser().createFromWKT("A"), ParsingException);
@@ -32,6 +32,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "filemanager.hpp"
 #include "proj_internal.h"
 #include <proj.h>
 
@@ -2026,6 +2027,214 @@ TEST(networking, pyproj_issue_1192) {
 
 // ---------------------------------------------------------------------------
 
+// Network callbacks serving a single in-memory file with range requests
+struct RangeServer {
+    std::vector<unsigned char> content{};
+    std::string etag{};
+    // Number of read_range() requests that succeed before failing. -1 means
+    // no failure.
+    int remainingReadRange = -1;
+    std::vector<unsigned long long> openOffsets{};
+    std::string headerValue{};
+};
+
+static PROJ_NETWORK_HANDLE *
+range_server_open_cbk(PJ_CONTEXT *, const char *, unsigned long long offset,
+                      size_t size_to_read, void *buffer, size_t *out_size_read,
+                      size_t, char *, void *user_data) {
+    auto server = static_cast<RangeServer *>(user_data);
+    server->openOffsets.push_back(offset);
+    if (offset >= server->content.size())
+        return nullptr;
+    *out_size_read = std::min(size_to_read,
+                              static_cast<size_t>(server->content.size() -
+                                                  offset));
+    memcpy(buffer, server->content.data() + offset, *out_size_read);
+    return reinterpret_cast<PROJ_NETWORK_HANDLE *>(server);
+}
+
+static void range_server_close_cbk(PJ_CONTEXT *, PROJ_NETWORK_HANDLE *,
+                                   void *) {}
+
+static const char *range_server_get_header_value_cbk(PJ_CONTEXT *,
+                                                     PROJ_NETWORK_HANDLE *,
+                                                     const char *header_name,
+                                                     void *user_data) {
+    auto server = static_cast<RangeServer *>(user_data);
+    if (strcmp(header_name, "Content-Range") == 0) {
+        server->headerValue =
+            "bytes 0-0/" + std::to_string(server->content.size());
+        return server->headerValue.c_str();
+    }
+    if (strcmp(header_name, "ETag") == 0) {
+        return server->etag.c_str();
+    }
+    return nullptr;
+}
+
+static size_t range_server_read_range_cbk(
+    PJ_CONTEXT *, PROJ_NETWORK_HANDLE *, unsigned long long offset,
+    size_t size_to_read, void *buffer, size_t error_string_max_size,
+    char *out_error_string, void *user_data) {
+    auto server = static_cast<RangeServer *>(user_data);
+    if (server->remainingReadRange == 0) {
+        snprintf(out_error_string, error_string_max_size, "interrupted");
+        return 0;
+    }
+    if (server->remainingReadRange > 0)
+        server->remainingReadRange--;
+    if (offset >= server->content.size())
+        return 0;
+    const size_t size_read = std::min(
+        size_to_read, static_cast<size_t>(server->content.size() - offset));
+    memcpy(buffer, server->content.data() + offset, size_read);
+    return size_read;
+}
+
+static std::vector<unsigned char> read_file(const char *filename) {
+    std::vector<unsigned char> content;
+    FILE *f = fopen(filename, "rb");
+    if (f) {
+        unsigned char buffer[1024];
+        size_t n;
+        while ((n = fread(buffer, 1, sizeof(buffer), f)) > 0) {
+            content.insert(content.end(), buffer, buffer + n);
+        }
+        fclose(f);
+    }
+    return content;
+}
+
+TEST(networking, download_file_resume_and_checksum) {
+    const auto cleanup = []() {
+        unlink("proj_test_tmp/cache.db");
+        unlink("proj_test_tmp/range_test.tif");
+        unlink("proj_test_tmp/range_test.tif.part");
+        unlink("proj_test_tmp/range_test.tif.part.props");
+        unlink("proj_test_tmp/range_test.tif.part.lock");
+        rmdir("proj_test_tmp");
+    };
+    cleanup();
+
+    putenv(const_cast<char *>("PROJ_FULL_FILE_CHUNK_SIZE=100"));
+
+    RangeServer server;
+    for (int i = 0; i < 1000; ++i)
+        server.content.push_back(static_cast<unsigned char>(i % 251));
+    server.etag = "\"v1\"";
+    const std::string sha256sum(
+        "4e4c294b331f7a2099a379bec34b9f9fc03dc46ab465d998f4d683da53487e6d");
+
+    auto ctx = proj_context_create();
+    proj_log_func(ctx, nullptr, silent_logger);
+    proj_context_set_enable_network(ctx, true);
+    proj_context_set_user_writable_directory(ctx, "./proj_test_tmp", true);
+    ASSERT_TRUE(proj_context_set_network_callbacks(
+        ctx, range_server_open_cbk, range_server_close_cbk,
+        range_server_get_header_value_cbk, range_server_read_range_cbk,
+        &server));
+    const char *url = "http://localhost/range_test.tif";
+
+    // Interrupted download: the partial file is kept
+    server.remainingReadRange = 3;
+    EXPECT_FALSE(
+        pj_download_file(ctx, url, false, true, sha256sum, nullptr, nullptr));
+    EXPECT_EQ(read_file("proj_test_tmp/range_test.tif.part").size(), 400U);
+    EXPECT_TRUE(read_file("proj_test_tmp/range_test.tif").empty());
+
+    // Resumed download, only requesting the missing bytes
+    server.remainingReadRange = -1;
+    server.openOffsets.clear();
+    EXPECT_TRUE(
+        pj_download_file(ctx, url, false, true, sha256sum, nullptr, nullptr));
+    ASSERT_EQ(server.openOffsets.size(), 1U);
+    EXPECT_EQ(server.openOffsets[0], 400U);
+    EXPECT_EQ(read_file("proj_test_tmp/range_test.tif"), server.content);
+    EXPECT_TRUE(read_file("proj_test_tmp/range_test.tif.part").empty());
+
+    // Checksum mismatch: nothing is kept
+    unlink("proj_test_tmp/range_test.tif");
+    EXPECT_FALSE(pj_download_file(
+        ctx, url, false, true,
+        "0000000000000000000000000000000000000000000000000000000000000000",
+        nullptr, nullptr));
+    EXPECT_TRUE(read_file("proj_test_tmp/range_test.tif").empty());
+    EXPECT_TRUE(read_file("proj_test_tmp/range_test.tif.part").empty());
+
+    // Remote file changed after an interrupted download: restart from scratch
+    server.remainingReadRange = 3;
+    EXPECT_FALSE(
+        pj_download_file(ctx, url, false, true, sha256sum, nullptr, nullptr));
+    for (int i = 0; i < 1000; ++i)
+        server.content[i] = static_cast<unsigned char>((i * 7) % 251);
+    server.etag = "\"v2\"";
+    server.remainingReadRange = -1;
+    EXPECT_TRUE(pj_download_file(
+        ctx, url, false, true,
+        "59425e4412e296fc74736673ce067027f384203f59c0d2c3e6be7b13347b3ffc",
+        nullptr, nullptr));
+    EXPECT_EQ(read_file("proj_test_tmp/range_test.tif"), server.content);
+
+    // Remote file shrank after an interrupted download, so that the range
+    // request fails: the partial download is discarded and restarted
+    unlink("proj_test_tmp/range_test.tif");
+    server.remainingReadRange = 3;
+    EXPECT_FALSE(pj_download_file(ctx, url, false, true, std::string(),
+                                  nullptr, nullptr));
+    EXPECT_EQ(read_file("proj_test_tmp/range_test.tif.part").size(), 400U);
+    server.content.resize(300);
+    server.etag = "\"v3\"";
+    server.remainingReadRange = -1;
+    server.openOffsets.clear();
+    EXPECT_TRUE(pj_download_file(ctx, url, false, true, std::string(),
+                                 nullptr, nullptr));
+    ASSERT_EQ(server.openOffsets.size(), 2U);
+    EXPECT_EQ(server.openOffsets[0], 400U);
+    EXPECT_EQ(server.openOffsets[1], 0U);
+    EXPECT_EQ(read_file("proj_test_tmp/range_test.tif"), server.content);
+    EXPECT_TRUE(read_file("proj_test_tmp/range_test.tif.part").empty());
+    EXPECT_TRUE(read_file("proj_test_tmp/range_test.tif.part.props").empty());
+
+    // While the partial download is locked, for example by a download in
+    // another process, it is neither resumed nor modified
+    unlink("proj_test_tmp/range_test.tif");
+    server.remainingReadRange = 1;
+    EXPECT_FALSE(pj_download_file(ctx, url, false, true, std::string(),
+                                  nullptr, nullptr));
+    EXPECT_EQ(read_file("proj_test_tmp/range_test.tif.part").size(), 200U);
+    {
+        const char *lockFilename = "proj_test_tmp/range_test.tif.part.lock";
+        auto lock = NS_PROJ::FileManager::lock(ctx, lockFilename);
+        ASSERT_TRUE(lock != nullptr);
+        EXPECT_TRUE(NS_PROJ::FileManager::lock(ctx, lockFilename) == nullptr);
+
+        server.remainingReadRange = -1;
+        server.openOffsets.clear();
+        EXPECT_TRUE(pj_download_file(ctx, url, false, true, std::string(),
+                                     nullptr, nullptr));
+        ASSERT_EQ(server.openOffsets.size(), 1U);
+        EXPECT_EQ(server.openOffsets[0], 0U);
+        EXPECT_EQ(read_file("proj_test_tmp/range_test.tif"), server.content);
+        EXPECT_EQ(read_file("proj_test_tmp/range_test.tif.part").size(), 200U);
+    }
+
+    // and it is resumed once the lock is released
+    unlink("proj_test_tmp/range_test.tif");
+    server.openOffsets.clear();
+    EXPECT_TRUE(pj_download_file(ctx, url, false, true, std::string(),
+                                 nullptr, nullptr));
+    ASSERT_EQ(server.openOffsets.size(), 1U);
+    EXPECT_EQ(server.openOffsets[0], 200U);
+    EXPECT_EQ(read_file("proj_test_tmp/range_test.tif"), server.content);
+    EXPECT_TRUE(read_file("proj_test_tmp/range_test.tif.part").empty());
+
+    proj_context_destroy(ctx);
+    putenv(const_cast<char *>("PROJ_FULL_FILE_CHUNK_SIZE="));
+    cleanup();
+}
+
+// ---------------------------------------------------------------------------
+
 #ifdef CURL_ENABLED
 
 TEST(networking, do_not_attempt_network_access_known_available_network_on) {
@@ -268,6 +268,39 @@ TEST(operation, SingleOperation) {
 
 // ---------------------------------------------------------------------------
 
+TEST(operation, SingleOperation_shallowClone_shares_metadata) {
+
+    auto sop = Transformation::create(
+        PropertyMap()
+            .set(IdentifiedObject::NAME_KEY, "name")
+            .set(Identifier::CODESPACE_KEY, "codespace")
+            .set(Identifier::CODE_KEY, "code")
+            .set(IdentifiedObject::REMARKS_KEY, "remarks")
+            .set(ObjectUsage::SCOPE_KEY, "scope"),
+        nn_static_pointer_cast<CRS>(GeographicCRS::EPSG_4326),
+        nn_static_pointer_cast<CRS>(GeographicCRS::EPSG_4807), nullptr,
+        PropertyMap(),
+        std::vector<OperationParameterNNPtr>{OperationParameter::create(
+            PropertyMap().set(IdentifiedObject::NAME_KEY, "paramName"))},
+        std::vector<ParameterValueNNPtr>{
+            ParameterValue::createFilename("foo.bin")},
+        {});
+
+    auto clone = nn_dynamic_pointer_cast<Transformation>(
+        sop->CoordinateOperation::shallowClone());
+    ASSERT_TRUE(clone != nullptr);
+    EXPECT_NE(clone.get(), sop.get());
+    EXPECT_TRUE(clone->isEquivalentTo(sop.get()));
+
+    // Immutable parts are not copied
+    EXPECT_EQ(&clone->identifiers(), &sop->identifiers());
+    EXPECT_EQ(&clone->remarks(), &sop->remarks());
+    EXPECT_EQ(&clone->domains(), &sop->domains());
+    EXPECT_EQ(&clone->parameterValues(), &sop->parameterValues());
+}
+
+// ---------------------------------------------------------------------------
+
 TEST(operation, SingleOperation_different_order) {
 
     auto sop1 = Transformation::create(